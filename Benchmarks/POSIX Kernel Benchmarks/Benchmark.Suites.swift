@@ -0,0 +1,232 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if canImport(Darwin)
+    import Darwin
+#elseif canImport(Glibc)
+    import Glibc
+#elseif canImport(Musl)
+    import Musl
+#endif
+
+import Kernel_Primitives
+import POSIX_Kernel
+import Synchronization
+
+// MARK: - Latency
+
+extension Benchmark {
+    /// Spawn-to-exit latency: from the spawn call until `Wait.wait` returns.
+    ///
+    /// | Name | Start | Reap |
+    /// |------|-------|------|
+    /// | `latency.spawn` | `Spawn.spawn` | `Wait.wait(.process)` |
+    /// | `latency.fork-exec` | `Fork.fork` + `Execute.execve` | `Wait.wait(.process)` |
+    /// | `latency.handle` | `Handle.spawn` | `Wait.wait(handle)` |
+    static func latency(_ configuration: Configuration, helper: String) {
+        let child: Child
+        do {
+            child = try Child(helper: helper, "exit", "0")
+        } catch {
+            Report.error("latency", "\(error)")
+            return
+        }
+
+        func run(_ name: String, _ body: () throws(POSIX.Kernel.Process.Error) -> Void) {
+            var samples = Samples(capacity: configuration.iterations)
+            do {
+                for _ in 0..<configuration.iterations {
+                    samples.append(try measure(body))
+                }
+                Report.samples(name, samples)
+            } catch {
+                Report.error(name, "\(error)")
+            }
+        }
+
+        run("latency.spawn") { () throws(POSIX.Kernel.Process.Error) in
+            let pid = try child.spawn()
+            _ = try POSIX.Kernel.Process.Wait.wait(.process(pid))
+        }
+
+        run("latency.fork-exec") { () throws(POSIX.Kernel.Process.Error) in
+            let pid = try child.forkExecute()
+            _ = try POSIX.Kernel.Process.Wait.wait(.process(pid))
+        }
+
+        run("latency.handle") { () throws(POSIX.Kernel.Process.Error) in
+            let handle = try POSIX.Kernel.Process.Handle.spawn(
+                path: child.path,
+                argv: child.argv,
+                envp: child.envp,
+                fileActions: child.fileActions
+            )
+            defer { try? POSIX.Kernel.Process.Handle.close(handle) }
+            _ = try POSIX.Kernel.Process.Wait.wait(handle)
+        }
+    }
+}
+
+// MARK: - Throughput
+
+extension Benchmark {
+    /// Spawn+reap rate with 1, 2, 4, ... up to `configuration.threads`
+    /// threads, each running `Spawn.spawn` / `Wait.wait(.process)` in a loop.
+    static func throughput(_ configuration: Configuration, helper: String) {
+        let child: Child
+        do {
+            child = try Child(helper: helper, "exit", "0")
+        } catch {
+            Report.error("throughput", "\(error)")
+            return
+        }
+
+        var counts: [Int] = []
+        var count = 1
+        while count < configuration.threads {
+            counts.append(count)
+            count *= 2
+        }
+        counts.append(configuration.threads)
+
+        let budget = Duration.milliseconds(Int64(configuration.seconds * 1000))
+
+        final class Tally: Sendable {
+            let spawns = Atomic<Int>(0)
+            let failures = Atomic<Int>(0)
+        }
+
+        for threads in counts {
+            let tally = Tally()
+
+            let elapsed = measure {
+                Benchmark.threads(threads) { _ in
+                    let clock = ContinuousClock()
+                    let deadline = clock.now + budget
+                    var local = 0
+                    while clock.now < deadline {
+                        do {
+                            let pid = try child.spawn()
+                            _ = try POSIX.Kernel.Process.Wait.wait(.process(pid))
+                            local += 1
+                        } catch {
+                            tally.failures.add(1, ordering: .relaxed)
+                            break
+                        }
+                    }
+                    tally.spawns.add(local, ordering: .relaxed)
+                }
+            }
+
+            let total = tally.spawns.load(ordering: .relaxed)
+            let seconds = Double(nanoseconds(elapsed)) / 1e9
+            Report.line(
+                tally.failures.load(ordering: .relaxed) == 0 ? "BENCH" : "ERR",
+                [
+                    ("name", "throughput.spawn"),
+                    ("threads", "\(threads)"),
+                    ("unit", "spawns/s"),
+                    ("spawns", "\(total)"),
+                    ("seconds", "\(seconds)"),
+                    ("rate", "\(Int(Double(total) / seconds))"),
+                    ("failures", "\(tally.failures.load(ordering: .relaxed))"),
+                ]
+            )
+        }
+    }
+}
+
+// MARK: - Wait
+
+extension Benchmark {
+    /// Cost of one `Wait.wait` call per selector, excluding process start.
+    ///
+    /// Each sample spawns one child, blocks until it is a zombie (WNOWAIT),
+    /// then times only the reaping call. `wait.no-hang` times a WNOHANG poll
+    /// on a stopped child, where nothing is ready.
+    static func wait(_ configuration: Configuration, helper: String) {
+        let child: Child
+        let stopper: Child
+        let leader: POSIX.Kernel.Process.Spawn.Attributes
+        do {
+            child = try Child(helper: helper, "exit", "0")
+            stopper = try Child(helper: helper, "stop-exit", "0")
+            leader = try POSIX.Kernel.Process.Spawn.Attributes()
+            try leader.group(.same)
+        } catch {
+            Report.error("wait", "\(error)")
+            return
+        }
+
+        typealias Selector = POSIX.Kernel.Process.Wait.Selector
+
+        func reap(
+            _ name: String,
+            attributes: POSIX.Kernel.Process.Spawn.Attributes? = nil,
+            _ selector: (Kernel.Process.ID) -> Selector
+        ) {
+            time(name, attributes: attributes) { pid throws(POSIX.Kernel.Process.Error) in
+                _ = try POSIX.Kernel.Process.Wait.wait(selector(pid))
+            }
+        }
+
+        func time(
+            _ name: String,
+            attributes: POSIX.Kernel.Process.Spawn.Attributes? = nil,
+            _ body: (Kernel.Process.ID) throws(POSIX.Kernel.Process.Error) -> Void
+        ) {
+            var samples = Samples(capacity: configuration.iterations)
+            do {
+                for _ in 0..<configuration.iterations {
+                    let pid = try child.spawn(attributes: attributes)
+                    Child.settle(pid)
+                    samples.append(try measure { () throws(POSIX.Kernel.Process.Error) in try body(pid) })
+                }
+                Report.samples(name, samples)
+            } catch {
+                Report.error(name, "\(error)")
+            }
+        }
+
+        reap("wait.process") { .process($0) }
+        reap("wait.any") { _ in .any }
+        reap("wait.current") { _ in .current }
+        reap("wait.group", attributes: leader) { .group(POSIX.Kernel.Process.Group.ID($0.rawValue)) }
+        time("wait.usage") { pid throws(POSIX.Kernel.Process.Error) in
+            _ = try POSIX.Kernel.Process.Wait.Usage.wait(.process(pid))
+        }
+
+        let buffer = UnsafeMutableBufferPointer<POSIX.Kernel.Process.Wait.Result>.allocate(capacity: 1)
+        defer { buffer.deallocate() }
+        time("wait.drain") { _ throws(POSIX.Kernel.Process.Error) in
+            _ = try POSIX.Kernel.Process.Wait.drain(into: buffer)
+        }
+
+        // Nothing ready: a stopped child is not reported without `untraced`
+        var samples = Samples(capacity: configuration.iterations)
+        do {
+            let pid = try stopper.spawn()
+            _ = try POSIX.Kernel.Process.Wait.wait(.process(pid), options: .untraced)
+            for _ in 0..<configuration.iterations {
+                samples.append(
+                    try measure { () throws(POSIX.Kernel.Process.Error) in
+                        _ = try POSIX.Kernel.Process.Wait.wait(.process(pid), options: .no.hang)
+                    }
+                )
+            }
+            try POSIX.Kernel.Process.Kill.kill(pid, .cont)
+            _ = try POSIX.Kernel.Process.Wait.wait(.process(pid))
+            Report.samples("wait.no-hang", samples)
+        } catch {
+            Report.error("wait.no-hang", "\(error)")
+        }
+    }
+}
@@ -0,0 +1,322 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if canImport(Darwin)
+    import Darwin
+#elseif canImport(Glibc)
+    import Glibc
+#elseif canImport(Musl)
+    import Musl
+#endif
+
+import Kernel_Primitives
+import POSIX_Kernel
+
+/// Benchmark namespace.
+enum Benchmark {}
+
+// MARK: - Configuration
+
+extension Benchmark {
+    /// Command-line configuration.
+    ///
+    /// ```
+    /// posix-kernel-benchmarks [--iterations N] [--threads N] [--seconds S] [--suite NAME]...
+    /// ```
+    struct Configuration {
+        /// Samples per latency or wait measurement.
+        var iterations = 1000
+
+        /// Highest thread count for the throughput sweep (1, 2, 4, ... up to this).
+        var threads = Int(sysconf(Int32(_SC_NPROCESSORS_ONLN)))
+
+        /// Wall time per throughput step.
+        var seconds = 2.0
+
+        /// Suites to run: `latency`, `throughput`, `wait`. Empty means all.
+        var suites: Set<String> = []
+
+        init(_ arguments: [String]) {
+            var iterator = arguments.dropFirst().makeIterator()
+            while let argument = iterator.next() {
+                let value = iterator.next()
+                switch argument {
+                case "--iterations": iterations = value.flatMap(Int.init) ?? iterations
+                case "--threads": threads = value.flatMap(Int.init) ?? threads
+                case "--seconds": seconds = value.flatMap(Double.init) ?? seconds
+                case "--suite": if let value { suites.insert(value) }
+                default: Report.error("configuration", "unknown_argument=\(argument)")
+                }
+            }
+            threads = max(threads, 1)
+            iterations = max(iterations, 1)
+        }
+
+        func includes(_ suite: String) -> Bool {
+            suites.isEmpty || suites.contains(suite)
+        }
+    }
+}
+
+// MARK: - Report
+
+extension Benchmark {
+    /// Machine-readable output, one measurement per line.
+    ///
+    /// Follows the posix-test-helper KV protocol: a status word followed by
+    /// space-separated `key=value` pairs. Values never contain spaces.
+    ///
+    /// ```
+    /// INFO system=Linux release=6.8.0 machine=x86_64 cpus=8 iterations=1000
+    /// BENCH name=latency.spawn unit=ns samples=1000 min=... p50=... p99=... mean=... max=...
+    /// BENCH name=throughput.spawn threads=4 unit=spawns/s spawns=... seconds=... rate=...
+    /// ERR name=latency.fork-exec error=...
+    /// ```
+    enum Report {
+        static func line(_ status: String, _ fields: [(String, String)]) {
+            var line = status
+            for (key, value) in fields {
+                line += " \(key)=\(value)"
+            }
+            print(line)
+        }
+
+        static func info(_ configuration: Configuration, helper: String) {
+            var system = utsname()
+            _ = uname(&system)
+            line(
+                "INFO",
+                [
+                    ("system", field(&system.sysname)),
+                    ("release", field(&system.release)),
+                    ("machine", field(&system.machine)),
+                    ("cpus", "\(sysconf(Int32(_SC_NPROCESSORS_ONLN)))"),
+                    ("iterations", "\(configuration.iterations)"),
+                    ("threads", "\(configuration.threads)"),
+                    ("seconds", "\(configuration.seconds)"),
+                    ("helper", helper),
+                ]
+            )
+        }
+
+        static func samples(_ name: String, _ samples: Samples, _ extra: [(String, String)] = []) {
+            line("BENCH", [("name", name)] + extra + samples.summary)
+        }
+
+        static func error(_ name: String, _ error: String) {
+            line("ERR", [("name", name), ("error", error.replacingSpaces)])
+        }
+
+        /// Reads a fixed-size C string field from `utsname`.
+        private static func field<T>(_ tuple: inout T) -> String {
+            withUnsafeBytes(of: &tuple) { raw in
+                String(cString: raw.bindMemory(to: CChar.self).baseAddress!).replacingSpaces
+            }
+        }
+    }
+}
+
+extension String {
+    fileprivate var replacingSpaces: String {
+        String(map { $0 == " " ? "_" : $0 })
+    }
+}
+
+// MARK: - Samples
+
+extension Benchmark {
+    /// Latency samples in nanoseconds.
+    struct Samples {
+        private(set) var values: [Int64] = []
+
+        init(capacity: Int) {
+            values.reserveCapacity(capacity)
+        }
+
+        mutating func append(_ duration: Duration) {
+            values.append(Benchmark.nanoseconds(duration))
+        }
+
+        /// `unit samples min p50 p99 mean max`, all in nanoseconds.
+        var summary: [(String, String)] {
+            guard !values.isEmpty else { return [("unit", "ns"), ("samples", "0")] }
+            let sorted = values.sorted()
+            let mean = sorted.reduce(0, +) / Int64(sorted.count)
+            return [
+                ("unit", "ns"),
+                ("samples", "\(sorted.count)"),
+                ("min", "\(sorted[0])"),
+                ("p50", "\(percentile(sorted, 50))"),
+                ("p99", "\(percentile(sorted, 99))"),
+                ("mean", "\(mean)"),
+                ("max", "\(sorted[sorted.count - 1])"),
+            ]
+        }
+
+        /// Nearest-rank percentile of sorted values.
+        private func percentile(_ sorted: [Int64], _ p: Int) -> Int64 {
+            let rank = (sorted.count * p + 99) / 100
+            return sorted[max(rank, 1) - 1]
+        }
+    }
+
+    static func nanoseconds(_ duration: Duration) -> Int64 {
+        let (seconds, attoseconds) = duration.components
+        return seconds * 1_000_000_000 + attoseconds / 1_000_000_000
+    }
+
+    /// Times one call.
+    static func measure<E: Swift.Error>(_ body: () throws(E) -> Void) throws(E) -> Duration {
+        let clock = ContinuousClock()
+        let start = clock.now
+        try body()
+        return clock.now - start
+    }
+}
+
+// MARK: - Child
+
+extension Benchmark {
+    /// A pre-marshalled posix-test-helper invocation.
+    ///
+    /// argv and envp are built once and never freed: the benchmark reuses
+    /// them for every spawn, so marshalling cost stays out of the numbers.
+    /// The child's stdout goes to /dev/null so helper output does not
+    /// interleave with the report.
+    struct Child: @unchecked Sendable {
+        let path: UnsafePointer<CChar>
+        let argv: UnsafePointer<UnsafePointer<CChar>?>
+        let envp: UnsafePointer<UnsafePointer<CChar>?>
+
+        /// Redirects stdout to /dev/null in spawned children.
+        let fileActions: POSIX.Kernel.Process.Spawn.FileActions
+
+        /// /dev/null, for `dup2` in forked children.
+        let null: Int32
+
+        init(helper: String, _ arguments: String...) throws {
+            let path = UnsafePointer(strdup(helper)!)
+            let strings = [path] + arguments.map { UnsafePointer(strdup($0)!) }
+
+            let argv = UnsafeMutablePointer<UnsafePointer<CChar>?>.allocate(capacity: strings.count + 1)
+            for (index, string) in strings.enumerated() {
+                (argv + index).initialize(to: string)
+            }
+            (argv + strings.count).initialize(to: nil)
+
+            let envp = UnsafeMutablePointer<UnsafePointer<CChar>?>.allocate(capacity: 1)
+            envp.initialize(to: nil)
+
+            let fileActions = try POSIX.Kernel.Process.Spawn.FileActions()
+            try fileActions.open(Kernel.Descriptor(rawValue: 1), path: "/dev/null", flags: O_WRONLY)
+
+            self.path = path
+            self.argv = UnsafePointer(argv)
+            self.envp = UnsafePointer(envp)
+            self.fileActions = fileActions
+            self.null = open("/dev/null", O_WRONLY | O_CLOEXEC)
+        }
+
+        /// Spawns the helper through `Spawn.spawn`.
+        func spawn(
+            attributes: POSIX.Kernel.Process.Spawn.Attributes? = nil
+        ) throws(POSIX.Kernel.Process.Error) -> Kernel.Process.ID {
+            try POSIX.Kernel.Process.Spawn.spawn(
+                path: path,
+                argv: argv,
+                envp: envp,
+                fileActions: fileActions,
+                attributes: attributes
+            )
+        }
+
+        /// Starts the helper through `Fork.fork` + `Execute.execve`.
+        ///
+        /// The child runs only `dup2`, `execve` and `_exit`, which are
+        /// async-signal-safe even though the benchmark is multithreaded.
+        func forkExecute() throws(POSIX.Kernel.Process.Error) -> Kernel.Process.ID {
+            switch try POSIX.Kernel.Process.Fork.fork() {
+            case .child:
+                _ = dup2(null, 1)
+                try? POSIX.Kernel.Process.Execute.execve(path: path, argv: argv, envp: envp)
+                POSIX.Kernel.Process.Exit.now(127)
+            case .parent(let child):
+                return child
+            }
+        }
+
+        /// Blocks until `pid` has exited, without reaping it (WNOWAIT).
+        static func settle(_ pid: Kernel.Process.ID) {
+            var info = siginfo_t()
+            while waitid(P_PID, id_t(pid.rawValue), &info, WEXITED | WNOWAIT) == -1 && errno == EINTR {}
+        }
+    }
+}
+
+// MARK: - Threads
+
+extension Benchmark {
+    /// Runs `body(index)` on `count` dedicated threads and joins them.
+    ///
+    /// Spawning and waiting block, so they do not belong on the Swift
+    /// concurrency pool.
+    static func threads(_ count: Int, _ body: @escaping @Sendable (Int) -> Void) {
+        final class Context: @unchecked Sendable {
+            let index: Int
+            let body: @Sendable (Int) -> Void
+            init(index: Int, body: @escaping @Sendable (Int) -> Void) {
+                self.index = index
+                self.body = body
+            }
+        }
+
+        #if canImport(Darwin)
+            var threads: [pthread_t?] = []
+        #else
+            var threads: [pthread_t] = []
+        #endif
+
+        for index in 0..<count {
+            let context = Unmanaged.passRetained(Context(index: index, body: body)).toOpaque()
+
+            #if canImport(Darwin)
+                var thread: pthread_t?
+                let rc = pthread_create(&thread, nil, { context in
+                    let context = Unmanaged<Context>.fromOpaque(context).takeRetainedValue()
+                    context.body(context.index)
+                    return nil
+                }, context)
+            #else
+                var thread = pthread_t()
+                let rc = pthread_create(&thread, nil, { context in
+                    let context = Unmanaged<Context>.fromOpaque(context!).takeRetainedValue()
+                    context.body(context.index)
+                    return nil
+                }, context)
+            #endif
+
+            guard rc == 0 else {
+                Unmanaged<Context>.fromOpaque(context).release()
+                Report.error("threads", "pthread_create=\(rc)")
+                continue
+            }
+            threads.append(thread)
+        }
+
+        for thread in threads {
+            #if canImport(Darwin)
+                if let thread { _ = pthread_join(thread, nil) }
+            #else
+                _ = pthread_join(thread, nil)
+            #endif
+        }
+    }
+}
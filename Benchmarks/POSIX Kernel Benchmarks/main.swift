@@ -0,0 +1,66 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+/// POSIX Kernel Benchmarks - spawn latency, throughput and wait cost
+///
+/// Uses posix-test-helper as the child, so the numbers measure process
+/// creation and reaping rather than child work.
+///
+/// ## Running
+///
+/// ```
+/// swift build -c release --product posix-test-helper
+/// swift run -c release posix-kernel-benchmarks --iterations 2000 --threads 8
+/// ```
+///
+/// The helper is found through `POSIX_TEST_HELPER`, or next to this
+/// executable (both products land in the same build directory).
+///
+/// ## Output
+///
+/// One KV line per measurement on stdout (see `Benchmark.Report`).
+/// Diff two runs by `name` (and `threads`) to catch regressions.
+
+#if canImport(Darwin)
+    import Darwin
+#elseif canImport(Glibc)
+    import Glibc
+#elseif canImport(Musl)
+    import Musl
+#endif
+
+let configuration = Benchmark.Configuration(CommandLine.arguments)
+
+let helper: String = {
+    if let path = getenv("POSIX_TEST_HELPER") {
+        return String(cString: path)
+    }
+    let executable = CommandLine.arguments[0]
+    guard let slash = executable.lastIndex(of: "/") else { return "posix-test-helper" }
+    return "\(executable[..<slash])/posix-test-helper"
+}()
+
+guard access(helper, X_OK) == 0 else {
+    Benchmark.Report.error("configuration", "helper_not_executable=\(helper)")
+    exit(1)
+}
+
+Benchmark.Report.info(configuration, helper: helper)
+
+if configuration.includes("latency") {
+    Benchmark.latency(configuration, helper: helper)
+}
+if configuration.includes("throughput") {
+    Benchmark.throughput(configuration, helper: helper)
+}
+if configuration.includes("wait") {
+    Benchmark.wait(configuration, helper: helper)
+}
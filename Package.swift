@@ -16,6 +16,12 @@ let package = Package(
             targets: ["POSIX Kernel"]
         ),
     ],
+    traits: [
+        .trait(
+            name: "Tracing",
+            description: "Records spawn, SIGCHLD, reap, signal and dlopen/dlsym timestamps for POSIX.Kernel.Trace"
+        ),
+    ],
     dependencies: [
         .package(url: "https://github.com/coenttb/swift-kernel-primitives.git", from: "0.1.0"),
         .package(url: "https://github.com/swift-standards/swift-standards.git", from: "0.29.0")
@@ -37,6 +43,9 @@ let package = Package(
                 .product(name: "Kernel Primitives", package: "swift-kernel-primitives"),
                 .target(name: "CPOSIXProcessShim", condition: .when(platforms: [.macOS, .iOS, .tvOS, .watchOS, .visionOS, .linux])),
                 .target(name: "POSIX Primitives"),
+            ],
+            swiftSettings: [
+                .define("POSIX_KERNEL_TRACING", .when(traits: ["Tracing"]))
             ]
         ),
         .executableTarget(
@@ -44,15 +53,35 @@ let package = Package(
             dependencies: [],
             path: "Sources/CPOSIXTestHelper"
         ),
+        .executableTarget(
+            name: "posix-zygote-helper",
+            dependencies: [
+                "POSIX Kernel",
+                .product(name: "Kernel Primitives", package: "swift-kernel-primitives")
+            ],
+            path: "Sources/POSIXZygoteHelper"
+        ),
+        .executableTarget(
+            name: "posix-kernel-benchmarks",
+            dependencies: [
+                "POSIX Kernel",
+                .product(name: "Kernel Primitives", package: "swift-kernel-primitives")
+            ],
+            path: "Benchmarks/POSIX Kernel Benchmarks"
+        ),
         .testTarget(
             name: "POSIX Kernel Tests",
             dependencies: [
                 "POSIX Kernel",
                 "posix-test-helper",
+                "posix-zygote-helper",
                 .product(name: "Kernel Primitives Test Support", package: "swift-kernel-primitives"),
                 .product(name: "StandardsTestSupport", package: "swift-standards")
             ],
-            path: "Tests/POSIX Kernel Tests"
+            path: "Tests/POSIX Kernel Tests",
+            swiftSettings: [
+                .define("POSIX_KERNEL_TRACING", .when(traits: ["Tracing"]))
+            ]
         ),
     ]
 )
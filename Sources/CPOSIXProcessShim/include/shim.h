@@ -89,6 +89,1993 @@ static inline int swift_posix_spawn(
     return posix_spawn(pid, path, file_actions, attrp, (char *const *)argv, (char *const *)envp);
 }
 
+// POSIX_SPAWN_SETSID - glibc only declares it under _GNU_SOURCE, and Darwin
+// under _DARWIN_C_SOURCE. Swift's module import may hide both, so expose the
+// value through a function. glibc (2.26+) and musl both use 0x80.
+
+static inline short swift_POSIX_SPAWN_SETSID(void) {
+#if defined(POSIX_SPAWN_SETSID)
+    return POSIX_SPAWN_SETSID;
+#else
+    return 0x80;
+#endif
+}
+
+// Process handles - a pollable descriptor that becomes readable when a child
+// exits. Linux uses pidfd_open(2) (5.3+), which has no glibc wrapper before
+// 2.36. Darwin uses a kqueue with an EVFILT_PROC/NOTE_EXIT registration.
+
+#include <errno.h>
+
+#if defined(__linux__)
+
+#include <signal.h>
+#include <string.h>
+#include <sys/syscall.h>
+
+#ifndef __NR_pidfd_open
+#define __NR_pidfd_open 434
+#endif
+
+static inline int swift_pidfd_open(pid_t pid) {
+    return (int)syscall(__NR_pidfd_open, pid, 0);
+}
+
+#ifndef __NR_pidfd_send_signal
+#define __NR_pidfd_send_signal 424
+#endif
+
+// pidfd_send_signal(2) (5.1+). Targets the process the pidfd refers to, so a
+// recycled PID can never receive the signal. Returns 0 or -1 with errno.
+static inline int swift_pidfd_send_signal(int pidfd, int sig) {
+    return (int)syscall(__NR_pidfd_send_signal, pidfd, sig, NULL, 0);
+}
+
+// Re-encodes waitid(2) siginfo as a waitpid(2) status word, so waitid results
+// decode through the same WIF* macros as waitpid results.
+static inline int swift_wait_status_from_siginfo(const siginfo_t *info) {
+    switch (info->si_code) {
+    case CLD_EXITED:
+        return (info->si_status & 0xff) << 8;
+    case CLD_KILLED:
+        return info->si_status & 0x7f;
+    case CLD_DUMPED:
+        return (info->si_status & 0x7f) | 0x80;
+    case CLD_STOPPED:
+    case CLD_TRAPPED:
+        return ((info->si_status & 0xff) << 8) | 0x7f;
+    case CLD_CONTINUED:
+        return 0xffff;
+    default:
+        return 0;
+    }
+}
+
+// waitid(P_PIDFD, ...) (5.4+). WEXITED is always requested.
+// Returns the child PID, 0 if WNOHANG and nothing is ready, -1 on error.
+static inline pid_t swift_waitid_pidfd(int pidfd, int options, int *status) {
+    siginfo_t info;
+    memset(&info, 0, sizeof(info));
+    // P_PIDFD is 3; older glibc headers lack the enumerator
+    if (waitid((idtype_t)3, (id_t)pidfd, &info, options | WEXITED) != 0) {
+        return -1;
+    }
+    if (info.si_pid == 0) {
+        return 0;
+    }
+    *status = swift_wait_status_from_siginfo(&info);
+    return info.si_pid;
+}
+
+#endif /* __linux__ */
+
+#if defined(__APPLE__)
+
+#include <sys/event.h>
+
+// Returns a kqueue that becomes readable when `pid` exits, or -1 on error.
+// A child that already exited cannot be registered (ESRCH); the queue is then
+// pre-triggered through EVFILT_USER so pollers still wake.
+static inline int swift_process_kqueue(pid_t pid) {
+    int kq = kqueue();
+    if (kq == -1) {
+        return -1;
+    }
+
+    struct kevent change;
+    EV_SET(&change, (uintptr_t)pid, EVFILT_PROC, EV_ADD | EV_ONESHOT, NOTE_EXIT, 0, NULL);
+    if (kevent(kq, &change, 1, NULL, 0, NULL) == 0) {
+        return kq;
+    }
+
+    if (errno == ESRCH) {
+        struct kevent trigger[2];
+        EV_SET(&trigger[0], 0, EVFILT_USER, EV_ADD | EV_ONESHOT, 0, 0, NULL);
+        EV_SET(&trigger[1], 0, EVFILT_USER, 0, NOTE_TRIGGER, 0, NULL);
+        if (kevent(kq, trigger, 2, NULL, 0, NULL) == 0) {
+            return kq;
+        }
+    }
+
+    int saved = errno;
+    close(kq);
+    errno = saved;
+    return -1;
+}
+
+#endif /* __APPLE__ */
+
+// Signal streams - a nonblocking descriptor from which pending signals are
+// read in batches. Linux uses signalfd(2); Darwin uses a kqueue with one
+// EVFILT_SIGNAL registration per signal.
+
+#include <stdint.h>
+
+/// One decoded signal notification.
+typedef struct {
+    int32_t signo;
+    int32_t code;
+    int32_t pid;
+    uint32_t count;
+} swift_signal_record;
+
+/// Maximum records decoded per read call (bounds the on-stack staging buffer).
+#define SWIFT_SIGNAL_BATCH 64
+
+#if defined(__linux__)
+
+#include <sys/signalfd.h>
+
+static inline int swift_signal_stream_open(const sigset_t *mask) {
+    return signalfd(-1, mask, SFD_NONBLOCK | SFD_CLOEXEC);
+}
+
+// Decodes `count` raw signalfd_siginfo records, as read from a signalfd.
+static inline void swift_signal_records_decode(const void *raw, int count, swift_signal_record *records) {
+    const struct signalfd_siginfo *info = (const struct signalfd_siginfo *)raw;
+    for (int i = 0; i < count; i++) {
+        records[i].signo = (int32_t)info[i].ssi_signo;
+        records[i].code = info[i].ssi_code;
+        records[i].pid = (int32_t)info[i].ssi_pid;
+        records[i].count = 1;
+    }
+}
+
+static inline size_t swift_signal_record_size(void) {
+    return sizeof(struct signalfd_siginfo);
+}
+
+// One read(2) for up to SWIFT_SIGNAL_BATCH records.
+// Returns the number decoded, 0 if none pending, -1 on error.
+static inline int swift_signal_stream_read(int fd, swift_signal_record *records, int capacity) {
+    struct signalfd_siginfo info[SWIFT_SIGNAL_BATCH];
+    if (capacity > SWIFT_SIGNAL_BATCH) {
+        capacity = SWIFT_SIGNAL_BATCH;
+    }
+
+    ssize_t n = read(fd, info, sizeof(info[0]) * (size_t)capacity);
+    if (n < 0) {
+        return errno == EAGAIN ? 0 : -1;
+    }
+
+    int count = (int)(n / (ssize_t)sizeof(info[0]));
+    swift_signal_records_decode(info, count, records);
+    return count;
+}
+
+#endif /* __linux__ */
+
+#if defined(__APPLE__)
+
+#ifndef NSIG
+#define NSIG __DARWIN_NSIG
+#endif
+
+static inline int swift_signal_stream_open(const sigset_t *mask) {
+    int kq = kqueue();
+    if (kq == -1) {
+        return -1;
+    }
+
+    for (int signo = 1; signo < NSIG; signo++) {
+        if (sigismember(mask, signo) != 1) {
+            continue;
+        }
+        struct kevent change;
+        EV_SET(&change, (uintptr_t)signo, EVFILT_SIGNAL, EV_ADD, 0, 0, NULL);
+        if (kevent(kq, &change, 1, NULL, 0, NULL) != 0) {
+            int saved = errno;
+            close(kq);
+            errno = saved;
+            return -1;
+        }
+    }
+    return kq;
+}
+
+// One kevent(2) poll for up to SWIFT_SIGNAL_BATCH records. The kernel
+// coalesces repeated deliveries into `count` (kevent data).
+// Returns the number decoded, 0 if none pending, -1 on error.
+static inline int swift_signal_stream_read(int kq, swift_signal_record *records, int capacity) {
+    struct kevent events[SWIFT_SIGNAL_BATCH];
+    if (capacity > SWIFT_SIGNAL_BATCH) {
+        capacity = SWIFT_SIGNAL_BATCH;
+    }
+
+    const struct timespec zero = { 0, 0 };
+    int n = kevent(kq, NULL, 0, events, capacity, &zero);
+    if (n < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        records[i].signo = (int32_t)events[i].ident;
+        records[i].code = 0;
+        records[i].pid = 0;
+        records[i].count = (uint32_t)events[i].data;
+    }
+    return n;
+}
+
+#endif /* __APPLE__ */
+
+// Real-time signal bounds - SIGRTMIN/SIGRTMAX are function-like macros on
+// glibc and musl (the C library reserves the lowest few), so Swift cannot
+// import them. Darwin has no real-time signals and reports -1 for both.
+
+#include <signal.h>
+
+static inline int swift_SIGRTMIN(void) {
+#if defined(SIGRTMIN)
+    return SIGRTMIN;
+#else
+    return -1;
+#endif
+}
+
+static inline int swift_SIGRTMAX(void) {
+#if defined(SIGRTMAX)
+    return SIGRTMAX;
+#else
+    return -1;
+#endif
+}
+
+// Scoped signal blocking - per-thread nesting state for
+// Signal.Mask.withBlocked. Only the outermost scope (or one that blocks
+// signals its enclosing scopes do not) calls pthread_sigmask; `covered` is
+// what the active scopes have blocked so far.
+
+typedef struct {
+    unsigned depth;
+    sigset_t covered;
+} swift_signal_scope;
+
+// The calling thread's scope state. Defined in shim.c so every module that
+// includes this header shares one thread-local; a static inline definition
+// would give each translation unit its own copy and break nesting.
+swift_signal_scope *swift_signal_scope_current(void);
+
+// Tracing - monotonic clock and per-thread buffer slot for POSIX.Kernel.Trace.
+
+#include <time.h>
+
+static inline uint64_t swift_trace_now(void) {
+#if defined(__APPLE__)
+    return clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+// The calling thread's trace buffer slot. Defined in shim.c, as
+// swift_signal_scope_current, so there is one thread-local per thread.
+void **swift_trace_slot(void);
+
+// Descriptor passing - one message plus a batch of descriptors (SCM_RIGHTS)
+// over a Unix domain socket, in a single sendmsg/recvmsg. The control buffer
+// lives on the stack; only sendmsg/recvmsg/fcntl are used, so both are
+// async-signal-safe and may run in a freshly forked child.
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <string.h>
+
+/// Most descriptors in one SCM_RIGHTS message (Linux SCM_MAX_FD).
+#define SWIFT_RIGHTS_MAX 253
+
+typedef union {
+    struct cmsghdr header;
+    char storage[CMSG_SPACE(SWIFT_RIGHTS_MAX * sizeof(int))];
+} swift_rights_control;
+
+// Sends `length` bytes and the `count` descriptors at `fds` (count may be 0).
+// Returns the number of bytes sent, or -1 on error (EINVAL if count exceeds
+// SWIFT_RIGHTS_MAX). Retries on EINTR.
+static inline ssize_t swift_descriptors_send(
+    int socket, const void *bytes, size_t length, const int *fds, int count
+) {
+    if (count < 0 || count > SWIFT_RIGHTS_MAX) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    struct iovec iov = { (void *)bytes, length };
+    swift_rights_control control;
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+
+    if (count > 0) {
+        size_t size = (size_t)count * sizeof(int);
+        memset(control.storage, 0, CMSG_SPACE(size));
+        message.msg_control = control.storage;
+        message.msg_controllen = CMSG_SPACE(size);
+        struct cmsghdr *header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(size);
+        memcpy(CMSG_DATA(header), fds, size);
+    }
+
+    ssize_t n;
+    do {
+        n = sendmsg(socket, &message, 0);
+    } while (n < 0 && errno == EINTR);
+    return n;
+}
+
+// Receives up to `length` bytes and up to `capacity` descriptors into `fds`,
+// storing how many arrived in `*count`. Received descriptors are
+// close-on-exec.
+//
+// A message whose descriptors did not fit (MSG_CTRUNC, or more than
+// `capacity` delivered) fails with EMSGSIZE: every descriptor that did
+// arrive is closed, `*count` is 0, and the payload is consumed.
+//
+// SCM_RIGHTS entries are read only up to the control bytes the kernel
+// reports in msg_controllen. On truncation Darwin can leave cmsg_len at the
+// sender's length, which would otherwise run past the buffer.
+//
+// Returns the number of bytes received, 0 on EOF, or -1 on error.
+static inline ssize_t swift_descriptors_receive(
+    int socket, void *bytes, size_t length, int *fds, int capacity, int *count
+) {
+    *count = 0;
+    if (capacity < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (capacity > SWIFT_RIGHTS_MAX) {
+        capacity = SWIFT_RIGHTS_MAX;
+    }
+
+    struct iovec iov = { bytes, length };
+    swift_rights_control control;
+    size_t space = CMSG_SPACE((size_t)(capacity > 0 ? capacity : 1) * sizeof(int));
+    memset(control.storage, 0, space);
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.storage;
+    message.msg_controllen = space;
+
+#if defined(MSG_CMSG_CLOEXEC)
+    int flags = MSG_CMSG_CLOEXEC;
+#else
+    int flags = 0;
+#endif
+
+    ssize_t n;
+    do {
+        n = recvmsg(socket, &message, flags);
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) {
+        return -1;
+    }
+    int truncated = (message.msg_flags & MSG_CTRUNC) != 0;
+
+    size_t controllen = (size_t)message.msg_controllen;
+    if (controllen > space) {
+        controllen = space;
+    }
+    const char *limit = control.storage + controllen;
+
+    for (struct cmsghdr *header = CMSG_FIRSTHDR(&message); header != NULL;
+         header = CMSG_NXTHDR(&message, header)) {
+        if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS) {
+            continue;
+        }
+        const char *data = (const char *)CMSG_DATA(header);
+        if ((size_t)header->cmsg_len < CMSG_LEN(0) || data >= limit) {
+            continue;
+        }
+        size_t claimed = (size_t)header->cmsg_len - CMSG_LEN(0);
+        size_t present = (size_t)(limit - data);
+        int arrived = (int)((claimed < present ? claimed : present) / sizeof(int));
+        for (int i = 0; i < arrived; i++) {
+            int fd;
+            memcpy(&fd, data + (size_t)i * sizeof(int), sizeof(int));
+            if (*count < capacity) {
+#if !defined(MSG_CMSG_CLOEXEC)
+                fcntl(fd, F_SETFD, FD_CLOEXEC);
+#endif
+                fds[(*count)++] = fd;
+            } else {
+                // Beyond what the caller has room for
+                close(fd);
+                truncated = 1;
+            }
+        }
+    }
+
+    if (truncated) {
+        for (int i = 0; i < *count; i++) {
+            close(fds[i]);
+        }
+        *count = 0;
+        errno = EMSGSIZE;
+        return -1;
+    }
+    return n;
+}
+
+// Sends `length` bytes and, if `fd` >= 0, the descriptor `fd`.
+// Returns the number of bytes sent, or -1 on error. Retries on EINTR.
+static inline ssize_t swift_descriptor_send(int socket, const void *bytes, size_t length, int fd) {
+    return swift_descriptors_send(socket, bytes, length, &fd, fd >= 0 ? 1 : 0);
+}
+
+// Receives up to `length` bytes and at most one descriptor into `*fd`
+// (-1 if none arrived). Received descriptors are close-on-exec.
+// Returns the number of bytes received, 0 on EOF, or -1 on error (EMSGSIZE
+// if more than one descriptor was sent).
+static inline ssize_t swift_descriptor_receive(int socket, void *bytes, size_t length, int *fd) {
+    int count;
+    ssize_t n = swift_descriptors_receive(socket, bytes, length, fd, 1, &count);
+    if (count == 0) {
+        *fd = -1;
+    }
+    return n;
+}
+
+// socketpair with SWIFT_SOCKET_* flags. Linux sets them atomically
+// (SOCK_CLOEXEC, SOCK_NONBLOCK); Darwin has neither, so they are applied with
+// fcntl right after creation.
+#define SWIFT_SOCKET_CLOEXEC 1
+#define SWIFT_SOCKET_NONBLOCK 2
+
+static inline int swift_socketpair(int type, int flags, int *first, int *second) {
+    int fds[2];
+#if defined(SOCK_CLOEXEC) && defined(SOCK_NONBLOCK)
+    if (flags & SWIFT_SOCKET_CLOEXEC) {
+        type |= SOCK_CLOEXEC;
+    }
+    if (flags & SWIFT_SOCKET_NONBLOCK) {
+        type |= SOCK_NONBLOCK;
+    }
+    if (socketpair(AF_UNIX, type, 0, fds) != 0) {
+        return -1;
+    }
+#else
+    if (socketpair(AF_UNIX, type, 0, fds) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < 2; i++) {
+        if ((flags & SWIFT_SOCKET_CLOEXEC) && fcntl(fds[i], F_SETFD, FD_CLOEXEC) != 0) {
+            goto failed;
+        }
+        if (flags & SWIFT_SOCKET_NONBLOCK) {
+            int status = fcntl(fds[i], F_GETFL);
+            if (status == -1 || fcntl(fds[i], F_SETFL, status | O_NONBLOCK) != 0) {
+                goto failed;
+            }
+        }
+    }
+#endif
+    *first = fds[0];
+    *second = fds[1];
+    return 0;
+#if !(defined(SOCK_CLOEXEC) && defined(SOCK_NONBLOCK))
+failed: {
+        int saved = errno;
+        close(fds[0]);
+        close(fds[1]);
+        errno = saved;
+        return -1;
+    }
+#endif
+}
+
+// Pipes - pipe creation with SWIFT_PIPE_* flags, pipe buffer sizing and the
+// Linux zero-copy primitives. splice/tee/vmsplice are GNU-only declarations,
+// so they go through syscall(2) like close_range.
+
+#define SWIFT_PIPE_CLOEXEC 1
+#define SWIFT_PIPE_NONBLOCK 2
+
+// pipe2 on Linux (atomic); pipe + fcntl on Darwin.
+static inline int swift_pipe(int flags, int *read_end, int *write_end) {
+    int fds[2];
+#if defined(__linux__)
+    int native = ((flags & SWIFT_PIPE_CLOEXEC) ? O_CLOEXEC : 0) | ((flags & SWIFT_PIPE_NONBLOCK) ? O_NONBLOCK : 0);
+    if (syscall(SYS_pipe2, fds, native) != 0) {
+        return -1;
+    }
+#else
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < 2; i++) {
+        int status = 0;
+        if (((flags & SWIFT_PIPE_CLOEXEC) && fcntl(fds[i], F_SETFD, FD_CLOEXEC) != 0)
+            || ((flags & SWIFT_PIPE_NONBLOCK)
+                && ((status = fcntl(fds[i], F_GETFL)) == -1 || fcntl(fds[i], F_SETFL, status | O_NONBLOCK) != 0))) {
+            int saved = errno;
+            close(fds[0]);
+            close(fds[1]);
+            errno = saved;
+            return -1;
+        }
+    }
+#endif
+    *read_end = fds[0];
+    *write_end = fds[1];
+    return 0;
+}
+
+#if defined(__linux__)
+
+#ifndef F_SETPIPE_SZ
+#define F_SETPIPE_SZ 1031
+#endif
+#ifndef F_GETPIPE_SZ
+#define F_GETPIPE_SZ 1032
+#endif
+
+#define SWIFT_SPLICE_MOVE 1
+#define SWIFT_SPLICE_NONBLOCK 2
+#define SWIFT_SPLICE_MORE 4
+#define SWIFT_SPLICE_GIFT 8
+
+// Pipe buffer size in bytes, or -1.
+static inline int swift_pipe_capacity(int fd) {
+    return fcntl(fd, F_GETPIPE_SZ);
+}
+
+// Resizes the pipe buffer; the kernel rounds up to a power-of-two number of
+// pages. Returns the new size, or -1 (EPERM above /proc/sys/fs/pipe-max-size,
+// EBUSY below the bytes currently queued).
+static inline int swift_pipe_resize(int fd, int size) {
+    return fcntl(fd, F_SETPIPE_SZ, size);
+}
+
+// Moves up to `length` bytes from `in` to `out` without copying through
+// userspace; one of them must be a pipe. Returns bytes moved, 0 at EOF, or
+// -1. Retries on EINTR.
+static inline ssize_t swift_splice(int in, int out, size_t length, unsigned int flags) {
+    ssize_t n;
+    do {
+        n = syscall(SYS_splice, in, NULL, out, NULL, length, flags);
+    } while (n < 0 && errno == EINTR);
+    return n;
+}
+
+// Duplicates up to `length` bytes from pipe `in` to pipe `out` without
+// consuming them. Returns bytes duplicated, 0 if `in` is empty and its writers
+// are gone, or -1. Retries on EINTR.
+static inline ssize_t swift_tee(int in, int out, size_t length, unsigned int flags) {
+    ssize_t n;
+    do {
+        n = syscall(SYS_tee, in, out, length, flags);
+    } while (n < 0 && errno == EINTR);
+    return n;
+}
+
+// Maps `length` bytes of user memory into pipe `fd`. With SWIFT_SPLICE_GIFT
+// the pages are handed over and must not be modified afterwards. Returns
+// bytes queued, or -1. Retries on EINTR.
+static inline ssize_t swift_vmsplice(int fd, const void *bytes, size_t length, unsigned int flags) {
+    struct iovec iov = { (void *)bytes, length };
+    ssize_t n;
+    do {
+        n = syscall(SYS_vmsplice, fd, &iov, 1UL, flags);
+    } while (n < 0 && errno == EINTR);
+    return n;
+}
+
+#endif /* __linux__ */
+
+// vfork spawn - runs a restricted pre-exec step list in a child that shares
+// the parent's address space (Linux: clone(CLONE_VM | CLONE_VFORK) on a
+// private stack; Darwin: vfork). No page tables are copied, so the cost does
+// not depend on parent RSS. Between clone and execve the child only makes
+// async-signal-safe syscalls and writes its result into `swift_vfork_args`.
+
+#include <limits.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/mman.h>
+#include <pthread.h>
+#include <sched.h>
+
+// Scheduling. The glibc wrappers for the affinity calls and the BATCH and
+// IDLE policies are _GNU_SOURCE-only, so Linux goes through syscall(2).
+// The raw sched_getaffinity returns the mask size; these return 0 or -1.
+
+#if defined(__linux__)
+#define SWIFT_SCHED_BATCH 3
+#define SWIFT_SCHED_IDLE 5
+#endif
+
+static inline int swift_sched_setaffinity(pid_t pid, size_t size, const void *mask) {
+#if defined(__linux__)
+    return syscall(SYS_sched_setaffinity, pid, size, mask) < 0 ? -1 : 0;
+#else
+    (void)pid;
+    (void)size;
+    (void)mask;
+    errno = ENOTSUP;
+    return -1;
+#endif
+}
+
+static inline int swift_sched_getaffinity(pid_t pid, size_t size, void *mask) {
+#if defined(__linux__)
+    memset(mask, 0, size);
+    return syscall(SYS_sched_getaffinity, pid, size, mask) < 0 ? -1 : 0;
+#else
+    (void)pid;
+    (void)size;
+    (void)mask;
+    errno = ENOTSUP;
+    return -1;
+#endif
+}
+
+// sched_setscheduler, or sched_setparam when `policy` < 0.
+static inline int swift_sched_set(pid_t pid, int policy, int priority) {
+#if defined(__linux__)
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+    return policy < 0 ? sched_setparam(pid, &param) : sched_setscheduler(pid, policy, &param);
+#else
+    (void)pid;
+    (void)policy;
+    (void)priority;
+    errno = ENOTSUP;
+    return -1;
+#endif
+}
+
+static inline int swift_posix_spawnattr_setschedparam(posix_spawnattr_t *attr, int priority) {
+#if defined(__linux__)
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+    return posix_spawnattr_setschedparam(attr, &param);
+#else
+    (void)attr;
+    (void)priority;
+    return ENOTSUP;
+#endif
+}
+
+enum {
+    SWIFT_STEP_DUP2 = 1,        // dup2(first, second); clears FD_CLOEXEC if equal
+    SWIFT_STEP_CHDIR = 2,       // chdir(pointer)
+    SWIFT_STEP_SETPGID = 3,     // setpgid(0, first)
+    SWIFT_STEP_SETSID = 4,      // setsid()
+    SWIFT_STEP_CLOSE_RANGE = 5, // close [first, second]; second < 0 means all
+    SWIFT_STEP_SIGNAL_RESET = 6,// SIG_DFL for every signal in *(sigset_t *)pointer
+    SWIFT_STEP_SIGNAL_MASK = 7, // exec with *(sigset_t *)pointer as the mask
+    SWIFT_STEP_RLIMIT = 8,      // setrlimit(first, { soft, hard })
+    SWIFT_STEP_OPEN = 9,        // open(pointer, second, flags) onto descriptor first
+    SWIFT_STEP_CLOSE_EXCEPT = 10,// close all but the `first` sorted descriptors at pointer
+    SWIFT_STEP_AFFINITY = 11,   // sched_setaffinity(0, first bytes, pointer) (Linux)
+    SWIFT_STEP_SCHEDULER = 12,  // sched_setscheduler(0, first, { second }); first < 0: sched_setparam (Linux)
+    SWIFT_STEP_NICE = 13,       // setpriority(PRIO_PROCESS, 0, first)
+};
+
+/// close_range(2) flag: mark close-on-exec instead of closing (Linux 5.11+).
+#define SWIFT_CLOSE_RANGE_CLOEXEC 4
+
+/// One pre-exec step. Unused fields are ignored.
+typedef struct {
+    int32_t kind;
+    int32_t first;
+    int32_t second;
+    int32_t flags;
+    uint64_t soft;
+    uint64_t hard;
+    const void *pointer;
+} swift_spawn_step;
+
+typedef struct {
+    const char *path;
+    const char *const *argv;
+    const char *const *envp;
+    const swift_spawn_step *steps;
+    int count;
+    // Second list run after `steps` (file actions after attributes)
+    const swift_spawn_step *after;
+    int after_count;
+    sigset_t mask;
+    // Written by the child (shared memory); read by the parent after it resumes
+    volatile int error;
+    volatile int failed;
+} swift_vfork_args;
+
+// RLIM_INFINITY - a cast expression on Darwin that Swift does not import.
+static inline uint64_t swift_RLIM_INFINITY(void) {
+    return (uint64_t)RLIM_INFINITY;
+}
+
+#if defined(__linux__)
+
+#ifndef __NR_close_range
+#define __NR_close_range 436
+#endif
+
+#ifndef CLONE_VM
+#define CLONE_VM 0x00000100
+#endif
+
+#ifndef CLONE_VFORK
+#define CLONE_VFORK 0x00004000
+#endif
+
+// Forward declaration: glibc only declares clone under _GNU_SOURCE
+extern int clone(int (*fn)(void *), void *stack, int flags, void *arg, ...);
+
+#endif /* __linux__ */
+
+// Applies `flags` (0 = close, SWIFT_CLOSE_RANGE_CLOEXEC = mark) to one descriptor.
+static inline void swift_close_one(int fd, int flags) {
+    if (flags & SWIFT_CLOSE_RANGE_CLOEXEC) {
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    } else {
+        close(fd);
+    }
+}
+
+#if defined(__linux__)
+
+// Fallback for kernels without close_range: walks /proc/self/fd with raw
+// getdents64 into a stack buffer (no malloc, async-signal-safe), so the cost
+// follows the number of open descriptors, not RLIMIT_NOFILE.
+// Returns 0, or -1 if /proc is unavailable.
+static inline int swift_close_scan(int first, int last, int flags) {
+    int dir = open("/proc/self/fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir < 0) {
+        return -1;
+    }
+
+    char buffer[4096] __attribute__((aligned(8)));
+    for (;;) {
+        long n = syscall(SYS_getdents64, dir, buffer, sizeof(buffer));
+        if (n <= 0) {
+            break;
+        }
+        for (long offset = 0; offset < n;) {
+            // struct linux_dirent64: ino (8), off (8), reclen (2), type (1), name
+            unsigned short length;
+            memcpy(&length, buffer + offset + 16, sizeof(length));
+            const char *name = buffer + offset + 19;
+            offset += length;
+
+            if (name[0] < '0' || name[0] > '9') {
+                continue;
+            }
+            int fd = 0;
+            for (const char *c = name; *c >= '0' && *c <= '9'; c++) {
+                fd = fd * 10 + (*c - '0');
+            }
+            if (fd != dir && fd >= first && (last < 0 || fd <= last)) {
+                swift_close_one(fd, flags);
+            }
+        }
+    }
+
+    close(dir);
+    return 0;
+}
+
+#endif /* __linux__ */
+
+// Descriptor ceiling for when every descriptor must be covered but the
+// RLIMIT_NOFILE limits are both unlimited: OPEN_MAX on Darwin, Linux's
+// default fs.nr_open otherwise.
+#if defined(OPEN_MAX)
+#define SWIFT_DESCRIPTOR_CEILING OPEN_MAX
+#else
+#define SWIFT_DESCRIPTOR_CEILING (1 << 20)
+#endif
+
+// Size of the descriptor table: the soft RLIMIT_NOFILE, else the hard one,
+// else SWIFT_DESCRIPTOR_CEILING. Uses getrlimit, a plain syscall, since
+// sysconf is not async-signal-safe. Returns -1 with errno set on failure.
+static inline int swift_descriptor_limit(void) {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return -1;
+    }
+    rlim_t value = limit.rlim_cur != RLIM_INFINITY ? limit.rlim_cur : limit.rlim_max;
+    if (value == RLIM_INFINITY) {
+        value = SWIFT_DESCRIPTOR_CEILING;
+    }
+    return value > INT_MAX ? INT_MAX : (int)value;
+}
+
+// Closes (or marks close-on-exec) descriptors [first, last]; last < 0 means all.
+// Linux: close_range(2) (5.9+; CLOEXEC 5.11+), then a /proc/self/fd scan.
+// Darwin, or without /proc: a loop bounded by swift_descriptor_limit.
+static inline int swift_close_range(int first, int last, int flags) {
+#if defined(__linux__)
+    unsigned int upper = last < 0 ? ~0U : (unsigned int)last;
+    if (syscall(__NR_close_range, (unsigned int)first, upper, (unsigned int)flags) == 0) {
+        return 0;
+    }
+    // ENOSYS: no close_range; EINVAL: flag unsupported (5.9, 5.10)
+    if (errno != ENOSYS && errno != EINVAL) {
+        return -1;
+    }
+    if (swift_close_scan(first, last, flags) == 0) {
+        return 0;
+    }
+#endif
+    int limit = swift_descriptor_limit();
+    if (limit < 0) {
+        return -1;
+    }
+    int end = (last < 0 || last >= limit) ? limit - 1 : last;
+    for (int fd = first; fd <= end; fd++) {
+        swift_close_one(fd, flags);
+    }
+    return 0;
+}
+
+// Closes (or marks) every descriptor except `keep[0..<count]`, which must be
+// sorted ascending without duplicates. One close_range call per gap.
+static inline int swift_close_except(const int32_t *keep, int count, int flags) {
+    int first = 0;
+    for (int i = 0; i < count; i++) {
+        if (keep[i] > first && swift_close_range(first, keep[i] - 1, flags) != 0) {
+            return -1;
+        }
+        first = keep[i] + 1;
+    }
+    return swift_close_range(first, -1, flags);
+}
+
+static inline int swift_vfork_run_step(const swift_spawn_step *step, sigset_t *mask) {
+    switch (step->kind) {
+    case SWIFT_STEP_DUP2:
+        if (step->first == step->second) {
+            int flags = fcntl(step->first, F_GETFD);
+            return flags == -1 ? -1 : fcntl(step->first, F_SETFD, flags & ~FD_CLOEXEC);
+        }
+        return dup2(step->first, step->second) == -1 ? -1 : 0;
+    case SWIFT_STEP_CHDIR:
+        return chdir((const char *)step->pointer);
+    case SWIFT_STEP_SETPGID:
+        return setpgid(0, step->first);
+    case SWIFT_STEP_SETSID:
+        return setsid() == -1 ? -1 : 0;
+    case SWIFT_STEP_CLOSE_RANGE:
+        return swift_close_range(step->first, step->second, step->flags);
+    case SWIFT_STEP_SIGNAL_RESET: {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = SIG_DFL;
+        for (int signo = 1; signo < NSIG; signo++) {
+            if (sigismember((const sigset_t *)step->pointer, signo) == 1) {
+                sigaction(signo, &action, NULL);
+            }
+        }
+        return 0;
+    }
+    case SWIFT_STEP_SIGNAL_MASK:
+        *mask = *(const sigset_t *)step->pointer;
+        return 0;
+    case SWIFT_STEP_OPEN: {
+        int fd = open((const char *)step->pointer, step->second, (mode_t)step->flags);
+        if (fd == -1 || fd == step->first) {
+            return fd == -1 ? -1 : 0;
+        }
+        int rc = dup2(fd, step->first);
+        close(fd);
+        return rc == -1 ? -1 : 0;
+    }
+    case SWIFT_STEP_CLOSE_EXCEPT:
+        return swift_close_except((const int32_t *)step->pointer, step->first, SWIFT_CLOSE_RANGE_CLOEXEC);
+    case SWIFT_STEP_RLIMIT: {
+        struct rlimit limit;
+        limit.rlim_cur = (rlim_t)step->soft;
+        limit.rlim_max = (rlim_t)step->hard;
+        return setrlimit(step->first, &limit);
+    }
+    case SWIFT_STEP_AFFINITY:
+        return swift_sched_setaffinity(0, (size_t)step->first, step->pointer);
+    case SWIFT_STEP_SCHEDULER:
+        return swift_sched_set(0, step->first, step->second);
+    case SWIFT_STEP_NICE:
+        return setpriority(PRIO_PROCESS, 0, step->first);
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+}
+
+// Child body. Never returns: execs or _exits with 127.
+static inline int swift_vfork_child(void *context) {
+    swift_vfork_args *args = (swift_vfork_args *)context;
+
+    // Parent handlers must never run on the shared address space
+    struct sigaction action;
+    for (int signo = 1; signo < NSIG; signo++) {
+        if (sigaction(signo, NULL, &action) == 0
+            && action.sa_handler != SIG_DFL && action.sa_handler != SIG_IGN) {
+            action.sa_handler = SIG_DFL;
+            action.sa_flags = 0;
+            sigaction(signo, &action, NULL);
+        }
+    }
+
+    sigset_t mask = args->mask;
+    int total = args->count + args->after_count;
+    for (int i = 0; i < total; i++) {
+        const swift_spawn_step *step = i < args->count ? &args->steps[i] : &args->after[i - args->count];
+        if (swift_vfork_run_step(step, &mask) != 0) {
+            args->error = errno;
+            args->failed = i;
+            _exit(127);
+        }
+    }
+
+    sigprocmask(SIG_SETMASK, &mask, NULL);
+    execve(args->path, (char *const *)args->argv, (char *const *)args->envp);
+    args->error = errno;
+    args->failed = total;
+    _exit(127);
+}
+
+#if defined(__linux__)
+
+// clone3(2) (5.3+) with CLONE_INTO_CGROUP (5.7+) places the child in a
+// cgroup v2 directory before it runs, and CLONE_PIDFD returns its pidfd
+// from the same syscall. glibc exposes no clone3 wrapper, and a raw
+// syscall cannot share the caller's stack, so the trampoline below enters
+// the child on its own stack. Other architectures report ENOSYS.
+
+#ifndef __NR_clone3
+#define __NR_clone3 435
+#endif
+
+#define SWIFT_CLONE_PIDFD 0x00001000ULL
+#define SWIFT_CLONE_INTO_CGROUP 0x200000000ULL
+
+/// struct clone_args, CLONE_ARGS_SIZE_VER2.
+typedef struct {
+    uint64_t flags;
+    uint64_t pidfd;
+    uint64_t child_tid;
+    uint64_t parent_tid;
+    uint64_t exit_signal;
+    uint64_t stack;
+    uint64_t stack_size;
+    uint64_t tls;
+    uint64_t set_tid;
+    uint64_t set_tid_size;
+    uint64_t cgroup;
+} swift_clone_args;
+
+// Runs `fn(arg)` in the child on `args->stack` and exits with its result.
+// Returns the child PID in the parent, or -1 with errno set.
+static inline long swift_clone3(swift_clone_args *args, int (*fn)(void *), void *arg) {
+#if defined(__x86_64__)
+    register long rax __asm__("rax") = __NR_clone3;
+    register swift_clone_args *rdi __asm__("rdi") = args;
+    register unsigned long rsi __asm__("rsi") = sizeof(*args);
+    register int (*r12)(void *) __asm__("r12") = fn;
+    register void *r13 __asm__("r13") = arg;
+    __asm__ volatile(
+        "syscall\n\t"
+        "test %%rax, %%rax\n\t"
+        "jnz 1f\n\t"
+        "xor %%ebp, %%ebp\n\t"
+        "mov %%r13, %%rdi\n\t"
+        "call *%%r12\n\t"
+        "mov %%eax, %%edi\n\t"
+        "mov $60, %%eax\n\t"
+        "syscall\n\t"
+        "hlt\n\t"
+        "1:\n\t"
+        : "+r"(rax)
+        : "r"(rdi), "r"(rsi), "r"(r12), "r"(r13)
+        : "rcx", "r11", "memory", "cc");
+    long result = rax;
+#elif defined(__aarch64__)
+    register long x0 __asm__("x0") = (long)args;
+    register unsigned long x1 __asm__("x1") = sizeof(*args);
+    register long x8 __asm__("x8") = __NR_clone3;
+    register int (*x9)(void *) __asm__("x9") = fn;
+    register void *x10 __asm__("x10") = arg;
+    __asm__ volatile(
+        "svc #0\n\t"
+        "cbnz x0, 1f\n\t"
+        "mov x29, xzr\n\t"
+        "mov x30, xzr\n\t"
+        "mov x0, x10\n\t"
+        "blr x9\n\t"
+        "mov x8, #93\n\t"
+        "svc #0\n\t"
+        "1:\n\t"
+        : "+r"(x0)
+        : "r"(x1), "r"(x8), "r"(x9), "r"(x10)
+        : "memory", "cc");
+    long result = x0;
+#else
+    (void)args;
+    (void)fn;
+    (void)arg;
+    long result = -ENOSYS;
+#endif
+    if (result < 0) {
+        errno = (int)-result;
+        return -1;
+    }
+    return result;
+}
+
+#endif /* __linux__ */
+
+// Spawns `path` after running `steps`, then `after`, in a vfork child.
+// Returns the child PID, or -1 with *error set to the errno and *failed to the
+// index of the failing step across both lists (`count + after_count` for
+// execve itself). A child that failed has already been reaped.
+//
+// Linux only: `cgroup` >= 0 is a cgroup v2 directory descriptor the child
+// starts in, and a non-NULL `pidfd` receives the child's pidfd (O_CLOEXEC)
+// from clone3. Without a cgroup, a clone3 that fails with ENOSYS (kernel
+// before 5.3) or EPERM (seccomp profiles written before clone3 existed, as in
+// many container runtimes) falls back to clone and stores -1 in *pidfd; the
+// caller then opens the pidfd with pidfd_open. Darwin ignores both.
+static inline pid_t swift_vfork_spawn_clone(
+    const char *path,
+    const char *const argv[],
+    const char *const envp[],
+    const swift_spawn_step *steps,
+    int count,
+    const swift_spawn_step *after,
+    int after_count,
+    int cgroup,
+    int *pidfd,
+    int *error,
+    int *failed
+) {
+    swift_vfork_args args;
+    memset(&args, 0, sizeof(args));
+    args.path = path;
+    args.argv = argv;
+    args.envp = envp;
+    args.steps = steps;
+    args.count = count;
+    args.after = after;
+    args.after_count = after_count;
+    args.failed = -1;
+
+    // Block everything so no signal is handled in the child before its
+    // handlers are reset; the child restores the caller's mask before exec
+    sigset_t all;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &args.mask);
+
+#if defined(__linux__)
+    const size_t size = 64 * 1024;
+    void *stack = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    pid_t pid = -1;
+    if (pidfd) {
+        *pidfd = -1;
+    }
+    if (stack != MAP_FAILED) {
+        if (cgroup >= 0 || pidfd) {
+            int descriptor = -1;
+            swift_clone_args request;
+            memset(&request, 0, sizeof(request));
+            request.flags = CLONE_VM | CLONE_VFORK;
+            request.exit_signal = SIGCHLD;
+            request.stack = (uint64_t)(uintptr_t)stack;
+            request.stack_size = size;
+            if (pidfd) {
+                request.flags |= SWIFT_CLONE_PIDFD;
+                request.pidfd = (uint64_t)(uintptr_t)&descriptor;
+            }
+            if (cgroup >= 0) {
+                request.flags |= SWIFT_CLONE_INTO_CGROUP;
+                request.cgroup = (uint64_t)cgroup;
+            }
+            pid = (pid_t)swift_clone3(&request, swift_vfork_child, &args);
+            if (pid > 0 && pidfd) {
+                *pidfd = descriptor;
+            }
+        }
+        if (cgroup < 0 && (!pidfd || (pid == -1 && (errno == ENOSYS || errno == EPERM)))) {
+            pid = clone(swift_vfork_child, (char *)stack + size, CLONE_VM | CLONE_VFORK | SIGCHLD, &args);
+        }
+        int saved = errno;
+        munmap(stack, size);
+        errno = saved;
+    }
+#else
+    (void)cgroup;
+    (void)pidfd;
+    pid_t pid = vfork();
+    if (pid == 0) {
+        swift_vfork_child(&args);
+    }
+#endif
+
+    int saved = errno;
+    pthread_sigmask(SIG_SETMASK, &args.mask, NULL);
+
+    if (pid == -1) {
+        *error = saved;
+        *failed = -1;
+        return -1;
+    }
+
+    if (args.error != 0) {
+        int status;
+        while (waitpid(pid, &status, 0) == -1 && errno == EINTR) {}
+#if defined(__linux__)
+        if (pidfd && *pidfd >= 0) {
+            close(*pidfd);
+            *pidfd = -1;
+        }
+#endif
+        *error = args.error;
+        *failed = args.failed;
+        return -1;
+    }
+
+    return pid;
+}
+
+// Spawns `path` after running `steps`, then `after`. See swift_vfork_spawn_clone.
+static inline pid_t swift_vfork_spawn_pair(
+    const char *path,
+    const char *const argv[],
+    const char *const envp[],
+    const swift_spawn_step *steps,
+    int count,
+    const swift_spawn_step *after,
+    int after_count,
+    int *error,
+    int *failed
+) {
+    return swift_vfork_spawn_clone(path, argv, envp, steps, count, after, after_count, -1, NULL, error, failed);
+}
+
+// Spawns `path` after running `steps` in a vfork child. See swift_vfork_spawn_pair.
+static inline pid_t swift_vfork_spawn(
+    const char *path,
+    const char *const argv[],
+    const char *const envp[],
+    const swift_spawn_step *steps,
+    int count,
+    int *error,
+    int *failed
+) {
+    return swift_vfork_spawn_pair(path, argv, envp, steps, count, NULL, 0, error, failed);
+}
+
+// Runs `steps` in the calling process, then execve. Only returns on failure,
+// with errno set; steps that ran before the failure are not undone.
+// Async-signal-safe: usable in a forked child.
+static inline int swift_execve_steps(
+    const char *path,
+    const char *const argv[],
+    const char *const envp[],
+    const swift_spawn_step *steps,
+    int count
+) {
+    sigset_t mask;
+    pthread_sigmask(SIG_SETMASK, NULL, &mask);
+    for (int i = 0; i < count; i++) {
+        if (swift_vfork_run_step(&steps[i], &mask) != 0) {
+            return -1;
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &mask, NULL);
+    return execve(path, (char *const *)argv, (char *const *)envp);
+}
+
+// Link-map namespaces (glibc). dlmopen and dlinfo are declared only under
+// _GNU_SOURCE, which Swift's Glibc module does not define; the prototypes
+// below match glibc's and are harmless redeclarations when it is defined.
+#include <dlfcn.h>
+
+#if defined(__linux__) && defined(__GLIBC__)
+
+extern void *dlmopen(long nsid, const char *file, int mode);
+extern int dlinfo(void *__restrict handle, int request, void *__restrict arg);
+
+#define SWIFT_LM_ID_BASE 0
+#define SWIFT_LM_ID_NEWLM (-1)
+#define SWIFT_RTLD_DI_LMID 1
+
+static inline void *swift_dlmopen(long nsid, const char *file, int mode) {
+    return dlmopen(nsid, file, mode);
+}
+
+// Stores the namespace of a dlopen/dlmopen handle in `nsid`. Returns 0, or
+// -1 with the reason in dlerror.
+static inline int swift_dlinfo_lmid(void *handle, long *nsid) {
+    return dlinfo(handle, SWIFT_RTLD_DI_LMID, nsid);
+}
+
+#endif /* __linux__ && __GLIBC__ */
+
+// Range locking and advice. Each call widens [addr, addr + len) to whole
+// pages first: madvise rejects an unaligned start, and POSIX lets mlock
+// do the same. Destructive advice is the exception: it shrinks the range
+// inward instead, so bytes of neighbouring allocations on a shared first or
+// last page are never discarded.
+#include <stdint.h>
+#include <sys/mman.h>
+
+#define SWIFT_MLOCK_ONFAULT 1
+
+#if defined(__linux__)
+// Linux madvise values, spelled out for headers that predate them
+#define SWIFT_MADV_HUGEPAGE 14
+#define SWIFT_MADV_NOHUGEPAGE 15
+#define SWIFT_MADV_COLD 20
+#define SWIFT_MADV_PAGEOUT 21
+#define SWIFT_MADV_POPULATE_READ 22
+#define SWIFT_MADV_POPULATE_WRITE 23
+#define SWIFT_MADV_DONTFORK 10
+#define SWIFT_MADV_DOFORK 11
+#define SWIFT_MADV_WIPEONFORK 18
+#define SWIFT_MADV_KEEPONFORK 19
+#define SWIFT_MADV_COLLAPSE 25
+#endif
+
+static inline void swift_page_span(const void *addr, size_t len, void **start, size_t *length) {
+    uintptr_t mask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1;
+    uintptr_t first = (uintptr_t)addr & ~mask;
+    uintptr_t end = ((uintptr_t)addr + len + mask) & ~mask;
+    *start = (void *)first;
+    *length = (size_t)(end - first);
+}
+
+// mlock, or mlock2 when `flags` is non-zero (Linux 4.4+; ENOSYS elsewhere).
+static inline int swift_mlock_range(const void *addr, size_t len, unsigned int flags) {
+    if (len == 0) {
+        return 0;
+    }
+    void *start;
+    size_t length;
+    swift_page_span(addr, len, &start, &length);
+    if (flags == 0) {
+        return mlock(start, length);
+    }
+#if defined(__linux__) && defined(SYS_mlock2)
+    return (int)syscall(SYS_mlock2, start, length, flags);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+static inline int swift_munlock_range(const void *addr, size_t len) {
+    if (len == 0) {
+        return 0;
+    }
+    void *start;
+    size_t length;
+    swift_page_span(addr, len, &start, &length);
+    return munlock(start, length);
+}
+
+// The whole pages inside [addr, addr + len); `*length` is 0 if there are none.
+static inline void swift_page_span_inward(const void *addr, size_t len, void **start, size_t *length) {
+    uintptr_t mask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1;
+    uintptr_t first = ((uintptr_t)addr + mask) & ~mask;
+    uintptr_t end = ((uintptr_t)addr + len) & ~mask;
+    *start = (void *)first;
+    *length = end > first ? (size_t)(end - first) : 0;
+}
+
+// Advice that discards or replaces page contents: MADV_DONTNEED zeroes
+// private anonymous pages, MADV_FREE and MADV_FREE_REUSABLE may, MADV_REMOVE
+// punches a hole, MADV_PAGEOUT reclaims now, and MADV_DONTFORK and
+// MADV_WIPEONFORK take the pages away from children.
+static inline int swift_madvise_destructive(int advice) {
+    switch (advice) {
+    case MADV_DONTNEED:
+#if defined(MADV_FREE)
+    case MADV_FREE:
+#endif
+#if defined(MADV_FREE_REUSABLE)
+    case MADV_FREE_REUSABLE:
+#endif
+#if defined(__linux__)
+    case MADV_REMOVE:
+    case SWIFT_MADV_PAGEOUT:
+    // Destructive for the child: its copy is unmapped or zero-filled
+    case SWIFT_MADV_DONTFORK:
+    case SWIFT_MADV_WIPEONFORK:
+#endif
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static inline int swift_madvise_range(const void *addr, size_t len, int advice) {
+    if (len == 0) {
+        return 0;
+    }
+    void *start;
+    size_t length;
+    if (swift_madvise_destructive(advice)) {
+        swift_page_span_inward(addr, len, &start, &length);
+        if (length == 0) {
+            return 0;
+        }
+    } else {
+        swift_page_span(addr, len, &start, &length);
+    }
+    return madvise(start, length, advice);
+}
+
+// Fork preparation - advice applied to registered regions before fork, and
+// the pre-exec step interpreter run in the child after it, without exec.
+
+#if defined(__APPLE__)
+#include <mach/vm_inherit.h>
+#endif
+
+enum {
+    SWIFT_FORK_EXCLUDE = 1,  // not mapped in the child (MADV_DONTFORK; Darwin: minherit VM_INHERIT_NONE)
+    SWIFT_FORK_WIPE = 2,     // zero-filled in the child (MADV_WIPEONFORK, Linux 4.14+)
+    SWIFT_FORK_COLLAPSE = 3, // collapse into huge pages; best effort (MADV_COLLAPSE, Linux 6.1+)
+};
+
+typedef struct {
+    int32_t kind;
+    const void *base;
+    size_t length;
+} swift_fork_region;
+
+// Exclude and wipe take whole pages from the child, so a region must be
+// exactly those pages: EINVAL if its start or length is not page-aligned.
+static inline int swift_fork_region_aligned(const swift_fork_region *region) {
+    uintptr_t mask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1;
+    return ((uintptr_t)region->base & mask) == 0 && (region->length & mask) == 0;
+}
+
+static inline int swift_fork_region_apply(const swift_fork_region *region) {
+    if (region->kind != SWIFT_FORK_COLLAPSE && !swift_fork_region_aligned(region)) {
+        errno = EINVAL;
+        return -1;
+    }
+    switch (region->kind) {
+#if defined(__linux__)
+    case SWIFT_FORK_EXCLUDE:
+        return swift_madvise_range(region->base, region->length, SWIFT_MADV_DONTFORK);
+    case SWIFT_FORK_WIPE:
+        return swift_madvise_range(region->base, region->length, SWIFT_MADV_WIPEONFORK);
+    case SWIFT_FORK_COLLAPSE: {
+        // EINVAL without THP, EAGAIN under memory pressure: fork regardless
+        int saved = errno;
+        swift_madvise_range(region->base, region->length, SWIFT_MADV_COLLAPSE);
+        errno = saved;
+        return 0;
+    }
+#elif defined(__APPLE__)
+    case SWIFT_FORK_EXCLUDE:
+        if (region->length == 0) {
+            return 0;
+        }
+        return minherit((void *)region->base, region->length, VM_INHERIT_NONE);
+#endif
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+}
+
+// One step in a fork child. No exec follows, so exec-time effects happen
+// here instead: CLOSE_EXCEPT closes rather than marking close-on-exec.
+// SIGNAL_MASK still only records the mask; swift_fork_prepared installs it
+// after the last step.
+static inline int swift_fork_run_step(const swift_spawn_step *step, sigset_t *mask) {
+    if (step->kind == SWIFT_STEP_CLOSE_EXCEPT) {
+        return swift_close_except((const int32_t *)step->pointer, step->first, 0);
+    }
+    return swift_vfork_run_step(step, mask);
+}
+
+// Applies `regions` in order, forks, and runs `steps` in the child with
+// swift_fork_run_step, then installs the step list's mask. The child _exits
+// with 127 if a step fails.
+// Returns the child PID in the parent, 0 in the child, or -1 with errno set
+// (the failing region's index in *failed; -1 if fork itself failed).
+static inline pid_t swift_fork_prepared(
+    const swift_fork_region *regions,
+    int count,
+    const swift_spawn_step *steps,
+    int step_count,
+    int *failed
+) {
+    for (int i = 0; i < count; i++) {
+        if (swift_fork_region_apply(&regions[i]) != 0) {
+            *failed = i;
+            return -1;
+        }
+    }
+
+    pid_t pid = fork();
+    if (pid != 0) {
+        *failed = -1;
+        return pid;
+    }
+
+    sigset_t mask;
+    pthread_sigmask(SIG_SETMASK, NULL, &mask);
+    for (int i = 0; i < step_count; i++) {
+        if (swift_fork_run_step(&steps[i], &mask) != 0) {
+            _exit(127);
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &mask, NULL);
+    return 0;
+}
+
+// Process tree - direct children of a process, for descendant snapshots.
+
+#if defined(__linux__)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+
+// Parses whitespace-separated PIDs from `text`, appending to `out` while
+// there is room. Returns the number parsed, including any that did not fit.
+static inline int swift_pids_parse(const char *text, size_t length, pid_t *out, int capacity, int count) {
+    pid_t value = 0;
+    int digits = 0;
+    for (size_t i = 0; i <= length; i++) {
+        char c = i < length ? text[i] : ' ';
+        if (c >= '0' && c <= '9') {
+            value = value * 10 + (c - '0');
+            digits = 1;
+        } else if (digits) {
+            if (count < capacity) {
+                out[count] = value;
+            }
+            count++;
+            value = 0;
+            digits = 0;
+        }
+    }
+    return count;
+}
+
+// Fallback without CONFIG_PROC_CHILDREN: every /proc/<pid>/stat whose ppid
+// (the field after the parenthesised comm) is `parent`.
+static inline int swift_process_children_scan(pid_t parent, pid_t *out, int capacity) {
+    int dir = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir < 0) {
+        return -1;
+    }
+
+    int count = 0;
+    char buffer[4096] __attribute__((aligned(8)));
+    for (;;) {
+        long n = syscall(SYS_getdents64, dir, buffer, sizeof(buffer));
+        if (n <= 0) {
+            break;
+        }
+        for (long offset = 0; offset < n;) {
+            unsigned short length;
+            memcpy(&length, buffer + offset + 16, sizeof(length));
+            const char *name = buffer + offset + 19;
+            offset += length;
+            if (name[0] < '0' || name[0] > '9') {
+                continue;
+            }
+
+            char path[64];
+            snprintf(path, sizeof(path), "/proc/%s/stat", name);
+            int fd = open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                continue;
+            }
+            char stat[512];
+            ssize_t size = read(fd, stat, sizeof(stat) - 1);
+            close(fd);
+            if (size <= 0) {
+                continue;
+            }
+            stat[size] = 0;
+
+            const char *close_paren = strrchr(stat, ')');
+            if (close_paren == NULL || close_paren[1] == 0 || close_paren[2] == 0) {
+                continue;
+            }
+            // ") S 1234 ..."
+            if (atoi(close_paren + 4) == parent) {
+                if (count < capacity) {
+                    out[count] = (pid_t)atoi(name);
+                }
+                count++;
+            }
+        }
+    }
+
+    close(dir);
+    return count;
+}
+
+// Direct children of `pid`, from /proc/<pid>/task/<tid>/children (3.5+, one
+// file per thread). Writes up to `capacity` and returns the total found, so
+// a result above `capacity` means truncation. -1 with ESRCH if `pid` is gone.
+static inline int swift_process_children(pid_t pid, pid_t *out, int capacity) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/task", (int)pid);
+    int dir = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir < 0) {
+        if (errno == ENOENT) {
+            errno = ESRCH;
+        }
+        return -1;
+    }
+
+    int count = 0;
+    char buffer[4096] __attribute__((aligned(8)));
+    for (;;) {
+        long n = syscall(SYS_getdents64, dir, buffer, sizeof(buffer));
+        if (n <= 0) {
+            break;
+        }
+        for (long offset = 0; offset < n;) {
+            unsigned short length;
+            memcpy(&length, buffer + offset + 16, sizeof(length));
+            const char *name = buffer + offset + 19;
+            offset += length;
+            if (name[0] < '0' || name[0] > '9') {
+                continue;
+            }
+
+            char file[96];
+            snprintf(file, sizeof(file), "/proc/%d/task/%s/children", (int)pid, name);
+            int fd = open(file, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                if (errno == ENOENT && count == 0) {
+                    // Thread exited, or the kernel lacks CONFIG_PROC_CHILDREN
+                    struct stat info;
+                    if (fstatat(dir, name, &info, 0) == 0) {
+                        close(dir);
+                        return swift_process_children_scan(pid, out, capacity);
+                    }
+                }
+                continue;
+            }
+
+            // PIDs may straddle reads; carry the partial token over
+            char text[1024];
+            size_t kept = 0;
+            for (;;) {
+                ssize_t got = read(fd, text + kept, sizeof(text) - kept);
+                if (got < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (got <= 0) {
+                    count = swift_pids_parse(text, kept, out, capacity, count);
+                    break;
+                }
+                size_t total = kept + (size_t)got;
+                size_t last = total;
+                while (last > 0 && text[last - 1] != ' ') {
+                    last--;
+                }
+                count = swift_pids_parse(text, last, out, capacity, count);
+                kept = total - last;
+                memmove(text, text + last, kept);
+            }
+            close(fd);
+        }
+    }
+
+    close(dir);
+    return count;
+}
+
+// prctl(PR_SET_CHILD_SUBREAPER) (3.4+). Returns 0 or -1 with errno.
+static inline int swift_subreaper_set(int enabled) {
+    return prctl(PR_SET_CHILD_SUBREAPER, (unsigned long)(enabled != 0), 0, 0, 0);
+}
+
+// prctl(PR_GET_CHILD_SUBREAPER). Returns 1, 0, or -1 with errno.
+static inline int swift_subreaper_get(void) {
+    int enabled = 0;
+    if (prctl(PR_GET_CHILD_SUBREAPER, (unsigned long)&enabled, 0, 0, 0) != 0) {
+        return -1;
+    }
+    return enabled != 0;
+}
+
+#endif /* __linux__ */
+
+#if defined(__APPLE__)
+
+#include <libproc.h>
+
+// Direct children of `pid` (proc_listchildpids). Same contract as Linux:
+// a result above `capacity` means truncation; -1 with ESRCH if `pid` is gone.
+static inline int swift_process_children(pid_t pid, pid_t *out, int capacity) {
+    int count = proc_listchildpids(pid, out, capacity * (int)sizeof(pid_t));
+    if (count < 0) {
+        return -1;
+    }
+    if (count == 0 && kill(pid, 0) == -1 && errno == ESRCH) {
+        return -1;
+    }
+    return count >= capacity ? capacity + 1 : count;
+}
+
+#endif /* __APPLE__ */
+
+// io_uring - a minimal ring without liburing. The kernel structures are
+// spelled out here (ABI-stable since 5.1) so that headers predating newer
+// opcodes, such as IORING_OP_WAITID (6.7), still build. Single-issuer: one
+// thread queues, submits and reaps.
+
+#if defined(__linux__)
+
+#include <poll.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+#define SWIFT_IORING_OP_POLL_ADD 6
+#define SWIFT_IORING_OP_ASYNC_CANCEL 14
+#define SWIFT_IORING_OP_READ 22
+#define SWIFT_IORING_OP_SPLICE 30
+#define SWIFT_IORING_OP_WAITID 50
+
+#define SWIFT_IOSQE_IO_LINK (1U << 2)
+#define SWIFT_IORING_ENTER_GETEVENTS 1U
+#define SWIFT_IORING_ASYNC_CANCEL_ANY (1U << 2)
+#define SWIFT_IORING_FEAT_SINGLE_MMAP 1U
+
+typedef struct {
+    uint8_t opcode;
+    uint8_t flags;
+    uint16_t ioprio;
+    int32_t fd;
+    uint64_t off;       // also addr2
+    uint64_t addr;      // also splice_off_in
+    uint32_t len;
+    uint32_t op_flags;  // poll32_events, splice_flags, waitid_flags
+    uint64_t user_data;
+    uint16_t buf_index;
+    uint16_t personality;
+    int32_t splice_fd_in;  // also file_index
+    uint64_t addr3;
+    uint64_t pad;
+} swift_uring_sqe;
+
+typedef struct {
+    uint64_t user_data;
+    int32_t res;
+    uint32_t flags;
+} swift_uring_cqe;
+
+typedef struct {
+    uint32_t sq_entries, cq_entries, flags, sq_thread_cpu, sq_thread_idle, features, wq_fd, resv[3];
+    uint32_t sq_head, sq_tail, sq_ring_mask, sq_ring_entries, sq_flags, sq_dropped, sq_array, sq_resv1;
+    uint64_t sq_user_addr;
+    uint32_t cq_head, cq_tail, cq_ring_mask, cq_ring_entries, cq_overflow, cq_cqes, cq_flags, cq_resv1;
+    uint64_t cq_user_addr;
+} swift_uring_params;
+
+typedef struct {
+    int fd;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_array;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    swift_uring_sqe *sqes;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    swift_uring_cqe *cqes;
+    void *sq_map;
+    size_t sq_map_size;
+    void *cq_map;
+    size_t cq_map_size;
+    size_t sqes_size;
+    unsigned pending;  // queued, not yet submitted
+} swift_uring;
+
+static inline int swift_uring_open(swift_uring *ring, unsigned entries) {
+    swift_uring_params params;
+    memset(&params, 0, sizeof(params));
+    memset(ring, 0, sizeof(*ring));
+
+    int fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0) {
+        return -1;
+    }
+
+    size_t sq_size = params.sq_array + params.sq_entries * sizeof(unsigned);
+    size_t cq_size = params.cq_cqes + params.cq_entries * sizeof(swift_uring_cqe);
+    int single = (params.features & SWIFT_IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single && cq_size > sq_size) {
+        sq_size = cq_size;
+    }
+
+    void *sq = mmap(NULL, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if (sq == MAP_FAILED) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+    void *cq = sq;
+    if (!single) {
+        cq = mmap(NULL, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0x8000000ULL);
+        if (cq == MAP_FAILED) {
+            int saved = errno;
+            munmap(sq, sq_size);
+            close(fd);
+            errno = saved;
+            return -1;
+        }
+    }
+    size_t sqes_size = params.sq_entries * sizeof(swift_uring_sqe);
+    void *sqes = mmap(NULL, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0x10000000ULL);
+    if (sqes == MAP_FAILED) {
+        int saved = errno;
+        if (cq != sq) {
+            munmap(cq, cq_size);
+        }
+        munmap(sq, sq_size);
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+
+    ring->fd = fd;
+    ring->sq_head = (unsigned *)((char *)sq + params.sq_head);
+    ring->sq_tail = (unsigned *)((char *)sq + params.sq_tail);
+    ring->sq_array = (unsigned *)((char *)sq + params.sq_array);
+    ring->sq_mask = *(unsigned *)((char *)sq + params.sq_ring_mask);
+    ring->sq_entries = *(unsigned *)((char *)sq + params.sq_ring_entries);
+    ring->sqes = (swift_uring_sqe *)sqes;
+    ring->cq_head = (unsigned *)((char *)cq + params.cq_head);
+    ring->cq_tail = (unsigned *)((char *)cq + params.cq_tail);
+    ring->cq_mask = *(unsigned *)((char *)cq + params.cq_ring_mask);
+    ring->cqes = (swift_uring_cqe *)((char *)cq + params.cq_cqes);
+    ring->sq_map = sq;
+    ring->sq_map_size = sq_size;
+    ring->cq_map = cq;
+    ring->cq_map_size = cq != sq ? cq_size : 0;
+    ring->sqes_size = sqes_size;
+    return 0;
+}
+
+static inline void swift_uring_close(swift_uring *ring) {
+    munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_map_size) {
+        munmap(ring->cq_map, ring->cq_map_size);
+    }
+    munmap(ring->sq_map, ring->sq_map_size);
+    close(ring->fd);
+    ring->fd = -1;
+}
+
+// The next free SQE, zeroed and already published to the SQ ring, or NULL
+// if every entry is queued. It reaches the kernel on the next submit.
+static inline swift_uring_sqe *swift_uring_next(swift_uring *ring) {
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    unsigned tail = *ring->sq_tail;
+    if (tail - head >= ring->sq_entries) {
+        return NULL;
+    }
+    unsigned index = tail & ring->sq_mask;
+    swift_uring_sqe *sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->pending++;
+    return sqe;
+}
+
+// Number of SQEs that can still be queued.
+static inline unsigned swift_uring_space(const swift_uring *ring) {
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    return ring->sq_entries - (*ring->sq_tail - head);
+}
+
+// One io_uring_enter: submits every queued SQE and, if `wait` > 0, blocks
+// until that many completions are available. Returns SQEs consumed or -1.
+static inline int swift_uring_submit(swift_uring *ring, unsigned wait) {
+    int consumed = (int)syscall(
+        __NR_io_uring_enter, ring->fd, ring->pending, wait,
+        wait ? SWIFT_IORING_ENTER_GETEVENTS : 0U, NULL, 0);
+    if (consumed < 0) {
+        return -1;
+    }
+    ring->pending -= (unsigned)consumed;
+    return consumed;
+}
+
+// Copies up to `capacity` completions out of the CQ ring. Never blocks.
+static inline int swift_uring_reap(swift_uring *ring, swift_uring_cqe *out, int capacity) {
+    unsigned head = *ring->cq_head;
+    unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    int count = 0;
+    while (head != tail && count < capacity) {
+        out[count++] = ring->cqes[head & ring->cq_mask];
+        head++;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    return count;
+}
+
+// waitid(P_PIDFD, pidfd, info, WEXITED) - 6.7+.
+static inline void swift_uring_prep_waitid(swift_uring_sqe *sqe, int pidfd, siginfo_t *info, uint64_t data) {
+    memset(info, 0, sizeof(*info));
+    sqe->opcode = SWIFT_IORING_OP_WAITID;
+    sqe->fd = pidfd;
+    sqe->len = 3;  // P_PIDFD
+    sqe->splice_fd_in = WEXITED;
+    sqe->off = (uint64_t)(uintptr_t)info;
+    sqe->user_data = data;
+}
+
+// The PID a completed waitid reported, with its siginfo re-encoded into
+// `status` as a waitpid(2) status word.
+static inline pid_t swift_uring_waitid_result(const siginfo_t *info, int *status) {
+    *status = swift_wait_status_from_siginfo(info);
+    return info->si_pid;
+}
+
+// One-shot POLLIN on `fd`; `link` chains the next SQE behind it.
+static inline void swift_uring_prep_poll(swift_uring_sqe *sqe, int fd, int link, uint64_t data) {
+    sqe->opcode = SWIFT_IORING_OP_POLL_ADD;
+    sqe->flags = link ? SWIFT_IOSQE_IO_LINK : 0;
+    sqe->fd = fd;
+    sqe->op_flags = POLLIN;
+    sqe->user_data = data;
+}
+
+// read(fd, buffer, length) at the current position.
+static inline void swift_uring_prep_read(swift_uring_sqe *sqe, int fd, void *buffer, unsigned length, uint64_t data) {
+    sqe->opcode = SWIFT_IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->off = (uint64_t)-1;
+    sqe->addr = (uint64_t)(uintptr_t)buffer;
+    sqe->len = length;
+    sqe->user_data = data;
+}
+
+// splice(in, NULL, out, NULL, length, flags).
+static inline void swift_uring_prep_splice(
+    swift_uring_sqe *sqe, int in, int out, unsigned length, unsigned flags, uint64_t data
+) {
+    sqe->opcode = SWIFT_IORING_OP_SPLICE;
+    sqe->fd = out;
+    sqe->off = (uint64_t)-1;
+    sqe->addr = (uint64_t)-1;
+    sqe->len = length;
+    sqe->op_flags = flags;
+    sqe->splice_fd_in = in;
+    sqe->user_data = data;
+}
+
+// Cancels every in-flight request on the ring (5.19+). The cancel completes
+// with the number cancelled; each cancelled request completes -ECANCELED.
+static inline void swift_uring_prep_cancel_all(swift_uring_sqe *sqe, uint64_t data) {
+    sqe->opcode = SWIFT_IORING_OP_ASYNC_CANCEL;
+    sqe->op_flags = SWIFT_IORING_ASYNC_CANCEL_ANY;
+    sqe->user_data = data;
+}
+
+#endif /* __linux__ */
+
+// Poller - one epoll (Linux) or kqueue (Darwin) instance reporting read
+// readiness of registered descriptors as 64-bit tokens, for
+// POSIX.Kernel.Process.Supervisor. Process handles on Darwin are kqueues
+// themselves; a kqueue is readable while it has pending events.
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#else
+#include <sys/event.h>
+#endif
+
+#define SWIFT_POLLER_BATCH 256
+
+// Returns a close-on-exec poller, or -1 with errno set.
+static inline int swift_poller_open(void) {
+#if defined(__linux__)
+    return epoll_create1(EPOLL_CLOEXEC);
+#else
+    int kq = kqueue();
+    if (kq >= 0 && fcntl(kq, F_SETFD, FD_CLOEXEC) != 0) {
+        int saved = errno;
+        close(kq);
+        errno = saved;
+        return -1;
+    }
+    return kq;
+#endif
+}
+
+// Watches `fd` for readability. Level-triggered, so unread readiness is
+// reported again. Closing `fd` removes it.
+static inline int swift_poller_add(int poller, int fd, uint64_t token) {
+#if defined(__linux__)
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = token;
+    return epoll_ctl(poller, EPOLL_CTL_ADD, fd, &event);
+#else
+    struct kevent change;
+    EV_SET(&change, (uintptr_t)fd, EVFILT_READ, EV_ADD, 0, 0, (void *)(uintptr_t)token);
+    return kevent(poller, &change, 1, NULL, 0, NULL);
+#endif
+}
+
+// Waits up to `timeout` ms (-1: forever) and writes the tokens of ready
+// descriptors. Returns how many (0 on timeout or EINTR), or -1 with errno.
+static inline int swift_poller_wait(int poller, uint64_t *tokens, int capacity, int timeout) {
+    if (capacity > SWIFT_POLLER_BATCH) {
+        capacity = SWIFT_POLLER_BATCH;
+    }
+#if defined(__linux__)
+    struct epoll_event events[SWIFT_POLLER_BATCH];
+    int n = epoll_wait(poller, events, capacity, timeout);
+    for (int i = 0; i < n; i++) {
+        tokens[i] = events[i].data.u64;
+    }
+#else
+    struct kevent events[SWIFT_POLLER_BATCH];
+    struct timespec limit = { timeout / 1000, (long)(timeout % 1000) * 1000000L };
+    int n = kevent(poller, NULL, 0, events, capacity, timeout < 0 ? NULL : &limit);
+    for (int i = 0; i < n; i++) {
+        tokens[i] = (uint64_t)(uintptr_t)events[i].udata;
+    }
+#endif
+    if (n < 0 && errno == EINTR) {
+        return 0;
+    }
+    return n;
+}
+
 #endif /* __APPLE__ || __linux__ */
 
 #endif /* CPOSIX_PROCESS_SHIM_H */
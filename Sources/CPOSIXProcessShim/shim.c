@@ -1,3 +1,19 @@
-// Empty implementation file for CPOSIXProcessShim
-// All functionality is in the header as inline functions.
-// This file exists only to satisfy build systems that require compilable sources.
+// Implementation file for CPOSIXProcessShim
+// Almost all functionality is in the header as inline functions. The
+// exceptions below need a single definition across every translation unit.
+
+#include "shim.h"
+
+#if defined(__APPLE__) || defined(__linux__)
+
+swift_signal_scope *swift_signal_scope_current(void) {
+    static _Thread_local swift_signal_scope scope;
+    return &scope;
+}
+
+void **swift_trace_slot(void) {
+    static _Thread_local void *slot;
+    return &slot;
+}
+
+#endif
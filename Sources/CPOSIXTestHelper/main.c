@@ -33,6 +33,23 @@
 /// - `become-group-leader` - setpgid(0,0)
 /// - `setpgid-explicit` - setpgid(pid, pid)
 /// - `fork-exit <code>` - fork child that exits with code
+/// - `fd-open <fd>...` - exit 0 if every fd is open, else exit 1 naming the first closed fd
+/// - `nice-is <n>` - exit 0 if the nice value is n, else 1
+/// - `nofile-is <n>` - exit 0 if the RLIMIT_NOFILE soft limit is n, else 1
+/// - `cgroup-is <path>` - exit 0 if the cgroup v2 path ("0::" line) is path, else 1
+///
+/// ### Load Generation
+///
+/// - `fork-tree <depth> <width>` - every node forks width children, depth levels deep
+/// - `hold-tree <depth> <width>` - like fork-tree, but every node stays alive until killed
+///   and each leaf calls setsid(), escaping the root's group and session
+/// - `echo` - copy stdin to stdout until EOF, then report bytes and lines
+/// - `hold-fds <m>` - open m descriptors on /dev/null, then hold them until stdin EOF
+/// - `touch-mb <x>` - allocate x MiB and write every page, so rusage peaks at >= x MiB
+/// - `sigchld-storm <n> [pid]` - send n SIGCHLD to pid (default: the parent)
+///
+/// Report lines stay in the KV format. `echo` writes its report after the
+/// copied data, so a driver parses the last line.
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -40,8 +57,66 @@
 #include <unistd.h>
 #include <signal.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/resource.h>
 #include <sys/wait.h>
 
+/// Forks `width` children per node, `depth` levels deep, and reaps them.
+///
+/// Returns the number of nodes below this one that failed (fork error or
+/// non-zero exit). Children report their subtree's count as the exit code,
+/// capped at 255.
+static int fork_tree(int depth, int width) {
+    if (depth <= 0) {
+        return 0;
+    }
+    int failed = 0;
+    for (int i = 0; i < width; i++) {
+        pid_t child = fork();
+        if (child < 0) {
+            failed++;
+            continue;
+        }
+        if (child == 0) {
+            int below = fork_tree(depth - 1, width);
+            _exit(below > 255 ? 255 : below);
+        }
+    }
+    int status;
+    while (wait(&status) > 0) {
+        if (!WIFEXITED(status)) {
+            failed++;
+        } else {
+            failed += WEXITSTATUS(status);
+        }
+    }
+    return failed;
+}
+
+/// Forks `width` children per node, `depth` levels deep, and never returns.
+///
+/// Leaves leave the session; every node then sleeps until a signal kills it.
+__attribute__((noreturn)) static void hold_tree(int depth, int width) {
+    // A forked child restarts the loop one level down
+    for (;;) {
+        if (depth <= 0) {
+            setsid();
+            break;
+        }
+        int forked = 0;
+        for (int i = 0; i < width && !forked; i++) {
+            forked = fork() == 0;
+        }
+        if (!forked) {
+            break;
+        }
+        depth--;
+    }
+    for (;;) {
+        pause();
+    }
+}
+
 /// Prints status line with process info to stdout.
 static void print_status(const char *status, int exit_code) {
     pid_t pid = getpid();
@@ -71,6 +146,16 @@ int main(int argc, char *argv[]) {
         fprintf(stderr, "  become-group-leader   setpgid(0,0)\n");
         fprintf(stderr, "  setpgid-explicit      setpgid(pid, pid)\n");
         fprintf(stderr, "  fork-exit <code>      Fork child that exits\n");
+        fprintf(stderr, "  fd-open <fd>...       Exit 0 if all fds are open\n");
+        fprintf(stderr, "  nice-is <n>           Exit 0 if the nice value is n\n");
+        fprintf(stderr, "  nofile-is <n>         Exit 0 if RLIMIT_NOFILE soft limit is n\n");
+        fprintf(stderr, "  cgroup-is <path>      Exit 0 if the cgroup v2 path is path\n");
+        fprintf(stderr, "  fork-tree <d> <w>     Fork a tree w wide and d deep\n");
+        fprintf(stderr, "  hold-tree <d> <w>     Fork a tree and hold it until killed\n");
+        fprintf(stderr, "  echo                  Copy stdin to stdout until EOF\n");
+        fprintf(stderr, "  hold-fds <m>          Hold m open fds until stdin EOF\n");
+        fprintf(stderr, "  touch-mb <x>          Allocate and touch x MiB\n");
+        fprintf(stderr, "  sigchld-storm <n>     Send n SIGCHLD to the parent\n");
         return 1;
     }
 
@@ -217,6 +302,201 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
+    // fd-open <fd>... - Exit 0 if every fd is open, else 1 with the first
+    // closed fd in the KV line (the fd itself could be 0, or wrap at 256)
+    if (strcmp(cmd, "fd-open") == 0) {
+        for (int i = 2; i < argc; i++) {
+            int fd = atoi(argv[i]);
+            if (fcntl(fd, F_GETFD) == -1) {
+                printf("ERR errno=%d msg=fd_closed fd=%d\n", errno, fd);
+                fflush(stdout);
+                return 1;
+            }
+        }
+        print_status("OK", 0);
+        return 0;
+    }
+
+    // nice-is <n> - Exit 0 if the nice value is n
+    if (strcmp(cmd, "nice-is") == 0) {
+        int expected = argc >= 3 ? atoi(argv[2]) : 0;
+        errno = 0;
+        int value = getpriority(PRIO_PROCESS, 0);
+        if (errno != 0 || value != expected) {
+            printf("ERR errno=%d msg=nice_mismatch nice=%d\n", errno, value);
+            fflush(stdout);
+            return 1;
+        }
+        print_status("OK", 0);
+        return 0;
+    }
+
+    // nofile-is <n> - Exit 0 if the RLIMIT_NOFILE soft limit is n
+    if (strcmp(cmd, "nofile-is") == 0) {
+        unsigned long long expected = argc >= 3 ? strtoull(argv[2], NULL, 10) : 0;
+        struct rlimit limit;
+        if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || (unsigned long long)limit.rlim_cur != expected) {
+            printf("ERR errno=%d msg=nofile_mismatch soft=%llu\n", errno, (unsigned long long)limit.rlim_cur);
+            fflush(stdout);
+            return 1;
+        }
+        print_status("OK", 0);
+        return 0;
+    }
+
+    // cgroup-is <path> - Exit 0 if the cgroup v2 path is path
+    if (strcmp(cmd, "cgroup-is") == 0) {
+        const char *expected = argc >= 3 ? argv[2] : "";
+        FILE *file = fopen("/proc/self/cgroup", "r");
+        char line[4096];
+        int matched = 0;
+        while (file && fgets(line, sizeof(line), file)) {
+            if (strncmp(line, "0::", 3) == 0) {
+                line[strcspn(line, "\n")] = 0;
+                matched = strcmp(line + 3, expected) == 0;
+                break;
+            }
+        }
+        if (file) {
+            fclose(file);
+        }
+        if (!matched) {
+            printf("ERR errno=0 msg=cgroup_mismatch\n");
+            fflush(stdout);
+            return 1;
+        }
+        print_status("OK", 0);
+        return 0;
+    }
+
+    // fork-tree <depth> <width> - Fork a tree of children and reap it
+    if (strcmp(cmd, "fork-tree") == 0) {
+        int depth = argc >= 3 ? atoi(argv[2]) : 1;
+        int width = argc >= 4 ? atoi(argv[3]) : 1;
+
+        long nodes = 0;
+        long level = 1;
+        for (int i = 0; i < depth; i++) {
+            level *= width;
+            nodes += level;
+        }
+
+        int failed = fork_tree(depth, width);
+        printf("%s pid=%d nodes=%ld failed=%d\n", failed == 0 ? "OK" : "ERR", getpid(), nodes, failed);
+        fflush(stdout);
+        return failed == 0 ? 0 : 1;
+    }
+
+    // hold-tree <depth> <width> - Fork a tree that lives until killed
+    if (strcmp(cmd, "hold-tree") == 0) {
+        int depth = argc >= 3 ? atoi(argv[2]) : 1;
+        int width = argc >= 4 ? atoi(argv[3]) : 1;
+        hold_tree(depth, width);
+    }
+
+    // echo - Copy stdin to stdout until EOF
+    if (strcmp(cmd, "echo") == 0) {
+        char buffer[65536];
+        long long bytes = 0;
+        long long lines = 0;
+        for (;;) {
+            ssize_t n = read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (n == 0) {
+                break;
+            }
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                print_error(errno, "read_failed");
+                return 1;
+            }
+            for (ssize_t i = 0; i < n; i++) {
+                lines += buffer[i] == '\n';
+            }
+            for (ssize_t written = 0; written < n;) {
+                ssize_t w = write(STDOUT_FILENO, buffer + written, (size_t)(n - written));
+                if (w < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    print_error(errno, "write_failed");
+                    return 1;
+                }
+                written += w;
+            }
+            bytes += n;
+        }
+        printf("OK pid=%d bytes=%lld lines=%lld\n", getpid(), bytes, lines);
+        fflush(stdout);
+        return 0;
+    }
+
+    // hold-fds <m> - Hold m open descriptors until stdin EOF
+    if (strcmp(cmd, "hold-fds") == 0) {
+        int count = argc >= 3 ? atoi(argv[2]) : 0;
+        int lowest = -1;
+        int highest = -1;
+        for (int i = 0; i < count; i++) {
+            int fd = open("/dev/null", O_RDONLY);
+            if (fd < 0) {
+                printf("ERR errno=%d msg=open_failed opened=%d\n", errno, i);
+                fflush(stdout);
+                return 1;
+            }
+            if (lowest < 0) {
+                lowest = fd;
+            }
+            highest = fd;
+        }
+        printf("OK pid=%d fds=%d lowest=%d highest=%d\n", getpid(), count, lowest, highest);
+        fflush(stdout);
+
+        char byte;
+        for (;;) {
+            ssize_t n = read(STDIN_FILENO, &byte, 1);
+            if (n == 0 || (n < 0 && errno != EINTR)) {
+                break;
+            }
+        }
+        return 0;
+    }
+
+    // touch-mb <x> - Allocate x MiB and write every page
+    if (strcmp(cmd, "touch-mb") == 0) {
+        long mb = argc >= 3 ? atol(argv[2]) : 0;
+        size_t size = (size_t)mb << 20;
+        long page = sysconf(_SC_PAGESIZE);
+        char *memory = malloc(size ? size : 1);
+        if (!memory) {
+            print_error(errno, "malloc_failed");
+            return 1;
+        }
+        for (size_t offset = 0; offset < size; offset += (size_t)page) {
+            memory[offset] = 1;
+        }
+        printf("OK pid=%d mb=%ld pages=%zu\n", getpid(), mb, size / (size_t)page);
+        fflush(stdout);
+        free(memory);
+        return 0;
+    }
+
+    // sigchld-storm <n> [pid] - Send n SIGCHLD to pid (default: the parent)
+    if (strcmp(cmd, "sigchld-storm") == 0) {
+        int count = argc >= 3 ? atoi(argv[2]) : 1;
+        pid_t target = argc >= 4 ? (pid_t)atoi(argv[3]) : getppid();
+        for (int i = 0; i < count; i++) {
+            if (kill(target, SIGCHLD) != 0) {
+                printf("ERR errno=%d msg=kill_failed sent=%d\n", errno, i);
+                fflush(stdout);
+                return 1;
+            }
+        }
+        printf("OK pid=%d target=%d sent=%d\n", getpid(), target, count);
+        fflush(stdout);
+        return 0;
+    }
+
     fprintf(stderr, "Unknown command: %s\n", cmd);
     return 1;
 }
@@ -0,0 +1,142 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+
+// MARK: - Pair
+
+extension POSIX.Kernel.Device {
+    /// A decoded device number: major and minor side by side in 8 bytes.
+    ///
+    /// Decode once with `pair` or `decode(_:into:)`, then read the fields
+    /// as often as needed; `Device.major`/`minor` redo the bit shuffles on
+    /// every access. Equality and hashing use the packed 64-bit word, so a
+    /// `Pair` is as cheap a dictionary key as the raw `dev_t`.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let pairs = POSIX.Kernel.Device.decode(rawDevices)
+    /// var files: [POSIX.Kernel.Device.Pair: Int] = [:]
+    /// for pair in pairs { files[pair, default: 0] += 1 }
+    /// ```
+    public struct Pair: Sendable {
+        /// The major device number.
+        public var major: UInt32
+
+        /// The minor device number.
+        public var minor: UInt32
+
+        @inlinable
+        public init(major: UInt32, minor: UInt32) {
+            self.major = major
+            self.minor = minor
+        }
+
+        /// Both numbers as one word: major in the low half, minor in the high.
+        @inlinable
+        public var packed: UInt64 {
+            UInt64(major) | UInt64(minor) << 32
+        }
+
+        /// Typed major device number.
+        @inlinable
+        public var typedMajor: POSIX.Kernel.Device.Major {
+            POSIX.Kernel.Device.Major(rawValue: major)
+        }
+
+        /// Typed minor device number.
+        @inlinable
+        public var typedMinor: POSIX.Kernel.Device.Minor {
+            POSIX.Kernel.Device.Minor(rawValue: minor)
+        }
+
+        /// The device ID the pair decodes.
+        @inlinable
+        public var device: POSIX.Kernel.Device {
+            POSIX.Kernel.Device(major: major, minor: minor)
+        }
+    }
+
+    /// Major and minor decoded together.
+    @inlinable
+    public var pair: Pair {
+        Pair(major: major, minor: minor)
+    }
+}
+
+// MARK: - Equatable, Hashable
+
+extension POSIX.Kernel.Device.Pair: Equatable, Hashable {
+    @inlinable
+    public static func == (lhs: Self, rhs: Self) -> Bool {
+        lhs.packed == rhs.packed
+    }
+
+    /// One `combine` of the packed word instead of one per field.
+    @inlinable
+    public func hash(into hasher: inout Hasher) {
+        hasher.combine(packed)
+    }
+}
+
+// MARK: - Batch Decoding
+
+extension POSIX.Kernel.Device {
+    /// Decodes raw device IDs (`st_dev`, `st_rdev`) into pairs.
+    ///
+    /// Runs eight IDs at a time as `SIMD8<UInt64>` lanes and stores each
+    /// result as a packed word, so the loop has no per-element branches or
+    /// calls. Agrees with `major`/`minor` for every input.
+    ///
+    /// - Parameters:
+    ///   - devices: Raw device IDs.
+    ///   - pairs: Receives one pair per ID.
+    /// - Returns: Pairs written: `min(devices.count, pairs.count)`.
+    public static func decode(
+        _ devices: UnsafeBufferPointer<UInt64>,
+        into pairs: UnsafeMutableBufferPointer<Pair>
+    ) -> Int {
+        let count = min(devices.count, pairs.count)
+        guard count > 0, let input = devices.baseAddress, let output = pairs.baseAddress else { return 0 }
+
+        var index = 0
+        #if _endian(little)
+            let source = UnsafeRawPointer(input)
+            let destination = UnsafeMutableRawPointer(output)
+            let stride = MemoryLayout<UInt64>.stride
+            while index + 8 <= count {
+                let raw = source.loadUnaligned(fromByteOffset: index * stride, as: SIMD8<UInt64>.self)
+                let major = (raw &>> 8) & 0xFFF
+                let minor = (raw & 0xFF) | ((raw &>> 12) & 0xFFF00)
+                destination.storeBytes(of: major | minor &<< 32, toByteOffset: index * stride, as: SIMD8<UInt64>.self)
+                index += 8
+            }
+        #endif
+        while index < count {
+            (output + index).initialize(to: POSIX.Kernel.Device(rawValue: input[index]).pair)
+            index += 1
+        }
+        return count
+    }
+
+    /// Decodes raw device IDs into a new array of pairs.
+    ///
+    /// - Parameter devices: Raw device IDs.
+    /// - Returns: One pair per ID, in order.
+    public static func decode(_ devices: [UInt64]) -> [Pair] {
+        devices.withUnsafeBufferPointer { input in
+            [Pair](unsafeUninitializedCapacity: input.count) { output, initialized in
+                initialized = decode(input, into: output)
+            }
+        }
+    }
+}
@@ -83,11 +83,52 @@ extension POSIX.Kernel.Device {
     }
 }
 
+// MARK: - Formatting
+
+extension POSIX.Kernel.Device {
+    /// Longest "major:minor" text: two 10-digit `UInt32`s and a colon.
+    public static let formattedCapacity = 21
+
+    /// Writes "major:minor" in ASCII into `buffer`, without allocating.
+    ///
+    /// - Parameter buffer: At least `formattedCapacity` bytes.
+    /// - Returns: Bytes written; no terminator is added.
+    public func format(into buffer: UnsafeMutableBufferPointer<UInt8>) -> Int {
+        precondition(buffer.count >= Self.formattedCapacity, "buffer shorter than formattedCapacity")
+        let pair = self.pair
+        var count = Self.digits(pair.major, into: buffer, at: 0)
+        buffer[count] = UInt8(ascii: ":")
+        count += 1
+        count += Self.digits(pair.minor, into: buffer, at: count)
+        return count
+    }
+
+    /// Writes `value` in decimal at `offset`; returns the digit count.
+    private static func digits(_ value: UInt32, into buffer: UnsafeMutableBufferPointer<UInt8>, at offset: Int) -> Int {
+        var width = 1
+        var limit: UInt32 = 10
+        while width < 10 && value >= limit {
+            width += 1
+            limit &*= 10
+        }
+
+        var remaining = value
+        for position in stride(from: offset + width - 1, through: offset, by: -1) {
+            buffer[position] = UInt8(ascii: "0") + UInt8(remaining % 10)
+            remaining /= 10
+        }
+        return width
+    }
+}
+
 // MARK: - CustomStringConvertible
 
 extension POSIX.Kernel.Device: @retroactive CustomStringConvertible {
     /// Returns "major:minor" format for POSIX device IDs.
+    ///
+    /// Formats through `format(into:)`; results up to 15 bytes are stored
+    /// inline in the `String`, so typical devices allocate nothing.
     public var description: String {
-        "\(major):\(minor)"
+        String(unsafeUninitializedCapacity: Self.formattedCapacity) { format(into: $0) }
     }
 }
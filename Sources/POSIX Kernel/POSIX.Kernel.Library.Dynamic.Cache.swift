@@ -0,0 +1,166 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if !os(Windows)
+
+    public import Kernel_Primitives
+    public import POSIX_Primitives
+    internal import Synchronization
+
+    #if canImport(Darwin)
+        internal import Darwin
+    #elseif canImport(Glibc)
+        internal import Glibc
+    #elseif canImport(Musl)
+        internal import Musl
+    #endif
+
+    extension POSIX.Kernel.Library.Dynamic {
+        /// A resolved-symbol cache for one lookup scope.
+        ///
+        /// Repeat lookups of a name are a hash probe instead of a `dlsym`
+        /// walk of the library's symbol table. Keys are the `StaticString`
+        /// names themselves, so neither a probe nor an insert copies a name.
+        /// Misses are not cached: the symbol may appear once another library
+        /// loads into `.default`.
+        ///
+        /// ## Lifetime
+        ///
+        /// Cached addresses are only as valid as the library. Call `clear()`
+        /// (or drop the cache) before `close` on a `.handle` scope.
+        ///
+        /// ## Thread Safety
+        ///
+        /// Safe for concurrent lookups. The lock is not held across `dlsym`;
+        /// a batched lookup takes it once to probe and once to insert.
+        ///
+        /// ## Usage
+        ///
+        /// ```swift
+        /// let cache = POSIX.Kernel.Library.Dynamic.Cache(.handle(plugin))
+        /// let run = try cache.symbol("plugin_run")
+        /// let resolution = cache.symbols(entryPoints, into: table)
+        /// ```
+        public final class Cache: @unchecked Sendable {
+            /// The scope every lookup searches.
+            public let scope: Scope
+
+            private let entries = Mutex<[Key: UnsafeRawPointer]>([:])
+
+            /// Creates an empty cache for `scope`.
+            public init(_ scope: Scope) {
+                self.scope = scope
+            }
+        }
+    }
+
+    // MARK: - Key
+
+    extension POSIX.Kernel.Library.Dynamic.Cache {
+        /// A name compared and hashed by its UTF-8 bytes.
+        private struct Key: Hashable, Sendable {
+            let name: StaticString
+
+            static func == (lhs: Key, rhs: Key) -> Bool {
+                lhs.name.withUTF8Buffer { left in
+                    rhs.name.withUTF8Buffer { right in
+                        left.count == right.count
+                            && (left.count == 0 || memcmp(left.baseAddress!, right.baseAddress!, left.count) == 0)
+                    }
+                }
+            }
+
+            func hash(into hasher: inout Hasher) {
+                name.withUTF8Buffer { hasher.combine(bytes: UnsafeRawBufferPointer($0)) }
+            }
+        }
+    }
+
+    // MARK: - Lookup
+
+    extension POSIX.Kernel.Library.Dynamic.Cache {
+        /// Number of cached addresses.
+        public var count: Int {
+            entries.withLock { $0.count }
+        }
+
+        /// Looks up `name`, consulting the cache first.
+        ///
+        /// - Throws: `Error.symbol` with a lazy message if not found.
+        public func symbol(_ name: StaticString) throws(POSIX.Kernel.Library.Dynamic.Error) -> UnsafeRawPointer {
+            let key = Key(name: name)
+            if let cached = entries.withLock({ $0[key] }) {
+                return cached
+            }
+
+            let address = try POSIX.Kernel.Library.Dynamic.symbol(name, in: scope)
+            entries.withLock { $0[key] = address }
+            return address
+        }
+
+        /// Resolves a table of names, consulting the cache first.
+        ///
+        /// Same contract as `Dynamic.symbols(_:in:into:)`.
+        public func symbols(
+            _ names: [StaticString],
+            into results: UnsafeMutableBufferPointer<UnsafeRawPointer?>
+        ) -> POSIX.Kernel.Library.Dynamic.Resolution {
+            precondition(results.count >= names.count, "results must hold one entry per name")
+
+            var hits = 0
+            entries.withLock { entries in
+                for (index, name) in names.enumerated() {
+                    let cached = entries[Key(name: name)]
+                    results[index] = cached
+                    if cached != nil {
+                        hits += 1
+                    }
+                }
+            }
+            guard hits < names.count else {
+                return POSIX.Kernel.Library.Dynamic.Resolution(resolved: hits, missing: nil, name: nil)
+            }
+
+            let handle = scope.dlsymHandle
+            var resolved = hits
+            var missing: Int?
+            for (index, name) in names.enumerated() where results[index] == nil {
+                let address = POSIX.Kernel.Library.Dynamic.withCString(name) { dlsym(handle, $0) }
+                if let address {
+                    results[index] = UnsafeRawPointer(address)
+                    resolved += 1
+                } else if missing == nil {
+                    missing = index
+                }
+            }
+
+            entries.withLock { entries in
+                for (index, name) in names.enumerated() {
+                    if let address = results[index] {
+                        entries[Key(name: name)] = address
+                    }
+                }
+            }
+
+            return POSIX.Kernel.Library.Dynamic.Resolution(
+                resolved: resolved,
+                missing: missing,
+                name: missing.map { names[$0] }
+            )
+        }
+
+        /// Drops every cached address.
+        public func clear() {
+            entries.withLock { $0.removeAll() }
+        }
+    }
+
+#endif
@@ -27,6 +27,9 @@ extension POSIX.Kernel.Library.Dynamic {
 
         /// dlsym/GetProcAddress failed.
         case symbol(Message)
+
+        /// dlinfo failed.
+        case info(Message)
     }
 }
 
@@ -35,21 +38,110 @@ extension POSIX.Kernel.Library.Dynamic {
     ///
     /// Always contains a human-readable `text` (never empty).
     /// On Windows, also captures the error `code` for programmatic use.
-    public struct Message: Sendable, Equatable, Hashable {
-        /// Human-readable error text.
-        /// Always non-empty (worst case: "unknown error" or formatted code).
-        public let text: String
+    ///
+    /// ## Lazy Text
+    ///
+    /// Misses from `symbols(_:in:into:)` and `Cache` carry only the missing
+    /// `StaticString` name, and Windows failures only the error code; `text`
+    /// is formatted on first access, so neither allocates unless the message
+    /// is read. `dlerror` text is copied at capture: the C library reuses
+    /// its buffer on the next `dl*` call.
+    public struct Message: Sendable {
+        @usableFromInline
+        internal enum Storage: Sendable {
+            /// Text captured from dlerror/FormatMessage.
+            case text(String)
+
+            /// A symbol that was not found; text is derived on demand.
+            case missing(StaticString)
+
+            /// Only `code` was captured; text is derived on demand.
+            case code
+        }
+
+        @usableFromInline
+        internal let storage: Storage
 
-        /// Platform error code (Windows only).
-        /// - POSIX: Always `nil` (dlerror returns string, not errno)
+        /// Platform error code, when one was captured.
+        ///
+        /// - POSIX: `nil` for dlerror text and missing symbols (dlerror
+        ///   returns a string, not errno); set for `init(code:)`.
         /// - Windows: Always set
         public let code: Kernel.Error.Code?
 
         @inlinable
         public init(_ text: String, code: Kernel.Error.Code? = nil) {
-            self.text = text
+            self.storage = .text(text)
             self.code = code
         }
+
+        /// A message for a symbol that was not found, formatted lazily.
+        @inlinable
+        public init(missing name: StaticString) {
+            self.storage = .missing(name)
+            self.code = nil
+        }
+
+        /// A message carrying only a platform error code, formatted lazily.
+        @inlinable
+        public init(code: Kernel.Error.Code) {
+            self.storage = .code
+            self.code = code
+        }
+
+        /// Human-readable error text.
+        /// Always non-empty (worst case: "unknown error" or formatted code).
+        public var text: String {
+            switch storage {
+            case .text(let text):
+                return text
+            case .missing(let name):
+                return "undefined symbol: \(name)"
+            case .code:
+                guard let code else { return "unknown error" }
+                #if os(Windows)
+                    if let win32 = code.win32 {
+                        return "Windows error \(win32)"
+                    }
+                #endif
+                return "error \(code)"
+            }
+        }
+    }
+}
+
+// Equality and hashing use the stored form, so comparing lazy messages
+// never formats `text`. A `.missing` message therefore differs from
+// captured text that happens to read the same.
+extension POSIX.Kernel.Library.Dynamic.Message: Equatable, Hashable {
+    public static func == (lhs: Self, rhs: Self) -> Bool {
+        guard lhs.code == rhs.code else { return false }
+        switch (lhs.storage, rhs.storage) {
+        case (.text(let a), .text(let b)):
+            return a == b
+        case (.missing(let a), .missing(let b)):
+            return a.withUTF8Buffer { a in
+                b.withUTF8Buffer { b in a.elementsEqual(b) }
+            }
+        case (.code, .code):
+            return true
+        default:
+            return false
+        }
+    }
+
+    public func hash(into hasher: inout Hasher) {
+        switch storage {
+        case .text(let text):
+            hasher.combine(0 as UInt8)
+            hasher.combine(text)
+        case .missing(let name):
+            hasher.combine(1 as UInt8)
+            name.withUTF8Buffer { hasher.combine(bytes: UnsafeRawBufferPointer($0)) }
+        case .code:
+            hasher.combine(2 as UInt8)
+        }
+        hasher.combine(code)
     }
 }
 
@@ -64,6 +156,8 @@ extension POSIX.Kernel.Library.Dynamic.Error: CustomStringConvertible {
             return "library close failed: \(msg.text)"
         case .symbol(let msg):
             return "symbol lookup failed: \(msg.text)"
+        case .info(let msg):
+            return "library info query failed: \(msg.text)"
         }
     }
 }
@@ -0,0 +1,105 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-kernel open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-kernel project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if canImport(Glibc)
+
+    public import Kernel_Primitives
+    public import POSIX_Primitives
+    internal import Glibc
+    internal import CPOSIXProcessShim
+
+    extension POSIX.Kernel.Library.Dynamic {
+        /// A link-map namespace (glibc `Lmid_t`).
+        ///
+        /// Each namespace has its own copy of every library loaded into it,
+        /// including its own globals and relocations. Loading a new version
+        /// of a plugin into a fresh namespace leaves the current one running
+        /// and warm; switching over is a pointer swap, not a reload.
+        ///
+        /// glibc supports at most 16 namespaces per process, including `.base`.
+        ///
+        /// ## Usage
+        ///
+        /// ```swift
+        /// let next = try path.withCString { path in
+        ///     try POSIX.Kernel.Library.Dynamic.open(path: path, namespace: nil)
+        /// }
+        /// let run = try POSIX.Kernel.Library.Dynamic.symbol("plugin_run", in: .handle(next))
+        /// // publish `run`, drain callers of the old copy, then close it
+        /// ```
+        public struct Namespace: RawRepresentable, Sendable, Hashable {
+            public let rawValue: Int
+
+            @inlinable
+            public init(rawValue: Int) {
+                self.rawValue = rawValue
+            }
+
+            /// The initial namespace, holding the executable and its
+            /// dependencies (LM_ID_BASE).
+            public static let base = Self(rawValue: Int(SWIFT_LM_ID_BASE))
+        }
+    }
+
+    // MARK: - Open
+
+    extension POSIX.Kernel.Library.Dynamic {
+        /// Opens a library into a link-map namespace (dlmopen).
+        ///
+        /// - Parameters:
+        ///   - path: Path to the library.
+        ///   - options: Loading options. `.global` is not supported for a new namespace.
+        ///   - namespace: Target namespace, or `nil` to create a new one
+        ///     (LM_ID_NEWLM). Read it back with `Handle.namespace`.
+        /// - Returns: Handle to the loaded library.
+        /// - Throws: `Error.open` with dlerror message.
+        public static func open(
+            path: UnsafePointer<CChar>,
+            options: Options = .now,
+            namespace: Namespace?
+        ) throws(Error) -> Handle {
+            _ = dlerror()
+
+            let target = namespace?.rawValue ?? Int(SWIFT_LM_ID_NEWLM)
+            guard let handle = swift_dlmopen(target, path, options.rawValue) else {
+                throw .open(captureError())
+            }
+            return Handle(rawValue: handle)
+        }
+
+        /// The namespace a handle was loaded into (dlinfo RTLD_DI_LMID).
+        ///
+        /// - Throws: `Error.info` with dlerror message.
+        public static func namespace(of handle: Handle) throws(Error) -> Namespace {
+            _ = dlerror()
+
+            var namespace = 0
+            guard swift_dlinfo_lmid(handle.rawValue, &namespace) == 0 else {
+                throw .info(captureError())
+            }
+            return Namespace(rawValue: namespace)
+        }
+    }
+
+    // MARK: - Handle
+
+    extension POSIX.Kernel.Library.Dynamic.Handle {
+        /// The namespace this library was loaded into.
+        ///
+        /// - Throws: `Error.info` if the handle is not valid.
+        public var namespace: POSIX.Kernel.Library.Dynamic.Namespace {
+            get throws(POSIX.Kernel.Library.Dynamic.Error) {
+                try POSIX.Kernel.Library.Dynamic.namespace(of: self)
+            }
+        }
+    }
+
+#endif
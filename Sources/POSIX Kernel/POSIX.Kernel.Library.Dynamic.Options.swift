@@ -66,23 +66,32 @@ extension POSIX.Kernel.Library.Dynamic {
 
 #endif
 
-// MARK: - Darwin-Only Options
+// MARK: - Residency Options (POSIX only)
 
-#if canImport(Darwin)
+#if canImport(Darwin) || canImport(Glibc) || canImport(Musl)
 
     extension POSIX.Kernel.Library.Dynamic.Options {
-        /// Don't load, just check if loadable (RTLD_NOLOAD).
+        /// Don't load, just check if loaded (RTLD_NOLOAD).
         ///
         /// Returns the handle if the library is already loaded,
-        /// or fails without loading. Useful for probing.
+        /// or fails without loading. Useful for probing; see `resident(path:options:)`.
         public static let noLoad = Self(rawValue: RTLD_NOLOAD)
 
         /// Don't delete on close (RTLD_NODELETE).
         ///
         /// Keeps the library in memory even after `close`.
         /// The library's static destructors will not run.
+        /// Combined with `.noLoad`, pins a library that is already loaded.
         public static let noDelete = Self(rawValue: RTLD_NODELETE)
+    }
+
+#endif
+
+// MARK: - Darwin-Only Options
+
+#if canImport(Darwin)
 
+    extension POSIX.Kernel.Library.Dynamic.Options {
         /// Search only this library, not dependencies (RTLD_FIRST).
         ///
         /// When combined with other flags, restricts symbol lookup
@@ -91,3 +100,18 @@ extension POSIX.Kernel.Library.Dynamic {
     }
 
 #endif
+
+// MARK: - glibc-Only Options
+
+#if canImport(Glibc)
+
+    extension POSIX.Kernel.Library.Dynamic.Options {
+        /// Prefer the library's own symbols over global ones (RTLD_DEEPBIND).
+        ///
+        /// The library and its dependencies resolve against themselves
+        /// before the global scope, so a plugin keeps its bundled copy of
+        /// a symbol that the host also exports.
+        public static let deepBind = Self(rawValue: RTLD_DEEPBIND)
+    }
+
+#endif
@@ -45,6 +45,9 @@ extension POSIX.Kernel.Library.Dynamic {
     /// - **Never assume** `.default` means "stable forever"
     public enum Scope: Sendable, Equatable {
         /// Search in a specific loaded library.
+        ///
+        /// For a handle from `open(path:options:namespace:)`, the search
+        /// stays within that handle's link-map namespace.
         case handle(Handle)
 
         /// Search default library paths (RTLD_DEFAULT).
@@ -0,0 +1,144 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if !os(Windows)
+
+    public import Kernel_Primitives
+    public import POSIX_Primitives
+
+    #if canImport(Darwin)
+        internal import Darwin
+    #elseif canImport(Glibc)
+        internal import Glibc
+    #elseif canImport(Musl)
+        internal import Musl
+    #endif
+
+    // MARK: - Resolution
+
+    extension POSIX.Kernel.Library.Dynamic {
+        /// The outcome of a batched `symbols(_:in:into:)` lookup.
+        public struct Resolution: Sendable {
+            /// Names resolved to a non-NULL address.
+            public let resolved: Int
+
+            /// Index of the first name that did not resolve, or `nil`.
+            public let missing: Int?
+
+            /// The first name that did not resolve, or `nil`.
+            public let name: StaticString?
+
+            internal init(resolved: Int, missing: Int?, name: StaticString?) {
+                self.resolved = resolved
+                self.missing = missing
+                self.name = name
+            }
+
+            /// `Error.symbol` for the first miss, or `nil` if every name resolved.
+            ///
+            /// The message text is formatted only when read.
+            public var error: Error? {
+                name.map { .symbol(Message(missing: $0)) }
+            }
+        }
+    }
+
+    // MARK: - Batched Lookup
+
+    extension POSIX.Kernel.Library.Dynamic {
+        /// Resolves a table of names in one pass.
+        ///
+        /// Built for plugin hosts that bind a fixed set of entry points:
+        /// the names are `StaticString`s, so no C string is built per call,
+        /// and `dlerror` is not consulted, so a miss allocates nothing.
+        ///
+        /// - Parameters:
+        ///   - names: Symbol names, typically a `static let` table.
+        ///   - scope: Where to search.
+        ///   - results: Receives one address per name, in order; `nil` for
+        ///     names that did not resolve. Must hold at least `names.count`.
+        /// - Returns: How many names resolved and the first miss.
+        ///
+        /// A data symbol whose value is NULL is reported as missing.
+        ///
+        /// ## Usage
+        ///
+        /// ```swift
+        /// static let entryPoints: [StaticString] = ["plugin_init", "plugin_run", "plugin_fini"]
+        ///
+        /// let table = UnsafeMutableBufferPointer<UnsafeRawPointer?>.allocate(capacity: entryPoints.count)
+        /// let resolution = POSIX.Kernel.Library.Dynamic.symbols(entryPoints, in: .handle(plugin), into: table)
+        /// if let error = resolution.error { throw error }
+        /// ```
+        public static func symbols(
+            _ names: [StaticString],
+            in scope: Scope,
+            into results: UnsafeMutableBufferPointer<UnsafeRawPointer?>
+        ) -> Resolution {
+            precondition(results.count >= names.count, "results must hold one entry per name")
+
+            let handle = scope.dlsymHandle
+            var resolved = 0
+            var missing: Int?
+
+            for (index, name) in names.enumerated() {
+                let address = withCString(name) { dlsym(handle, $0) }
+                results[index] = address.map { UnsafeRawPointer($0) }
+                if address != nil {
+                    resolved += 1
+                } else if missing == nil {
+                    missing = index
+                }
+            }
+
+            return Resolution(resolved: resolved, missing: missing, name: missing.map { names[$0] })
+        }
+
+        /// Looks up one static name with a lazy error message.
+        ///
+        /// Like `symbol(name:in:)`, but a miss neither reads `dlerror` nor
+        /// allocates until the message text is requested.
+        ///
+        /// - Throws: `Error.symbol` if not found.
+        public static func symbol(
+            _ name: StaticString,
+            in scope: Scope
+        ) throws(Error) -> UnsafeRawPointer {
+            guard let address = withCString(name, { dlsym(scope.dlsymHandle, $0) }) else {
+                throw .symbol(Message(missing: name))
+            }
+            return UnsafeRawPointer(address)
+        }
+
+        /// Passes `name` to `body` as a NUL-terminated C string.
+        ///
+        /// Pointer-backed literals are used in place. Single-scalar literals
+        /// have no storage and are encoded onto the stack.
+        internal static func withCString<R>(
+            _ name: StaticString,
+            _ body: (UnsafePointer<CChar>) -> R
+        ) -> R {
+            if name.hasPointerRepresentation {
+                return name.utf8Start.withMemoryRebound(to: CChar.self, capacity: name.utf8CodeUnitCount + 1, body)
+            }
+            return name.withUTF8Buffer { utf8 in
+                withUnsafeTemporaryAllocation(of: CChar.self, capacity: utf8.count + 1) { buffer in
+                    for (index, byte) in utf8.enumerated() {
+                        buffer[index] = CChar(bitPattern: byte)
+                    }
+                    buffer[utf8.count] = 0
+                    return body(buffer.baseAddress!)
+                }
+            }
+        }
+    }
+
+#endif
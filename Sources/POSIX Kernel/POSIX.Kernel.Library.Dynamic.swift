@@ -105,15 +105,13 @@ extension POSIX.Kernel.Library {
     // MARK: - Windows Error Capture
 
     extension POSIX.Kernel.Library.Dynamic {
-        /// Captures GetLastError + FormatMessage into owned message.
+        /// Captures GetLastError as a code-only message.
         ///
         /// MUST be called immediately after a failing syscall (I1.5).
-        /// Always captures the error code; message formatting is best-effort.
+        /// Captures only the error code; the text is formatted when read.
         @usableFromInline
         internal static func captureLastError() -> Message {
-            let code = Kernel.Error.Code.captureLastError()
-            // Numeric fallback — always deterministic
-            return Message("Windows error \(code.win32!)", code: code)
+            Message(code: Kernel.Error.Code.captureLastError())
         }
     }
 
@@ -147,9 +145,37 @@ extension POSIX.Kernel.Library {
             // Clear stale error
             _ = dlerror()
 
+            let start = POSIX.Kernel.Trace.start()
             guard let handle = dlopen(path, options.rawValue) else {
                 throw .open(captureError())
             }
+            POSIX.Kernel.Trace.finish(.open, since: start)
+            return Handle(rawValue: handle)
+        }
+
+        /// Returns a handle to a library only if it is already loaded (RTLD_NOLOAD).
+        ///
+        /// Never loads or relocates anything, so it is cheap enough for a
+        /// request path: probe for a warm copy before paying for `open`.
+        ///
+        /// - Parameters:
+        ///   - path: Path or soname, as the library was opened with.
+        ///   - options: Extra options applied to the resident library.
+        ///     Pass `.noDelete` to pin it so that no `close` unloads it.
+        /// - Returns: A handle, or `nil` if the library is not loaded.
+        ///   A handle adds a reference; `close` it when done.
+        @inlinable
+        public static func resident(
+            path: UnsafePointer<CChar>,
+            options: Options = .now
+        ) -> Handle? {
+            _ = dlerror()
+
+            guard let handle = dlopen(path, options.union(.noLoad).rawValue) else {
+                // Discard the miss so it does not leak into a later dlerror
+                _ = dlerror()
+                return nil
+            }
             return Handle(rawValue: handle)
         }
 
@@ -182,7 +208,9 @@ extension POSIX.Kernel.Library {
             // Clear stale error
             _ = dlerror()
 
+            let start = POSIX.Kernel.Trace.start()
             let sym = dlsym(scope.dlsymHandle, name)
+            POSIX.Kernel.Trace.finish(.symbol, since: start)
 
             // Check for error (sym can legitimately be NULL for data symbols)
             if let errorCStr = dlerror() {
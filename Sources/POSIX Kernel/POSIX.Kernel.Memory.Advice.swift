@@ -0,0 +1,201 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Memory {
+    /// Usage hints for a range of memory (madvise).
+    ///
+    /// Advice values are exclusive; apply one at a time. Unknown advice
+    /// fails with EINVAL, so the newer Linux values degrade to an error on
+    /// older kernels rather than being ignored.
+    ///
+    /// ## Page Rounding
+    ///
+    /// madvise works on whole pages. Non-destructive advice widens the range
+    /// outward to the pages it touches. Destructive advice shrinks it inward
+    /// to the pages it fully covers, so data sharing a first or last page
+    /// with the buffer is never discarded; a buffer within one page is then
+    /// a no-op:
+    ///
+    /// | Destructive | Effect |
+    /// |-------------|--------|
+    /// | `dontNeed` | private anonymous pages read back as zero (Linux) |
+    /// | `pageOut` | pages reclaimed now (Linux) |
+    /// | `dontFork` | pages not mapped in children (Linux) |
+    /// | `wipeOnFork` | children see zero-filled pages (Linux) |
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let region = UnsafeRawBufferPointer(start: base, count: hotBytes)
+    /// try POSIX.Kernel.Memory.Advice.apply(.hugePage, to: region)
+    /// try POSIX.Kernel.Memory.Advice.apply(.populateRead, to: region)
+    /// ```
+    public struct Advice: RawRepresentable, Sendable, Hashable {
+        public let rawValue: Int32
+
+        public init(rawValue: Int32) {
+            self.rawValue = rawValue
+        }
+    }
+}
+
+// MARK: - Standard Advice
+
+extension POSIX.Kernel.Memory.Advice {
+    /// No special treatment (MADV_NORMAL).
+    public static let normal = Self(rawValue: MADV_NORMAL)
+
+    /// Expect random access; read-ahead is reduced (MADV_RANDOM).
+    public static let random = Self(rawValue: MADV_RANDOM)
+
+    /// Expect sequential access; read-ahead is increased (MADV_SEQUENTIAL).
+    public static let sequential = Self(rawValue: MADV_SEQUENTIAL)
+
+    /// Expect access soon; start reading pages in asynchronously (MADV_WILLNEED).
+    public static let willNeed = Self(rawValue: MADV_WILLNEED)
+
+    /// Not needed soon; the pages may be dropped (MADV_DONTNEED).
+    ///
+    /// On Linux, private anonymous pages read back as zero afterwards.
+    /// Destructive: applied only to whole pages inside the buffer.
+    public static let dontNeed = Self(rawValue: MADV_DONTNEED)
+}
+
+// MARK: - Linux Advice
+
+#if os(Linux)
+
+    extension POSIX.Kernel.Memory.Advice {
+        /// Back the range with transparent huge pages (MADV_HUGEPAGE).
+        ///
+        /// Fewer TLB misses on a large hot region. Takes effect when THP is
+        /// in `madvise` or `always` mode.
+        public static let hugePage = Self(rawValue: SWIFT_MADV_HUGEPAGE)
+
+        /// Never back the range with transparent huge pages (MADV_NOHUGEPAGE).
+        public static let noHugePage = Self(rawValue: SWIFT_MADV_NOHUGEPAGE)
+
+        /// Deactivate the pages; reclaim them first under pressure (MADV_COLD, Linux 5.4+).
+        public static let cold = Self(rawValue: SWIFT_MADV_COLD)
+
+        /// Reclaim the pages now (MADV_PAGEOUT, Linux 5.4+).
+        ///
+        /// Destructive: applied only to whole pages inside the buffer.
+        public static let pageOut = Self(rawValue: SWIFT_MADV_PAGEOUT)
+
+        /// Fault every page in readable, synchronously (MADV_POPULATE_READ, Linux 5.14+).
+        ///
+        /// Moves page-fault latency out of the request path. Fails with
+        /// EFAULT or ENOMEM where faulting would have raised SIGBUS or SIGSEGV.
+        public static let populateRead = Self(rawValue: SWIFT_MADV_POPULATE_READ)
+
+        /// Fault every page in writable, synchronously (MADV_POPULATE_WRITE, Linux 5.14+).
+        ///
+        /// Also breaks copy-on-write sharing up front.
+        public static let populateWrite = Self(rawValue: SWIFT_MADV_POPULATE_WRITE)
+
+        /// Leave the range out of children created by fork (MADV_DONTFORK).
+        ///
+        /// Its page tables are not copied, so fork gets faster, and the
+        /// child cannot map it (access faults). See `Fork.Preparation`.
+        public static let dontFork = Self(rawValue: SWIFT_MADV_DONTFORK)
+
+        /// Undo `dontFork` (MADV_DOFORK).
+        public static let doFork = Self(rawValue: SWIFT_MADV_DOFORK)
+
+        /// Give children created by fork a zero-filled copy (MADV_WIPEONFORK, Linux 4.14+).
+        ///
+        /// For secrets and scratch arenas the child must not inherit.
+        /// Private anonymous mappings only; EINVAL otherwise.
+        public static let wipeOnFork = Self(rawValue: SWIFT_MADV_WIPEONFORK)
+
+        /// Undo `wipeOnFork` (MADV_KEEPONFORK, Linux 4.14+).
+        public static let keepOnFork = Self(rawValue: SWIFT_MADV_KEEPONFORK)
+
+        /// Collapse the range into transparent huge pages now, synchronously
+        /// (MADV_COLLAPSE, Linux 6.1+).
+        ///
+        /// Independent of the THP sysfs mode. Anonymous and shmem mappings,
+        /// and read-only file mappings with CONFIG_READ_ONLY_THP_FOR_FS.
+        /// One page-table entry per 2 MiB instead of 512 also leaves fork
+        /// less to copy.
+        public static let collapse = Self(rawValue: SWIFT_MADV_COLLAPSE)
+    }
+
+#endif
+
+// MARK: - Error
+
+extension POSIX.Kernel.Memory.Advice {
+    /// Errors from memory advice.
+    public enum Error: Swift.Error, Sendable, Equatable, Hashable {
+        /// madvise() failed.
+        case advise(Kernel.Error.Code)
+    }
+}
+
+extension POSIX.Kernel.Memory.Advice.Error {
+    /// The underlying error code.
+    public var code: Kernel.Error.Code {
+        switch self {
+        case .advise(let c):
+            return c
+        }
+    }
+}
+
+extension POSIX.Kernel.Memory.Advice.Error: CustomStringConvertible {
+    public var description: String {
+        switch self {
+        case .advise(let code):
+            return "memory advice failed: \(code)"
+        }
+    }
+}
+
+// MARK: - Apply
+
+extension POSIX.Kernel.Memory.Advice {
+    /// Applies `advice` to the pages of `buffer` (madvise).
+    ///
+    /// - Parameters:
+    ///   - advice: The hint.
+    ///   - buffer: The range: widened to whole pages, or for destructive
+    ///     advice shrunk to them (see Page Rounding). An empty buffer is a
+    ///     no-op.
+    /// - Throws: `Error.advise` on failure.
+    ///
+    /// ## Common Errors
+    ///
+    /// - EINVAL: Advice unknown to this kernel, or not valid for the mapping
+    ///   (for example `.hugePage` on a file mapping).
+    /// - ENOMEM: Part of the range is unmapped.
+    /// - EAGAIN: A kernel resource was temporarily unavailable.
+    public static func apply(_ advice: Self, to buffer: UnsafeRawBufferPointer) throws(Error) {
+        guard swift_madvise_range(buffer.baseAddress, buffer.count, advice.rawValue) == 0 else {
+            throw .advise(POSIX.Kernel.Error.captureErrno())
+        }
+    }
+}
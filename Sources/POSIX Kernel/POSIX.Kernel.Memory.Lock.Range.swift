@@ -0,0 +1,139 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Memory.Lock {
+    /// Locking of one address range (mlock, mlock2, munlock).
+    ///
+    /// Where `All` pins the whole process, `Range` pins only a hot region,
+    /// such as an index, and leaves the rest pageable. Ranges are widened
+    /// to whole pages, so neighbouring data on the first and last page is
+    /// locked too.
+    ///
+    /// ## Limits
+    ///
+    /// Locked bytes count against RLIMIT_MEMLOCK unless the process has
+    /// CAP_IPC_LOCK. Locks do not nest: one `unlock` releases a page
+    /// however many times it was locked.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// try POSIX.Kernel.Memory.Lock.Range.lock(UnsafeRawBufferPointer(index), options: .onFault)
+    /// try POSIX.Kernel.Memory.Advice.apply(.populateRead, to: UnsafeRawBufferPointer(index))
+    /// ```
+    public enum Range {}
+}
+
+// MARK: - Error
+
+extension POSIX.Kernel.Memory.Lock.Range {
+    /// Errors from range locking.
+    public enum Error: Swift.Error, Sendable, Equatable, Hashable {
+        /// mlock()/mlock2() failed.
+        case lock(Kernel.Error.Code)
+
+        /// munlock() failed.
+        case unlock(Kernel.Error.Code)
+    }
+}
+
+extension POSIX.Kernel.Memory.Lock.Range.Error {
+    /// The underlying error code.
+    public var code: Kernel.Error.Code {
+        switch self {
+        case .lock(let c), .unlock(let c):
+            return c
+        }
+    }
+}
+
+extension POSIX.Kernel.Memory.Lock.Range.Error: CustomStringConvertible {
+    public var description: String {
+        switch self {
+        case .lock(let code):
+            return "memory range lock failed: \(code)"
+        case .unlock(let code):
+            return "memory range unlock failed: \(code)"
+        }
+    }
+}
+
+// MARK: - Options
+
+extension POSIX.Kernel.Memory.Lock.Range {
+    /// Flags for mlock2().
+    public struct Options: OptionSet, Sendable, Hashable {
+        public let rawValue: UInt32
+
+        public init(rawValue: UInt32) {
+            self.rawValue = rawValue
+        }
+
+        #if os(Linux)
+            /// Lock pages as they are faulted in, not up front (MLOCK_ONFAULT, Linux 4.4+).
+            ///
+            /// Untouched pages of a large reservation cost nothing until used;
+            /// pair with `Advice.populateRead` to prefault the hot part.
+            public static let onFault = Options(rawValue: UInt32(SWIFT_MLOCK_ONFAULT))
+        #endif
+    }
+}
+
+// MARK: - Lock
+
+extension POSIX.Kernel.Memory.Lock.Range {
+    /// Locks the pages spanning `buffer` into RAM (mlock, or mlock2 with options).
+    ///
+    /// Without `.onFault`, every page is faulted in before this returns.
+    ///
+    /// - Parameters:
+    ///   - buffer: The range to lock. An empty buffer is a no-op.
+    ///   - options: mlock2 flags. Empty uses plain mlock.
+    /// - Throws: `Error.lock` on failure.
+    ///
+    /// ## Common Errors
+    ///
+    /// - ENOMEM: Over RLIMIT_MEMLOCK, or part of the range is unmapped.
+    /// - EPERM: RLIMIT_MEMLOCK is 0 and the process lacks CAP_IPC_LOCK.
+    /// - ENOSYS/EINVAL: `.onFault` on a kernel without mlock2.
+    public static func lock(
+        _ buffer: UnsafeRawBufferPointer,
+        options: Options = []
+    ) throws(Error) {
+        guard swift_mlock_range(buffer.baseAddress, buffer.count, options.rawValue) == 0 else {
+            throw .lock(POSIX.Kernel.Error.captureErrno())
+        }
+    }
+
+    /// Unlocks the pages spanning `buffer` (munlock).
+    ///
+    /// - Parameter buffer: The range to unlock. An empty buffer is a no-op.
+    /// - Throws: `Error.unlock` on failure (ENOMEM if part of it is unmapped).
+    public static func unlock(_ buffer: UnsafeRawBufferPointer) throws(Error) {
+        guard swift_munlock_range(buffer.baseAddress, buffer.count) == 0 else {
+            throw .unlock(POSIX.Kernel.Error.captureErrno())
+        }
+    }
+}
@@ -0,0 +1,154 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(Linux)
+
+    public import Kernel_Primitives
+    public import POSIX_Primitives
+
+    #if canImport(Glibc)
+        internal import Glibc
+        internal import CPOSIXProcessShim
+    #elseif canImport(Musl)
+        internal import Musl
+        internal import CPOSIXProcessShim
+    #endif
+
+    extension POSIX.Kernel.Process {
+        /// A set of CPUs a process may run on (cpu_set_t).
+        ///
+        /// Covers CPUs 0 through `capacity - 1`, the size of glibc's
+        /// `cpu_set_t`. Use `Spawn.Attributes.affinity(_:)` to place a child
+        /// before its first instruction; `set(_:for:)` moves a process that
+        /// is already running.
+        ///
+        /// ## Usage
+        ///
+        /// ```swift
+        /// let isolated = POSIX.Kernel.Process.Affinity([2, 3])
+        /// try attributes.affinity(isolated)
+        ///
+        /// try POSIX.Kernel.Process.Affinity.set(POSIX.Kernel.Process.Affinity([0]))
+        /// ```
+        public struct Affinity: Sendable, Hashable {
+            /// Mask words; CPU `n` is bit `n % 64` of word `n / 64`.
+            internal private(set) var words: [UInt64]
+
+            /// Number of CPUs a set can describe.
+            public static let capacity = 1024
+
+            /// Creates an empty set.
+            public init() {
+                self.words = Array(repeating: 0, count: Self.capacity / 64)
+            }
+
+            /// Creates a set of `cpus`.
+            ///
+            /// - Precondition: Every CPU is in `0..<capacity`.
+            public init(_ cpus: some Sequence<Int>) {
+                self.init()
+                for cpu in cpus {
+                    insert(cpu)
+                }
+            }
+        }
+    }
+
+    // MARK: - Membership
+
+    extension POSIX.Kernel.Process.Affinity {
+        /// Whether `cpu` is in the set. CPUs outside `0..<capacity` never are.
+        public func contains(_ cpu: Int) -> Bool {
+            guard cpu >= 0, cpu < Self.capacity else { return false }
+            return words[cpu / 64] & (1 << UInt64(cpu % 64)) != 0
+        }
+
+        /// Adds `cpu`.
+        public mutating func insert(_ cpu: Int) {
+            precondition(cpu >= 0 && cpu < Self.capacity, "CPU out of range")
+            words[cpu / 64] |= 1 << UInt64(cpu % 64)
+        }
+
+        /// Removes `cpu`.
+        public mutating func remove(_ cpu: Int) {
+            guard cpu >= 0, cpu < Self.capacity else { return }
+            words[cpu / 64] &= ~(1 << UInt64(cpu % 64))
+        }
+
+        /// Number of CPUs in the set.
+        public var count: Int {
+            words.reduce(0) { $0 + $1.nonzeroBitCount }
+        }
+
+        /// Whether the set has no CPUs.
+        public var isEmpty: Bool {
+            words.allSatisfy { $0 == 0 }
+        }
+
+        /// The CPUs in the set, ascending.
+        public var cpus: [Int] {
+            var cpus: [Int] = []
+            cpus.reserveCapacity(count)
+            for (index, word) in words.enumerated() {
+                var remaining = word
+                while remaining != 0 {
+                    cpus.append(index * 64 + remaining.trailingZeroBitCount)
+                    remaining &= remaining - 1
+                }
+            }
+            return cpus
+        }
+    }
+
+    // MARK: - Get / Set
+
+    extension POSIX.Kernel.Process.Affinity {
+        /// The CPUs a process may run on (sched_getaffinity).
+        ///
+        /// - Parameter process: The process, or `nil` for the calling thread.
+        /// - Throws: `POSIX.Kernel.Process.Error.schedule` on failure (ESRCH;
+        ///   EINVAL on a machine with more than `capacity` possible CPUs).
+        public static func get(
+            _ process: Kernel.Process.ID? = nil
+        ) throws(POSIX.Kernel.Process.Error) -> Self {
+            var affinity = Self()
+            let rc = affinity.words.withUnsafeMutableBytes { bytes in
+                swift_sched_getaffinity(process?.rawValue ?? 0, bytes.count, bytes.baseAddress)
+            }
+            guard rc == 0 else {
+                throw .schedule(POSIX.Kernel.Error.captureErrno())
+            }
+            return affinity
+        }
+
+        /// Restricts a process to `affinity` (sched_setaffinity).
+        ///
+        /// Applies to one thread: `nil` is the calling thread, a process ID
+        /// is that process's main thread. Threads and children created
+        /// afterwards inherit the mask.
+        ///
+        /// - Throws: `POSIX.Kernel.Process.Error.schedule` on failure (EINVAL
+        ///   if no CPU in the set is online or allowed by the cpuset; EPERM
+        ///   for another user's process).
+        public static func set(
+            _ affinity: Self,
+            for process: Kernel.Process.ID? = nil
+        ) throws(POSIX.Kernel.Process.Error) {
+            let rc = affinity.words.withUnsafeBytes { bytes in
+                swift_sched_setaffinity(process?.rawValue ?? 0, bytes.count, bytes.baseAddress)
+            }
+            guard rc == 0 else {
+                throw .schedule(POSIX.Kernel.Error.captureErrno())
+            }
+        }
+    }
+
+#endif
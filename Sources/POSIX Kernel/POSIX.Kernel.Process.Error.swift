@@ -46,6 +46,28 @@ extension POSIX.Kernel.Process {
 
         /// posix_spawn() failed.
         case spawn(Kernel.Error.Code)
+
+        /// Process handle operation failed (pidfd_open, kqueue, close).
+        case handle(Kernel.Error.Code)
+
+        /// Zygote operation failed (start, fork request, worker channel).
+        case zygote(Kernel.Error.Code)
+
+        /// Pipe operation failed (pipe, fcntl, splice, tee, vmsplice).
+        case pipe(Kernel.Error.Code)
+
+        /// Scheduling operation failed (sched_setaffinity, sched_getaffinity).
+        case schedule(Kernel.Error.Code)
+
+        /// io_uring operation failed (io_uring_setup, io_uring_enter).
+        case ring(Kernel.Error.Code)
+
+        /// Process tree operation failed (/proc children, proc_listchildpids,
+        /// PR_SET_CHILD_SUBREAPER).
+        case tree(Kernel.Error.Code)
+
+        /// Supervisor operation failed (epoll/kqueue, wake pipe, concurrent `run`).
+        case supervisor(Kernel.Error.Code)
     }
 }
 
@@ -56,7 +78,9 @@ extension POSIX.Kernel.Process.Error {
     public var code: Kernel.Error.Code {
         switch self {
         case .fork(let c), .execute(let c), .wait(let c), .kill(let c),
-            .session(let c), .group(let c), .spawn(let c):
+            .session(let c), .group(let c), .spawn(let c), .handle(let c), .zygote(let c),
+            .pipe(let c), .schedule(let c), .ring(let c), .tree(let c),
+            .supervisor(let c):
             return c
         }
     }
@@ -127,6 +151,20 @@ extension POSIX.Kernel.Process.Error: CustomStringConvertible {
             return "process group operation failed: \(code)"
         case .spawn(let code):
             return "spawn failed: \(code)"
+        case .handle(let code):
+            return "process handle operation failed: \(code)"
+        case .zygote(let code):
+            return "zygote operation failed: \(code)"
+        case .pipe(let code):
+            return "pipe operation failed: \(code)"
+        case .schedule(let code):
+            return "scheduling operation failed: \(code)"
+        case .ring(let code):
+            return "io_uring operation failed: \(code)"
+        case .tree(let code):
+            return "process tree operation failed: \(code)"
+        case .supervisor(let code):
+            return "supervisor operation failed: \(code)"
         }
     }
 }
@@ -98,3 +98,40 @@ extension POSIX.Kernel.Process.Execute {
         throw .execute(POSIX.Kernel.Error.captureErrno())
     }
 }
+
+// MARK: - Attributes
+
+extension POSIX.Kernel.Process.Execute {
+    /// Applies spawn attributes to the current process, then replaces its image.
+    ///
+    /// The `fork` + `exec` counterpart of passing `attributes` to
+    /// `Spawn.spawn`: process group, session, signal defaults, signal mask
+    /// and the `close(except:)` policy are applied in the order they were
+    /// set, then `execve` runs.
+    ///
+    /// - Parameters:
+    ///   - path: Path to the executable (null-terminated C string).
+    ///   - argv: Argument vector (null-terminated array of C strings).
+    ///   - envp: Environment vector (null-terminated array of C strings).
+    ///   - attributes: Attributes built before `fork`.
+    /// - Throws: `POSIX.Kernel.Process.Error.execute` (only returns on failure).
+    ///
+    /// ## Fork Safety
+    ///
+    /// Performs no allocation and only async-signal-safe syscalls, so it is
+    /// usable in the child of `Fork.fork` in a multithreaded process. If
+    /// `execve` fails, attributes already applied are not undone;
+    /// descriptors outside the kept list are only marked close-on-exec.
+    public static func execve(
+        path: UnsafePointer<CChar>,
+        argv: UnsafePointer<UnsafePointer<CChar>?>,
+        envp: UnsafePointer<UnsafePointer<CChar>?>,
+        attributes: POSIX.Kernel.Process.Spawn.Attributes
+    ) throws(POSIX.Kernel.Process.Error) {
+        // swift_execve_steps only returns on failure
+        _ = withExtendedLifetime(attributes) {
+            swift_execve_steps(path, argv, envp, attributes.steps.pointer, Int32(attributes.steps.count))
+        }
+        throw .execute(POSIX.Kernel.Error.captureErrno())
+    }
+}
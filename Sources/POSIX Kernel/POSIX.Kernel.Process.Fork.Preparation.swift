@@ -0,0 +1,187 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Process.Fork {
+    /// Memory advice applied before each `fork(preparing:)`, and steps run
+    /// in the child after it.
+    ///
+    /// `fork` copies the page tables of every mapping, and the child then
+    /// takes a copy-on-write fault for each shared page it writes. Regions
+    /// the child never needs should not be copied at all:
+    ///
+    /// | Method | Child sees | Platform |
+    /// |--------|------------|----------|
+    /// | `exclude(_:)` | nothing mapped; access faults | MADV_DONTFORK (Linux), `minherit(VM_INHERIT_NONE)` (Darwin) |
+    /// | `wipe(_:)` | zero-filled pages | MADV_WIPEONFORK (Linux 4.14+) |
+    /// | `collapse(_:)` | the same data, huge-page mapped | MADV_COLLAPSE (Linux 6.1+), best effort |
+    ///
+    /// Exclude large caches the child rebuilds or never reads. Wipe
+    /// per-process secrets and scratch arenas: the child gets fresh zero
+    /// pages instead of faulting copies in. Collapse large read-only shared
+    /// regions so fork copies one entry per 2 MiB instead of 512.
+    ///
+    /// The advice stays on the mappings after the fork; reapplying it on
+    /// the next fork is cheap. Regions must stay mapped for as long as the
+    /// preparation is used.
+    ///
+    /// Advice applies to whole pages, so `exclude` and `wipe` regions must
+    /// start and end on a page boundary (`sysconf(_SC_PAGESIZE)`); an
+    /// unaligned region would take neighbouring data from the child, so
+    /// `fork(preparing:)` throws EINVAL instead. Allocate them with `mmap`
+    /// or page-aligned `posix_memalign`.
+    ///
+    /// ## After Fork
+    ///
+    /// `child` is a `Spawn.Steps` list, run by the C step interpreter in
+    /// the child before `fork(preparing:)` returns `.child`. It makes only
+    /// async-signal-safe syscalls; no Swift code runs. A child whose step
+    /// fails exits with status 127.
+    ///
+    /// No `execve` follows, so the exec-time steps take effect here:
+    ///
+    /// | Step | In `Spawn.Steps.spawn` | In `fork(preparing:)` |
+    /// |------|------------------------|-----------------------|
+    /// | `close(except:)` | marked close-on-exec | closed at once |
+    /// | `mask(_:)` | installed just before `execve` | installed after the last step |
+    ///
+    /// Since `close(except:)` closes immediately here, add it after any
+    /// step that reads a descriptor it closes.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let preparation = POSIX.Kernel.Process.Fork.Preparation()
+    /// preparation.exclude(UnsafeRawBufferPointer(cache))
+    /// preparation.wipe(UnsafeRawBufferPointer(keys))
+    /// preparation.child.close(from: Kernel.Descriptor(rawValue: 3))
+    ///
+    /// switch try POSIX.Kernel.Process.Fork.fork(preparing: preparation) {
+    /// case .child:
+    ///     POSIX.Kernel.Process.Exit.now(work())
+    /// case .parent(let child):
+    ///     watch(child)
+    /// }
+    /// ```
+    public final class Preparation: @unchecked Sendable {
+        /// Regions in registration order, as handed to `swift_fork_prepared`.
+        internal private(set) var regions: [swift_fork_region] = []
+
+        /// Steps run in the child.
+        public let child: POSIX.Kernel.Process.Spawn.Steps
+
+        /// Number of registered regions.
+        public var count: Int {
+            regions.count
+        }
+
+        /// Creates an empty preparation.
+        ///
+        /// - Parameter child: Steps for the child; an empty list by default.
+        public init(child: POSIX.Kernel.Process.Spawn.Steps = POSIX.Kernel.Process.Spawn.Steps()) {
+            self.child = child
+        }
+    }
+}
+
+// MARK: - Regions
+
+extension POSIX.Kernel.Process.Fork.Preparation {
+    /// Leaves the pages of `region` out of the child.
+    ///
+    /// Their page tables are not copied. On Darwin the region must not
+    /// hold the caller's stack or any memory the child touches.
+    ///
+    /// - Parameter region: Page-aligned start and length; otherwise
+    ///   `fork(preparing:)` throws EINVAL.
+    public func exclude(_ region: UnsafeRawBufferPointer) {
+        append(Int32(SWIFT_FORK_EXCLUDE), region)
+    }
+
+    #if os(Linux)
+        /// Gives the child zero-filled pages for `region`.
+        ///
+        /// - Parameter region: Page-aligned part of a private anonymous
+        ///   mapping; an unaligned region or another kind of mapping makes
+        ///   `fork(preparing:)` throw EINVAL.
+        public func wipe(_ region: UnsafeRawBufferPointer) {
+            append(Int32(SWIFT_FORK_WIPE), region)
+        }
+
+        /// Collapses `region` into transparent huge pages before forking.
+        ///
+        /// Best effort: a kernel without MADV_COLLAPSE, THP disabled, or a
+        /// range that cannot be collapsed still forks.
+        public func collapse(_ region: UnsafeRawBufferPointer) {
+            append(Int32(SWIFT_FORK_COLLAPSE), region)
+        }
+    #endif
+
+    private func append(_ kind: Int32, _ region: UnsafeRawBufferPointer) {
+        regions.append(swift_fork_region(kind: kind, base: region.baseAddress, length: region.count))
+    }
+}
+
+// MARK: - Fork
+
+extension POSIX.Kernel.Process.Fork {
+    /// Applies `preparation`'s advice, forks, and runs its steps in the child.
+    ///
+    /// - Parameter preparation: The regions and child steps.
+    /// - Returns: `.child` in the child, after its steps; `.parent(child:)`
+    ///   in the parent.
+    /// - Throws: `POSIX.Kernel.Process.Error.fork` if a region's advice
+    ///   fails (nothing is forked: ENOMEM for an unmapped range, EINVAL for
+    ///   an unaligned `exclude` or `wipe` region or a mapping the advice
+    ///   does not apply to) or if fork fails.
+    ///
+    /// ## Warning
+    ///
+    /// The `fork()` contract applies unchanged to whatever runs after
+    /// `.child` is returned.
+    public static func fork(preparing preparation: Preparation) throws(POSIX.Kernel.Process.Error) -> Result {
+        var failed: Int32 = 0
+        let steps = preparation.child
+        let pid = withExtendedLifetime(steps) {
+            preparation.regions.withUnsafeBufferPointer { regions in
+                swift_fork_prepared(
+                    regions.baseAddress,
+                    Int32(regions.count),
+                    steps.pointer,
+                    Int32(steps.count),
+                    &failed
+                )
+            }
+        }
+
+        switch pid {
+        case -1:
+            throw .fork(POSIX.Kernel.Error.captureErrno())
+        case 0:
+            return .child
+        default:
+            return .parent(child: Kernel.Process.ID(pid))
+        }
+    }
+}
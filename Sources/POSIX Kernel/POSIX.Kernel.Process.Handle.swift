@@ -0,0 +1,189 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Process {
+    /// A pollable reference to a child process.
+    ///
+    /// `descriptor` becomes readable when the child exits, so thousands of
+    /// children can be watched from one epoll/kqueue loop without a waiter
+    /// thread per child.
+    ///
+    /// ## Platform Mapping
+    ///
+    /// | Platform | `descriptor` | Reaped by |
+    /// |----------|--------------|-----------|
+    /// | Linux | pidfd (`pidfd_open`, 5.3+) | `waitid(P_PIDFD)` (5.4+) |
+    /// | Darwin | kqueue with `EVFILT_PROC`/`NOTE_EXIT` | `waitpid(pid)` |
+    ///
+    /// ## PID Reuse
+    ///
+    /// An unreaped child is a zombie, and a zombie's PID cannot be reused.
+    /// As long as the child is reaped only through this handle (not via a
+    /// concurrent `Wait.wait(.any)`), it always refers to the same process.
+    ///
+    /// ## Descriptor Lifecycle
+    ///
+    /// Returned by `open` or `spawn`, released by `close`. Closing does not
+    /// reap the child; reaping does not close the descriptor.
+    public struct Handle: Sendable {
+        /// The child's process ID.
+        public let pid: Kernel.Process.ID
+
+        /// The pollable descriptor (pidfd on Linux, kqueue on Darwin).
+        public let descriptor: Kernel.Descriptor
+
+        /// Creates a handle from an existing descriptor.
+        ///
+        /// The handle takes no ownership beyond the values given.
+        public init(pid: Kernel.Process.ID, descriptor: Kernel.Descriptor) {
+            self.pid = pid
+            self.descriptor = descriptor
+        }
+    }
+}
+
+// MARK: - Open / Close
+
+extension POSIX.Kernel.Process.Handle {
+    /// Opens a handle for an existing child process.
+    ///
+    /// - Parameter pid: A child of the calling process that has not been reaped.
+    /// - Returns: A handle whose descriptor is close-on-exec.
+    /// - Throws: `POSIX.Kernel.Process.Error.handle` on failure.
+    ///
+    /// ## Common Errors
+    ///
+    /// - `.noSuchProcess` (ESRCH): No process with that PID (Linux).
+    /// - ENOSYS: Kernel lacks `pidfd_open` (Linux < 5.3).
+    /// - EMFILE: Descriptor limit reached.
+    public static func open(_ pid: Kernel.Process.ID) throws(POSIX.Kernel.Process.Error) -> Self {
+        #if os(Linux)
+            let fd = swift_pidfd_open(pid.rawValue)
+        #elseif canImport(Darwin)
+            let fd = swift_process_kqueue(pid.rawValue)
+        #endif
+
+        guard fd >= 0 else {
+            throw .handle(POSIX.Kernel.Error.captureErrno())
+        }
+        return Self(pid: pid, descriptor: Kernel.Descriptor(rawValue: fd))
+    }
+
+    /// Closes the handle's descriptor.
+    ///
+    /// - Parameter handle: The handle to close. Invalid afterwards.
+    /// - Throws: `POSIX.Kernel.Process.Error.handle` on failure.
+    public static func close(_ handle: Self) throws(POSIX.Kernel.Process.Error) {
+        #if canImport(Darwin)
+            let rc = Darwin.close(handle.descriptor.rawValue)
+        #elseif canImport(Glibc)
+            let rc = Glibc.close(handle.descriptor.rawValue)
+        #elseif canImport(Musl)
+            let rc = Musl.close(handle.descriptor.rawValue)
+        #endif
+
+        guard rc == 0 else {
+            throw .handle(POSIX.Kernel.Error.captureErrno())
+        }
+    }
+}
+
+// MARK: - Spawn
+
+extension POSIX.Kernel.Process.Handle {
+    /// Spawns a child and returns a handle for it.
+    ///
+    /// Same parameters and semantics as `Spawn.spawn`. The handle is opened
+    /// before this returns, while the child cannot yet have been reaped.
+    ///
+    /// - Returns: A handle for the new child.
+    /// - Throws: `POSIX.Kernel.Process.Error.spawn` if spawning fails, or
+    ///   `.handle` if the handle cannot be opened. In the latter case the child
+    ///   is killed and reaped before the error is thrown.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let handle = try POSIX.Kernel.Process.Handle.spawn(path: path, argv: argv, envp: envp)
+    /// defer { try? POSIX.Kernel.Process.Handle.close(handle) }
+    ///
+    /// // Register handle.descriptor with epoll/kqueue; once readable:
+    /// let result = try POSIX.Kernel.Process.Wait.wait(handle)
+    /// ```
+    public static func spawn(
+        path: UnsafePointer<CChar>,
+        argv: UnsafePointer<UnsafePointer<CChar>?>,
+        envp: UnsafePointer<UnsafePointer<CChar>?>,
+        fileActions: POSIX.Kernel.Process.Spawn.FileActions? = nil,
+        attributes: POSIX.Kernel.Process.Spawn.Attributes? = nil
+    ) throws(POSIX.Kernel.Process.Error) -> Self {
+        #if os(Linux)
+            // The vfork engine spawns through clone3, which returns the
+            // pidfd atomically instead of a pidfd_open after the fact. Where
+            // clone3 is missing or blocked by seccomp (ENOSYS, EPERM) it
+            // falls back to clone, and the pidfd is opened below
+            if let attributes, attributes.stepped {
+                var pidfd: Int32 = -1
+                let start = POSIX.Kernel.Trace.start()
+                let pid = try POSIX.Kernel.Process.Spawn.spawn(
+                    path: path,
+                    argv: argv,
+                    envp: envp,
+                    fileActions: fileActions,
+                    stepping: attributes,
+                    pidfd: &pidfd
+                )
+                POSIX.Kernel.Trace.finish(.spawn, since: start, pid: pid.rawValue)
+                if pidfd >= 0 {
+                    return Self(pid: pid, descriptor: Kernel.Descriptor(rawValue: pidfd))
+                }
+                return try adopt(pid)
+            }
+        #endif
+
+        let pid = try POSIX.Kernel.Process.Spawn.spawn(
+            path: path,
+            argv: argv,
+            envp: envp,
+            fileActions: fileActions,
+            attributes: attributes
+        )
+
+        return try adopt(pid)
+    }
+
+    /// Opens a handle for a just-spawned child, killing and reaping it on failure.
+    private static func adopt(_ pid: Kernel.Process.ID) throws(POSIX.Kernel.Process.Error) -> Self {
+        do {
+            return try open(pid)
+        } catch {
+            // Do not leak an unwatchable child
+            _ = kill(pid.rawValue, SIGKILL)
+            var status: Int32 = 0
+            _ = waitpid(pid.rawValue, &status, 0)
+            throw error
+        }
+    }
+}
@@ -0,0 +1,78 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Process {
+    /// Resource limit namespace (setrlimit, getrlimit).
+    public enum Limit {}
+}
+
+// MARK: - Resource
+
+extension POSIX.Kernel.Process.Limit {
+    /// A limited resource (RLIMIT_*).
+    public struct Resource: RawRepresentable, Sendable, Equatable, Hashable {
+        public let rawValue: Int32
+
+        public init(rawValue: Int32) {
+            self.rawValue = rawValue
+        }
+    }
+
+    /// The "no limit" value (RLIM_INFINITY).
+    public static var infinity: UInt64 { swift_RLIM_INFINITY() }
+}
+
+extension POSIX.Kernel.Process.Limit.Resource {
+    #if canImport(Glibc)
+        private init(_ resource: __rlimit_resource) {
+            self.init(rawValue: Int32(resource.rawValue))
+        }
+    #else
+        private init(_ resource: Int32) {
+            self.init(rawValue: resource)
+        }
+    #endif
+
+    /// CPU time in seconds (RLIMIT_CPU).
+    public static var cpu: Self { Self(RLIMIT_CPU) }
+
+    /// Largest file that may be created, in bytes (RLIMIT_FSIZE).
+    public static var size: Self { Self(RLIMIT_FSIZE) }
+
+    /// Data segment size in bytes (RLIMIT_DATA).
+    public static var data: Self { Self(RLIMIT_DATA) }
+
+    /// Main thread stack size in bytes (RLIMIT_STACK).
+    public static var stack: Self { Self(RLIMIT_STACK) }
+
+    /// Core dump size in bytes (RLIMIT_CORE).
+    public static var core: Self { Self(RLIMIT_CORE) }
+
+    /// One more than the highest descriptor number (RLIMIT_NOFILE).
+    public static var files: Self { Self(RLIMIT_NOFILE) }
+
+    /// Address space size in bytes (RLIMIT_AS).
+    public static var address: Self { Self(RLIMIT_AS) }
+}
@@ -0,0 +1,236 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Process {
+    /// Pipe operations namespace (pipe2, F_SETPIPE_SZ, splice, tee, vmsplice).
+    ///
+    /// Pipes connect spawned children: pass the ends to `FileActions` and
+    /// close the parent's copies. `Pipeline` does both for a chain of stages.
+    ///
+    /// ## Zero Copy (Linux)
+    ///
+    /// `splice`, `tee` and `vmsplice` move pipe buffer pages between
+    /// descriptors inside the kernel, so data relayed between children never
+    /// enters the relaying process's address space.
+    public enum Pipe {}
+}
+
+// MARK: - Options
+
+extension POSIX.Kernel.Process.Pipe {
+    /// Descriptor flags applied to both ends of a new pipe.
+    public struct Options: OptionSet, Sendable, Hashable {
+        public let rawValue: Int32
+
+        public init(rawValue: Int32) {
+            self.rawValue = rawValue
+        }
+
+        /// Close both ends on `exec` (O_CLOEXEC).
+        public static let cloexec = Options(rawValue: Int32(SWIFT_PIPE_CLOEXEC))
+
+        /// Non-blocking I/O on both ends (O_NONBLOCK).
+        public static let nonblocking = Options(rawValue: Int32(SWIFT_PIPE_NONBLOCK))
+    }
+}
+
+// MARK: - Create
+
+extension POSIX.Kernel.Process.Pipe {
+    /// Creates a pipe (pipe2).
+    ///
+    /// - Parameter options: Flags for both ends. Defaults to `.cloexec`, so
+    ///   an end reaches a child only through an explicit `FileActions.duplicate`.
+    /// - Returns: The read and write ends.
+    /// - Throws: `POSIX.Kernel.Process.Error.pipe` on failure (EMFILE, ENFILE).
+    ///
+    /// On Linux the flags are set atomically by `pipe2`. Darwin has no
+    /// `pipe2`; they are set with `fcntl` immediately after creation.
+    public static func create(
+        _ options: Options = .cloexec
+    ) throws(POSIX.Kernel.Process.Error) -> (read: Kernel.Descriptor, write: Kernel.Descriptor) {
+        var read: Int32 = -1
+        var write: Int32 = -1
+        guard swift_pipe(options.rawValue, &read, &write) == 0 else {
+            throw .pipe(POSIX.Kernel.Error.captureErrno())
+        }
+        return (Kernel.Descriptor(rawValue: read), Kernel.Descriptor(rawValue: write))
+    }
+
+    /// Closes one pipe end, ignoring errors.
+    internal static func close(_ descriptor: Kernel.Descriptor) {
+        #if canImport(Darwin)
+            _ = Darwin.close(descriptor.rawValue)
+        #elseif canImport(Glibc)
+            _ = Glibc.close(descriptor.rawValue)
+        #elseif canImport(Musl)
+            _ = Musl.close(descriptor.rawValue)
+        #endif
+    }
+}
+
+#if os(Linux)
+
+    // MARK: - Capacity
+
+    extension POSIX.Kernel.Process.Pipe {
+        /// The pipe buffer size in bytes (F_GETPIPE_SZ).
+        ///
+        /// - Parameter descriptor: Either end of the pipe.
+        /// - Throws: `POSIX.Kernel.Process.Error.pipe` on failure.
+        public static func capacity(of descriptor: Kernel.Descriptor) throws(POSIX.Kernel.Process.Error) -> Int {
+            let size = swift_pipe_capacity(descriptor.rawValue)
+            guard size >= 0 else {
+                throw .pipe(POSIX.Kernel.Error.captureErrno())
+            }
+            return Int(size)
+        }
+
+        /// Resizes the pipe buffer (F_SETPIPE_SZ).
+        ///
+        /// Larger buffers mean fewer wakeups and larger `splice` batches
+        /// between stages. The default is 64 KiB.
+        ///
+        /// - Parameters:
+        ///   - descriptor: Either end of the pipe.
+        ///   - bytes: Requested size; rounded up to a power-of-two number of pages.
+        /// - Returns: The size actually set.
+        /// - Throws: `POSIX.Kernel.Process.Error.pipe` on failure.
+        ///
+        /// ## Common Errors
+        ///
+        /// - EPERM: Above /proc/sys/fs/pipe-max-size without CAP_SYS_RESOURCE.
+        /// - EBUSY: Smaller than the data currently queued.
+        @discardableResult
+        public static func resize(
+            _ descriptor: Kernel.Descriptor,
+            to bytes: Int
+        ) throws(POSIX.Kernel.Process.Error) -> Int {
+            let size = swift_pipe_resize(descriptor.rawValue, Int32(clamping: bytes))
+            guard size >= 0 else {
+                throw .pipe(POSIX.Kernel.Error.captureErrno())
+            }
+            return Int(size)
+        }
+    }
+
+    // MARK: - Splice
+
+    extension POSIX.Kernel.Process.Pipe {
+        /// Flags for `splice`, `tee` and `vmsplice` (SPLICE_F_*).
+        public struct Flags: OptionSet, Sendable, Hashable {
+            public let rawValue: UInt32
+
+            public init(rawValue: UInt32) {
+                self.rawValue = rawValue
+            }
+
+            /// Move pages instead of copying, where possible (SPLICE_F_MOVE).
+            public static let move = Flags(rawValue: UInt32(SWIFT_SPLICE_MOVE))
+
+            /// Do not block on the pipe itself (SPLICE_F_NONBLOCK).
+            ///
+            /// The other descriptor's blocking mode still applies.
+            public static let nonblocking = Flags(rawValue: UInt32(SWIFT_SPLICE_NONBLOCK))
+
+            /// More data follows; a hint for sockets (SPLICE_F_MORE).
+            public static let more = Flags(rawValue: UInt32(SWIFT_SPLICE_MORE))
+
+            /// Gift the pages to the kernel (SPLICE_F_GIFT, `vmsplice` only).
+            ///
+            /// The caller must not modify or free the memory afterwards.
+            public static let gift = Flags(rawValue: UInt32(SWIFT_SPLICE_GIFT))
+        }
+
+        /// Moves bytes between descriptors in the kernel (splice).
+        ///
+        /// - Parameters:
+        ///   - input: Source; a pipe read end unless `output` is a pipe.
+        ///   - output: Destination; a pipe write end unless `input` is a pipe.
+        ///   - count: Most bytes to move.
+        ///   - flags: Splice flags.
+        /// - Returns: Bytes moved; 0 at end of input.
+        /// - Throws: `POSIX.Kernel.Process.Error.pipe` on failure (EINVAL if
+        ///   neither descriptor is a pipe). Retries on EINTR.
+        public static func splice(
+            from input: Kernel.Descriptor,
+            to output: Kernel.Descriptor,
+            count: Int,
+            flags: Flags = .move
+        ) throws(POSIX.Kernel.Process.Error) -> Int {
+            let moved = swift_splice(input.rawValue, output.rawValue, count, flags.rawValue)
+            guard moved >= 0 else {
+                throw .pipe(POSIX.Kernel.Error.captureErrno())
+            }
+            return moved
+        }
+
+        /// Duplicates queued bytes from one pipe to another without consuming them (tee).
+        ///
+        /// - Parameters:
+        ///   - input: Pipe read end. Its data stays queued.
+        ///   - output: Pipe write end.
+        ///   - count: Most bytes to duplicate.
+        ///   - flags: Splice flags.
+        /// - Returns: Bytes duplicated; 0 if `input` is empty with no writers left.
+        /// - Throws: `POSIX.Kernel.Process.Error.pipe` on failure. Retries on EINTR.
+        public static func tee(
+            from input: Kernel.Descriptor,
+            to output: Kernel.Descriptor,
+            count: Int,
+            flags: Flags = []
+        ) throws(POSIX.Kernel.Process.Error) -> Int {
+            let duplicated = swift_tee(input.rawValue, output.rawValue, count, flags.rawValue)
+            guard duplicated >= 0 else {
+                throw .pipe(POSIX.Kernel.Error.captureErrno())
+            }
+            return duplicated
+        }
+
+        /// Maps user memory into a pipe (vmsplice).
+        ///
+        /// Without `.gift`, the pages are referenced, not copied: the memory
+        /// must stay unmodified until the reader has consumed it.
+        ///
+        /// - Parameters:
+        ///   - bytes: Memory to queue.
+        ///   - output: Pipe write end.
+        ///   - flags: Splice flags.
+        /// - Returns: Bytes queued; may be fewer than `bytes.count`.
+        /// - Throws: `POSIX.Kernel.Process.Error.pipe` on failure. Retries on EINTR.
+        public static func vmsplice(
+            _ bytes: UnsafeRawBufferPointer,
+            to output: Kernel.Descriptor,
+            flags: Flags = []
+        ) throws(POSIX.Kernel.Process.Error) -> Int {
+            let queued = swift_vmsplice(output.rawValue, bytes.baseAddress, bytes.count, flags.rawValue)
+            guard queued >= 0 else {
+                throw .pipe(POSIX.Kernel.Error.captureErrno())
+            }
+            return queued
+        }
+    }
+
+#endif
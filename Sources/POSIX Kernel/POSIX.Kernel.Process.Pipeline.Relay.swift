@@ -0,0 +1,161 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+#elseif canImport(Glibc)
+    internal import Glibc
+#elseif canImport(Musl)
+    internal import Musl
+#endif
+
+internal import Synchronization
+
+extension POSIX.Kernel.Process.Pipeline {
+    /// An in-process stage that moves bytes from one pipe to the next.
+    ///
+    /// The parent owns both ends. `run` moves data until the upstream child
+    /// closes its stdout, then closes both ends so the downstream child
+    /// sees EOF.
+    ///
+    /// ## Platform Behavior
+    ///
+    /// | Platform | Mechanism |
+    /// |----------|-----------|
+    /// | Linux | `splice(SPLICE_F_MOVE)`; `tee` first when copying |
+    /// | Darwin | `read`/`write` through a 64 KiB buffer |
+    public final class Relay: @unchecked Sendable {
+        /// Read end of the pipe from the upstream stage.
+        public let input: Kernel.Descriptor
+
+        /// Write end of the pipe to the downstream stage.
+        public let output: Kernel.Descriptor
+
+        /// Whether the ends have been closed.
+        private let closed = Mutex(false)
+
+        internal init(input: Kernel.Descriptor, output: Kernel.Descriptor) {
+            self.input = input
+            self.output = output
+        }
+
+        deinit {
+            close()
+        }
+
+        /// Closes both ends. Idempotent.
+        ///
+        /// Closing before `run` finishes makes the upstream child see EPIPE
+        /// and the downstream child see EOF.
+        public func close() {
+            let first = closed.withLock { closed in
+                defer { closed = true }
+                return !closed
+            }
+            guard first else { return }
+            POSIX.Kernel.Process.Pipe.close(input)
+            POSIX.Kernel.Process.Pipe.close(output)
+        }
+    }
+}
+
+// MARK: - Run
+
+extension POSIX.Kernel.Process.Pipeline.Relay {
+    /// Relays bytes until the upstream stage closes its end, then closes both ends.
+    ///
+    /// Blocks; run it on a dedicated thread, not on the Swift concurrency pool.
+    ///
+    /// - Parameter copy: Write end of another pipe that receives a copy of
+    ///   the stream, or `nil`. On Linux it must be a pipe for `tee`.
+    /// - Returns: Bytes relayed downstream.
+    /// - Throws: `POSIX.Kernel.Process.Error.pipe` on failure; both ends are
+    ///   closed either way. EPIPE means the downstream child exited early.
+    @discardableResult
+    public func run(copy: Kernel.Descriptor? = nil) throws(POSIX.Kernel.Process.Error) -> Int {
+        defer { close() }
+
+        #if os(Linux)
+            let chunk = 1 << 20
+            var total = 0
+            while true {
+                var available = chunk
+                if let copy {
+                    // tee first: it only reports what is queued, then splice
+                    // consumes exactly that much downstream
+                    available = try POSIX.Kernel.Process.Pipe.tee(from: input, to: copy, count: chunk)
+                    if available == 0 {
+                        return total
+                    }
+                }
+
+                var remaining = available
+                while remaining > 0 {
+                    let moved = try POSIX.Kernel.Process.Pipe.splice(
+                        from: input,
+                        to: output,
+                        count: remaining,
+                        flags: [.move, .more]
+                    )
+                    if moved == 0 {
+                        return total
+                    }
+                    total += moved
+                    remaining -= moved
+                    if copy == nil {
+                        break
+                    }
+                }
+            }
+        #else
+            /// Writes all of `count` bytes, retrying on EINTR and short writes.
+            func write(_ target: Kernel.Descriptor, _ bytes: UnsafeMutableRawPointer, _ count: Int) -> Int32? {
+                var written = 0
+                while written < count {
+                    let n = Darwin.write(target.rawValue, bytes + written, count - written)
+                    if n < 0 {
+                        if errno == EINTR { continue }
+                        return errno
+                    }
+                    written += n
+                }
+                return nil
+            }
+
+            let result: Swift.Result<Int, POSIX.Kernel.Process.Error> =
+                withUnsafeTemporaryAllocation(byteCount: 64 * 1024, alignment: 16) { buffer in
+                    let bytes = buffer.baseAddress!
+                    var total = 0
+                    while true {
+                        let count = Darwin.read(input.rawValue, bytes, buffer.count)
+                        if count < 0 {
+                            if errno == EINTR { continue }
+                            return .failure(.pipe(.posix(errno)))
+                        }
+                        if count == 0 {
+                            return .success(total)
+                        }
+                        if let copy, let code = write(copy, bytes, count) {
+                            return .failure(.pipe(.posix(code)))
+                        }
+                        if let code = write(output, bytes, count) {
+                            return .failure(.pipe(.posix(code)))
+                        }
+                        total += count
+                    }
+                }
+            return try result.get()
+        #endif
+    }
+}
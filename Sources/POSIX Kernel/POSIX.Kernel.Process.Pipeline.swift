@@ -0,0 +1,234 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+#elseif canImport(Glibc)
+    internal import Glibc
+#elseif canImport(Musl)
+    internal import Musl
+#endif
+
+extension POSIX.Kernel.Process {
+    /// A chain of spawned children connected stdout-to-stdin by pipes.
+    ///
+    /// `spawn` creates one O_CLOEXEC pipe per link and wires it with
+    /// `FileActions.duplicate` onto descriptors 0 and 1. All other pipe
+    /// ends close at `exec`, so a child never holds a write end that would
+    /// keep its reader from seeing EOF. The parent closes its copies as it
+    /// goes; bytes flow child to child without passing through the parent.
+    ///
+    /// ## Relays
+    ///
+    /// `relay()` inserts an in-process stage between two children, for
+    /// example to copy the stream to a log. The parent keeps both ends and
+    /// runs `Relay.run` on a thread of its choice. On Linux the relay uses
+    /// `splice` and `tee`, so the bytes stay in kernel pipe buffers; on
+    /// Darwin it falls back to a read/write loop.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let pipeline = POSIX.Kernel.Process.Pipeline(capacity: 1 << 20)
+    /// pipeline.append(Spawn.Arguments(["/usr/bin/zstd", "-dc", path]))
+    /// pipeline.relay()
+    /// pipeline.append(Spawn.Arguments(["/usr/local/bin/filter"]))
+    /// pipeline.append(Spawn.Arguments(["/usr/local/bin/upload"]))
+    ///
+    /// let running = try pipeline.spawn()
+    /// _ = try running.relays[0].run(copy: auditPipe)
+    /// for child in running.children {
+    ///     _ = try POSIX.Kernel.Process.Wait.wait(.process(child))
+    /// }
+    /// ```
+    public final class Pipeline: @unchecked Sendable {
+        /// A pipeline stage.
+        internal enum Stage {
+            case process(Spawn.Arguments)
+            case relay
+        }
+
+        internal private(set) var stages: [Stage] = []
+
+        /// Pipe buffer size for every link (F_SETPIPE_SZ), or `nil` for the
+        /// system default. Ignored on Darwin, whose pipes cannot be resized.
+        public let capacity: Int?
+
+        /// Creates an empty pipeline.
+        ///
+        /// - Parameter capacity: Pipe buffer size for every link, or `nil`.
+        public init(capacity: Int? = nil) {
+            self.capacity = capacity
+        }
+    }
+}
+
+// MARK: - Stages
+
+extension POSIX.Kernel.Process.Pipeline {
+    /// Appends a child process stage.
+    ///
+    /// - Parameter arguments: Program, argv and envp of the stage. Kept
+    ///   alive by the pipeline and reused by every `spawn`.
+    public func append(_ arguments: POSIX.Kernel.Process.Spawn.Arguments) {
+        stages.append(.process(arguments))
+    }
+
+    /// Appends an in-process relay stage.
+    ///
+    /// A relay must sit between two process stages.
+    public func relay() {
+        stages.append(.relay)
+    }
+}
+
+// MARK: - Running
+
+extension POSIX.Kernel.Process.Pipeline {
+    /// A spawned pipeline.
+    public struct Running: Sendable {
+        /// Child processes, in stage order. The caller reaps them.
+        public let children: [Kernel.Process.ID]
+
+        /// Relay stages, in stage order. Each must be run for data to flow past it.
+        public let relays: [Relay]
+    }
+}
+
+// MARK: - Spawn
+
+extension POSIX.Kernel.Process.Pipeline {
+    /// Creates the pipes and spawns every process stage.
+    ///
+    /// - Parameters:
+    ///   - input: Descriptor the first stage reads as stdin, or `nil` to
+    ///     inherit the parent's. Not closed.
+    ///   - output: Descriptor the last stage writes as stdout, or `nil` to
+    ///     inherit the parent's. Not closed.
+    ///   - attributes: Attributes applied to every child, or `nil`.
+    /// - Returns: The children and the relays to run.
+    /// - Throws: `POSIX.Kernel.Process.Error.pipe` if the stages are
+    ///   malformed (EINVAL) or a pipe cannot be created, or `.spawn` from a
+    ///   stage. Children spawned before the failure are killed and reaped.
+    public func spawn(
+        input: Kernel.Descriptor? = nil,
+        output: Kernel.Descriptor? = nil,
+        attributes: POSIX.Kernel.Process.Spawn.Attributes? = nil
+    ) throws(POSIX.Kernel.Process.Error) -> Running {
+        try validate()
+
+        typealias Pipe = POSIX.Kernel.Process.Pipe
+
+        var children: [Kernel.Process.ID] = []
+        var relays: [Relay] = []
+        children.reserveCapacity(stages.count)
+
+        // Read end feeding the next stage, and whether the parent owns it
+        var previous = input
+        var owned = false
+
+        // Link created for the current stage, until the parent hands it on
+        var pending: (read: Kernel.Descriptor, write: Kernel.Descriptor)?
+
+        do throws(POSIX.Kernel.Process.Error) {
+            for (index, stage) in stages.enumerated() {
+                switch stage {
+                case .process(let arguments):
+                    pending = index == stages.count - 1 ? nil : try link()
+
+                    let actions = try POSIX.Kernel.Process.Spawn.FileActions()
+                    if let previous {
+                        try actions.duplicate(previous, to: Kernel.Descriptor(rawValue: STDIN_FILENO))
+                    }
+                    if let target = pending?.write ?? output {
+                        try actions.duplicate(target, to: Kernel.Descriptor(rawValue: STDOUT_FILENO))
+                    }
+                    children.append(
+                        try POSIX.Kernel.Process.Spawn.spawn(arguments, fileActions: actions, attributes: attributes)
+                    )
+
+                    if owned, let previous {
+                        Pipe.close(previous)
+                    }
+                    if let write = pending?.write {
+                        Pipe.close(write)
+                    }
+                    previous = pending?.read
+                    owned = pending != nil
+                    pending = nil
+
+                case .relay:
+                    // validate() guarantees a process stage on each side
+                    let next = try link()
+                    relays.append(Relay(input: previous!, output: next.write))
+                    previous = next.read
+                    owned = true
+                }
+            }
+        } catch {
+            if owned, let previous {
+                Pipe.close(previous)
+            }
+            if let pending {
+                Pipe.close(pending.read)
+                Pipe.close(pending.write)
+            }
+            // Relays own the read end before them and the write end after;
+            // close them now rather than whenever the array is released
+            for relay in relays {
+                relay.close()
+            }
+            for child in children {
+                try? POSIX.Kernel.Process.Kill.kill(child, .kill)
+                _ = try? POSIX.Kernel.Process.Wait.wait(.process(child))
+            }
+            throw error
+        }
+
+        return Running(children: children, relays: relays)
+    }
+
+    /// Relays must sit between two process stages.
+    private func validate() throws(POSIX.Kernel.Process.Error) {
+        for (index, stage) in stages.enumerated() {
+            guard case .relay = stage else { continue }
+            guard index > 0, index < stages.count - 1,
+                case .process = stages[index - 1],
+                case .process = stages[index + 1]
+            else {
+                throw .pipe(.posix(EINVAL))
+            }
+        }
+        guard !stages.isEmpty else {
+            throw .pipe(.posix(EINVAL))
+        }
+    }
+
+    /// One O_CLOEXEC link, resized to `capacity` where supported.
+    private func link() throws(POSIX.Kernel.Process.Error) -> (read: Kernel.Descriptor, write: Kernel.Descriptor) {
+        let pipe = try POSIX.Kernel.Process.Pipe.create(.cloexec)
+        #if os(Linux)
+            if let capacity {
+                do throws(POSIX.Kernel.Process.Error) {
+                    try POSIX.Kernel.Process.Pipe.resize(pipe.write, to: capacity)
+                } catch {
+                    POSIX.Kernel.Process.Pipe.close(pipe.read)
+                    POSIX.Kernel.Process.Pipe.close(pipe.write)
+                    throw error
+                }
+            }
+        #endif
+        return pipe
+    }
+}
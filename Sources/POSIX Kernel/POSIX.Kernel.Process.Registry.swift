@@ -0,0 +1,194 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+internal import Synchronization
+
+extension POSIX.Kernel.Process {
+    /// A sharded map from child PID to the task awaiting its exit.
+    ///
+    /// Spawners `await wait(pid)`; the reaper hands each reaped `Result`
+    /// to `complete(_:)` (or calls `drain(into:)`, which does both). Each
+    /// PID hashes to one of `shards` independently locked tables, so
+    /// concurrent spawners and the reaper contend only when they touch
+    /// the same shard, and no lock is held while a waiter resumes.
+    ///
+    /// ## Ordering
+    ///
+    /// Either side may arrive first. A result completed before anyone
+    /// waits is parked until `wait` collects it, so a child reaped between
+    /// `spawn` returning and `wait` being called is not lost.
+    ///
+    /// ## Obligations
+    ///
+    /// - Complete only terminal results: the first result for a PID
+    ///   resumes its waiter, so do not feed it `untraced`/`continued` ones.
+    /// - At most one waiter per PID.
+    /// - Parked results stay until waited or `discard`ed. If the reaper
+    ///   uses `.any`, children that nobody will wait for must be discarded.
+    ///
+    /// ## Thread Safety
+    ///
+    /// Safe for concurrent use from any number of spawners and reapers.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let registry = POSIX.Kernel.Process.Registry()
+    ///
+    /// // Spawner:
+    /// let pid = try POSIX.Kernel.Process.Spawn.spawn(path: path, argv: argv, envp: envp)
+    /// let result = await registry.wait(pid)
+    ///
+    /// // Reaper, on every SIGCHLD:
+    /// while try registry.drain(into: buffer) == buffer.count {}
+    /// ```
+    public final class Registry: @unchecked Sendable {
+        /// Number of independently locked shards (a power of two).
+        public let shards: Int
+
+        private let tables: [Shard]
+        private let mask: UInt32
+
+        /// Creates an empty registry.
+        ///
+        /// - Parameter shards: Shard count, rounded up to a power of two.
+        ///   More shards lower contention at the cost of a table each.
+        public init(shards: Int = 64) {
+            precondition(shards > 0, "shards must be positive")
+
+            var count = 1
+            while count < shards {
+                count <<= 1
+            }
+            self.shards = count
+            self.mask = UInt32(count - 1)
+            self.tables = (0..<count).map { _ in Shard() }
+        }
+    }
+}
+
+// MARK: - Shard
+
+extension POSIX.Kernel.Process.Registry {
+    /// One side of a PID's rendezvous.
+    private enum Entry {
+        case waiting(CheckedContinuation<POSIX.Kernel.Process.Wait.Result, Never>)
+        case completed(POSIX.Kernel.Process.Wait.Result)
+    }
+
+    /// A separately allocated, separately locked slice of the map.
+    private final class Shard: @unchecked Sendable {
+        let entries = Mutex<[Int32: Entry]>([:])
+    }
+
+    /// PIDs are allocated sequentially, so the low bits spread evenly.
+    private func shard(for pid: Kernel.Process.ID) -> Shard {
+        tables[Int(UInt32(bitPattern: pid.rawValue) & mask)]
+    }
+}
+
+// MARK: - Operations
+
+extension POSIX.Kernel.Process.Registry {
+    /// Suspends until `pid` is completed, then returns its result.
+    ///
+    /// Returns immediately if the result is already parked. Not
+    /// cancellable: the child is expected to exit and be reaped.
+    public func wait(_ pid: Kernel.Process.ID) async -> POSIX.Kernel.Process.Wait.Result {
+        let shard = shard(for: pid)
+        let key = pid.rawValue
+
+        return await withCheckedContinuation { continuation in
+            let parked = shard.entries.withLock { entries -> POSIX.Kernel.Process.Wait.Result? in
+                switch entries[key] {
+                case .completed(let result):
+                    entries[key] = nil
+                    return result
+                case .waiting:
+                    preconditionFailure("a child can have only one waiter")
+                case nil:
+                    entries[key] = .waiting(continuation)
+                    return nil
+                }
+            }
+            if let parked {
+                continuation.resume(returning: parked)
+            }
+        }
+    }
+
+    /// Suspends until the handle's child is completed.
+    public func wait(_ handle: POSIX.Kernel.Process.Handle) async -> POSIX.Kernel.Process.Wait.Result {
+        await wait(handle.pid)
+    }
+
+    /// Delivers a reaped child's result.
+    ///
+    /// - Returns: `true` if a waiter was resumed, `false` if the result
+    ///   was parked for a later `wait`.
+    @discardableResult
+    public func complete(_ result: POSIX.Kernel.Process.Wait.Result) -> Bool {
+        let key = result.pid.rawValue
+        let waiter = shard(for: result.pid).entries.withLock {
+            entries -> CheckedContinuation<POSIX.Kernel.Process.Wait.Result, Never>? in
+            if case .waiting(let continuation) = entries[key] {
+                entries[key] = nil
+                return continuation
+            }
+            entries[key] = .completed(result)
+            return nil
+        }
+
+        // Resume outside the lock
+        guard let waiter else { return false }
+        waiter.resume(returning: result)
+        return true
+    }
+
+    /// Reaps every ready child with `Wait.drain` and completes each.
+    ///
+    /// - Returns: The number of children reaped. If it equals
+    ///   `buffer.count`, more may be ready.
+    /// - Throws: As `Wait.drain`.
+    public func drain(
+        _ selector: POSIX.Kernel.Process.Wait.Selector = .any,
+        into buffer: UnsafeMutableBufferPointer<POSIX.Kernel.Process.Wait.Result>
+    ) throws(POSIX.Kernel.Process.Error) -> Int {
+        let count = try POSIX.Kernel.Process.Wait.drain(selector, into: buffer)
+        for result in buffer[..<count] {
+            complete(result)
+        }
+        return count
+    }
+
+    /// Removes and returns a parked result nobody will wait for.
+    ///
+    /// Returns `nil` if nothing is parked for `pid`; a pending waiter is
+    /// left in place.
+    @discardableResult
+    public func discard(_ pid: Kernel.Process.ID) -> POSIX.Kernel.Process.Wait.Result? {
+        let key = pid.rawValue
+        return shard(for: pid).entries.withLock { entries in
+            guard case .completed(let result) = entries[key] else { return nil }
+            entries[key] = nil
+            return result
+        }
+    }
+
+    /// Number of pending waiters and parked results across all shards.
+    public var count: Int {
+        tables.reduce(0) { total, shard in
+            total + shard.entries.withLock { $0.count }
+        }
+    }
+}
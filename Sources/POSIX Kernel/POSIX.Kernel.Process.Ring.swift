@@ -0,0 +1,385 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(Linux)
+
+    public import Kernel_Primitives
+    public import POSIX_Primitives
+
+    #if canImport(Glibc)
+        internal import Glibc
+        internal import CPOSIXProcessShim
+    #elseif canImport(Musl)
+        internal import Musl
+        internal import CPOSIXProcessShim
+    #endif
+
+    extension POSIX.Kernel.Process {
+        /// An io_uring that batches child lifecycle operations (Linux only).
+        ///
+        /// Queue any number of operations, then hand them all to the kernel
+        /// with one `submit`, and collect what finished with one
+        /// `completions(into:)`:
+        ///
+        /// | Operation | io_uring opcode | Completes as |
+        /// |-----------|-----------------|--------------|
+        /// | `wait(_:tag:)` | `IORING_OP_WAITID` on a pidfd (6.7+) | `.exited(Wait.Result)` |
+        /// | `poll(_:tag:)` | `IORING_OP_POLL_ADD` on a pidfd | `.readable` |
+        /// | `read(_:tag:)` | `POLL_ADD` linked to `READ` on a signalfd | `.signals(count)` |
+        /// | `splice(from:to:count:flags:tag:)` | `IORING_OP_SPLICE` | `.spliced(bytes)` |
+        ///
+        /// A loop reaping hundreds of children therefore costs one
+        /// `io_uring_enter` per batch instead of one `waitid` each. The ring
+        /// is driven with raw syscalls; liburing is not required.
+        ///
+        /// Every operation is one-shot: queue it again to keep watching.
+        /// Failures of individual operations complete as `.failed(code)`;
+        /// a kernel without `IORING_OP_WAITID` fails waits with EINVAL, so
+        /// fall back to `poll` plus `Wait.wait(_:options: .no.hang)` there.
+        ///
+        /// ## Obligations
+        ///
+        /// - Descriptors (pidfds, streams, pipes) must stay open until their
+        ///   operation completes.
+        /// - At most `capacity` operations in flight, and one stream read.
+        /// - Deinitialising cancels what is still in flight and waits for it.
+        ///
+        /// ## Thread Safety
+        ///
+        /// Single issuer: use a ring from one thread at a time.
+        ///
+        /// ## Usage
+        ///
+        /// ```swift
+        /// let ring = try POSIX.Kernel.Process.Ring(entries: 256)
+        /// for (index, handle) in handles.enumerated() {
+        ///     try ring.wait(handle, tag: UInt64(index))
+        /// }
+        /// try ring.read(stream, tag: .max)
+        ///
+        /// while running {
+        ///     try ring.submit(waitingFor: 1)
+        ///     let count = ring.completions(into: buffer)
+        ///     for completion in buffer[..<count] { dispatch(completion) }
+        /// }
+        /// ```
+        public final class Ring: @unchecked Sendable {
+            /// Most operations that may be in flight at once.
+            public let capacity: Int
+
+            /// The records of the latest `.signals(count)` completion.
+            ///
+            /// Valid until the next stream read completes.
+            public private(set) var signals: [POSIX.Kernel.Signal.Stream.Record] = []
+
+            private let ring: UnsafeMutablePointer<swift_uring>
+            private let slots: UnsafeMutablePointer<Slot>
+            private let infos: UnsafeMutablePointer<siginfo_t>
+            private let cqes: UnsafeMutablePointer<swift_uring_cqe>
+            private let raw: UnsafeMutableRawPointer
+            private let records: UnsafeMutablePointer<swift_signal_record>
+            private var free: [Int32]
+            private var reading = false
+
+            /// Completions still expected from the kernel.
+            private var outstanding = 0
+
+            /// Creates a ring.
+            ///
+            /// - Parameter entries: Submission queue size, rounded up to a
+            ///   power of two by the kernel. Queueing past it submits early.
+            ///   `capacity` is twice this, the completion queue size.
+            /// - Throws: `Error.ring` on failure (ENOSYS without io_uring,
+            ///   EPERM where it is disabled by policy).
+            public init(entries: Int = 256) throws(POSIX.Kernel.Process.Error) {
+                precondition(entries > 0, "entries must be positive")
+
+                let ring = UnsafeMutablePointer<swift_uring>.allocate(capacity: 1)
+                guard swift_uring_open(ring, UInt32(entries)) == 0 else {
+                    let code = POSIX.Kernel.Error.captureErrno()
+                    ring.deallocate()
+                    throw .ring(code)
+                }
+
+                let capacity = Int(ring.pointee.sq_entries) * 2
+                self.ring = ring
+                self.capacity = capacity
+                self.slots = .allocate(capacity: capacity)
+                self.infos = .allocate(capacity: capacity)
+                self.cqes = .allocate(capacity: capacity)
+                self.raw = .allocate(
+                    byteCount: swift_signal_record_size() * Int(SWIFT_SIGNAL_BATCH),
+                    alignment: 8
+                )
+                self.records = .allocate(capacity: Int(SWIFT_SIGNAL_BATCH))
+                self.free = Array((0..<Int32(capacity)).reversed())
+            }
+
+            deinit {
+                if outstanding > 0, let sqe = next() {
+                    swift_uring_prep_cancel_all(sqe, Self.cancel)
+                    outstanding += 1
+                    // Buffers must outlive every request that might still write them
+                    drain: while outstanding > 0 {
+                        guard swift_uring_submit(ring, 1) >= 0 || errno == EINTR else { break }
+                        let reaped = Int(swift_uring_reap(ring, cqes, Int32(capacity)))
+                        outstanding -= reaped
+                        for index in 0..<reaped where cqes[index].user_data == Self.cancel && cqes[index].res < 0 {
+                            // Cancel unsupported (pre-5.19): nothing more will complete
+                            break drain
+                        }
+                    }
+                }
+
+                swift_uring_close(ring)
+                ring.deallocate()
+                slots.deallocate()
+                infos.deallocate()
+                cqes.deallocate()
+                raw.deallocate()
+                records.deallocate()
+            }
+        }
+    }
+
+    // MARK: - Completion
+
+    extension POSIX.Kernel.Process.Ring {
+        /// A finished operation.
+        public struct Completion: Sendable, Equatable {
+            /// The tag the operation was queued with.
+            public let tag: UInt64
+
+            /// What happened.
+            public let event: Event
+
+            public init(tag: UInt64, event: Event) {
+                self.tag = tag
+                self.event = event
+            }
+        }
+
+        /// The outcome of an operation.
+        public enum Event: Sendable, Equatable {
+            /// The child exited; the handle's process is reaped.
+            case exited(POSIX.Kernel.Process.Wait.Result)
+
+            /// The pidfd became readable: the child exited but is not reaped.
+            case readable
+
+            /// That many records were read into `signals`.
+            case signals(Int)
+
+            /// That many bytes were spliced; 0 at end of input.
+            case spliced(Int)
+
+            /// The operation failed (ECANCELED if cancelled).
+            case failed(Kernel.Error.Code)
+        }
+    }
+
+    // MARK: - Queueing
+
+    extension POSIX.Kernel.Process.Ring {
+        /// Queues a reap of the handle's child (`waitid(P_PIDFD, WEXITED)`).
+        ///
+        /// - Throws: `Error.ring(EBUSY)` if `capacity` operations are in flight.
+        public func wait(_ handle: POSIX.Kernel.Process.Handle, tag: UInt64) throws(POSIX.Kernel.Process.Error) {
+            let (slot, sqe) = try acquire(.wait, tag: tag)
+            swift_uring_prep_waitid(sqe, handle.descriptor.rawValue, infos + Int(slot), UInt64(slot))
+        }
+
+        /// Queues a readiness poll of the handle's pidfd, without reaping.
+        ///
+        /// - Throws: `Error.ring(EBUSY)` if `capacity` operations are in flight.
+        public func poll(_ handle: POSIX.Kernel.Process.Handle, tag: UInt64) throws(POSIX.Kernel.Process.Error) {
+            let (slot, sqe) = try acquire(.poll, tag: tag)
+            swift_uring_prep_poll(sqe, handle.descriptor.rawValue, 0, UInt64(slot))
+        }
+
+        /// Queues one batched read of pending signals from `stream`.
+        ///
+        /// The signalfd is nonblocking, so the read is linked behind a poll
+        /// and only runs once a signal is pending. Completes as
+        /// `.signals(count)` with up to `SWIFT_SIGNAL_BATCH` records.
+        ///
+        /// - Throws: `Error.ring(EBUSY)` if a stream read is already in
+        ///   flight or `capacity` operations are.
+        public func read(_ stream: POSIX.Kernel.Signal.Stream, tag: UInt64) throws(POSIX.Kernel.Process.Error) {
+            guard !reading, !free.isEmpty, swift_uring_space(ring) >= 2 || submitted() else {
+                throw .ring(.posix(EBUSY))
+            }
+            let descriptor = stream.descriptor.rawValue
+            swift_uring_prep_poll(next()!, descriptor, 1, Self.internal)
+            outstanding += 1
+
+            let (slot, sqe) = try acquire(.signals, tag: tag)
+            let length = UInt32(swift_signal_record_size() * Int(SWIFT_SIGNAL_BATCH))
+            swift_uring_prep_read(sqe, descriptor, raw, length, UInt64(slot))
+            reading = true
+        }
+
+        /// Queues a splice between descriptors, one of which is a pipe.
+        ///
+        /// - Throws: `Error.ring(EBUSY)` if `capacity` operations are in flight.
+        public func splice(
+            from input: Kernel.Descriptor,
+            to output: Kernel.Descriptor,
+            count: Int,
+            flags: POSIX.Kernel.Process.Pipe.Flags = .move,
+            tag: UInt64
+        ) throws(POSIX.Kernel.Process.Error) {
+            let (slot, sqe) = try acquire(.splice, tag: tag)
+            swift_uring_prep_splice(
+                sqe, input.rawValue, output.rawValue, UInt32(min(count, Int(UInt32.max))), flags.rawValue, UInt64(slot)
+            )
+        }
+    }
+
+    // MARK: - Submission and Completion
+
+    extension POSIX.Kernel.Process.Ring {
+        /// Hands every queued operation to the kernel in one `io_uring_enter`.
+        ///
+        /// - Parameter count: Completions to block for; 0 returns at once.
+        /// - Returns: Operations submitted.
+        /// - Throws: `Error.ring` on failure (EINTR if a signal interrupted
+        ///   the wait; queued operations are kept).
+        @discardableResult
+        public func submit(waitingFor count: Int = 0) throws(POSIX.Kernel.Process.Error) -> Int {
+            let submitted = swift_uring_submit(ring, UInt32(count))
+            guard submitted >= 0 else {
+                throw .ring(POSIX.Kernel.Error.captureErrno())
+            }
+            return Int(submitted)
+        }
+
+        /// Collects finished operations without blocking.
+        ///
+        /// - Parameter buffer: Receives completions, in kernel order.
+        /// - Returns: Completions written; `buffer.count` means more may be ready.
+        public func completions(into buffer: UnsafeMutableBufferPointer<Completion>) -> Int {
+            guard let base = buffer.baseAddress else { return 0 }
+            var count = 0
+
+            while count < buffer.count {
+                let reaped = Int(swift_uring_reap(ring, cqes, Int32(min(buffer.count - count, capacity))))
+                guard reaped > 0 else { break }
+                outstanding -= reaped
+
+                for index in 0..<reaped {
+                    let cqe = cqes[index]
+                    guard cqe.user_data < Self.cancel else { continue }
+                    (base + count).initialize(to: complete(Int(cqe.user_data), res: cqe.res))
+                    count += 1
+                }
+            }
+
+            return count
+        }
+    }
+
+    // MARK: - Slots
+
+    extension POSIX.Kernel.Process.Ring {
+        /// User data of linked polls, which produce no completion.
+        private static let `internal` = UInt64.max
+
+        /// User data of the cancel issued on deinit.
+        private static let cancel = UInt64.max - 1
+
+        /// What an in-flight slot is waiting on.
+        fileprivate enum Kind: UInt8 {
+            case wait
+            case poll
+            case signals
+            case splice
+        }
+
+        /// An in-flight operation.
+        fileprivate struct Slot {
+            var tag: UInt64
+            var kind: Kind
+        }
+
+        /// The next SQE, submitting queued ones first if the queue is full.
+        private func next() -> UnsafeMutablePointer<swift_uring_sqe>? {
+            if let sqe = swift_uring_next(ring) {
+                return sqe
+            }
+            _ = swift_uring_submit(ring, 0)
+            return swift_uring_next(ring)
+        }
+
+        /// Submits early to make room; whether the queue has space afterwards.
+        private func submitted() -> Bool {
+            _ = swift_uring_submit(ring, 0)
+            return swift_uring_space(ring) >= 2
+        }
+
+        private func acquire(
+            _ kind: Kind,
+            tag: UInt64
+        ) throws(POSIX.Kernel.Process.Error) -> (Int32, UnsafeMutablePointer<swift_uring_sqe>) {
+            guard let slot = free.last else {
+                throw .ring(.posix(EBUSY))
+            }
+            guard let sqe = next() else {
+                throw .ring(POSIX.Kernel.Error.captureErrno())
+            }
+            free.removeLast()
+            slots[Int(slot)] = Slot(tag: tag, kind: kind)
+            outstanding += 1
+            return (slot, sqe)
+        }
+
+        /// Releases `slot` and turns its completion result into a `Completion`.
+        private func complete(_ slot: Int, res: Int32) -> Completion {
+            let entry = slots[slot]
+            free.append(Int32(slot))
+            if entry.kind == .signals {
+                reading = false
+            }
+
+            guard res >= 0 else {
+                return Completion(tag: entry.tag, event: .failed(.posix(-res)))
+            }
+
+            switch entry.kind {
+            case .wait:
+                var status: Int32 = 0
+                let pid = swift_uring_waitid_result(infos + slot, &status)
+                POSIX.Kernel.Trace.mark(.reap, pid: pid, detail: status)
+                let result = POSIX.Kernel.Process.Wait.Result(
+                    pid: Kernel.Process.ID(pid),
+                    status: POSIX.Kernel.Process.Status(rawValue: status)
+                )
+                return Completion(tag: entry.tag, event: .exited(result))
+
+            case .poll:
+                return Completion(tag: entry.tag, event: .readable)
+
+            case .signals:
+                let count = Int(res) / swift_signal_record_size()
+                swift_signal_records_decode(raw, Int32(count), records)
+                signals.removeAll(keepingCapacity: true)
+                for index in 0..<count {
+                    signals.append(POSIX.Kernel.Signal.Stream.Record(records[index]))
+                }
+                return Completion(tag: entry.tag, event: .signals(count))
+
+            case .splice:
+                return Completion(tag: entry.tag, event: .spliced(Int(res)))
+            }
+        }
+    }
+
+#endif
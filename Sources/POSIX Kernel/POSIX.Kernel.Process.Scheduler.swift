@@ -0,0 +1,71 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(Linux)
+
+    public import Kernel_Primitives
+    public import POSIX_Primitives
+
+    #if canImport(Glibc)
+        internal import Glibc
+        internal import CPOSIXProcessShim
+    #elseif canImport(Musl)
+        internal import Musl
+        internal import CPOSIXProcessShim
+    #endif
+
+    extension POSIX.Kernel.Process {
+        /// Scheduling policy namespace (sched_setscheduler).
+        public enum Scheduler {}
+    }
+
+    // MARK: - Policy
+
+    extension POSIX.Kernel.Process.Scheduler {
+        /// A scheduling policy (SCHED_*).
+        public struct Policy: RawRepresentable, Sendable, Equatable, Hashable {
+            public let rawValue: Int32
+
+            public init(rawValue: Int32) {
+                self.rawValue = rawValue
+            }
+
+            /// Default time-sharing (SCHED_OTHER). Priority must be 0.
+            public static let other = Self(rawValue: SCHED_OTHER)
+
+            /// Real-time first-in first-out (SCHED_FIFO). Runs until it
+            /// blocks or a higher priority becomes runnable.
+            ///
+            /// Requires CAP_SYS_NICE or a non-zero RLIMIT_RTPRIO.
+            public static let fifo = Self(rawValue: SCHED_FIFO)
+
+            /// Real-time round robin (SCHED_RR). Like `.fifo`, with a time slice.
+            public static let roundRobin = Self(rawValue: SCHED_RR)
+
+            /// CPU-bound batch work (SCHED_BATCH). Priority must be 0.
+            ///
+            /// Treated as always CPU-bound, so it is preempted by interactive
+            /// work instead of preempting it.
+            public static let batch = Self(rawValue: SWIFT_SCHED_BATCH)
+
+            /// Lowest-priority background work (SCHED_IDLE). Priority must be 0.
+            public static let idle = Self(rawValue: SWIFT_SCHED_IDLE)
+
+            /// Valid static priorities for this policy (sched_get_priority_min/max).
+            ///
+            /// `1...99` for `.fifo` and `.roundRobin` on Linux, `0...0` otherwise.
+            public var priorities: ClosedRange<Int32> {
+                sched_get_priority_min(rawValue)...sched_get_priority_max(rawValue)
+            }
+        }
+    }
+
+#endif
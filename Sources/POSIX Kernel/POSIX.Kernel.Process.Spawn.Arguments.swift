@@ -0,0 +1,416 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+#elseif canImport(Glibc)
+    internal import Glibc
+#elseif canImport(Musl)
+    internal import Musl
+#endif
+
+extension POSIX.Kernel.Process.Spawn {
+    /// A reusable argv/envp arena.
+    ///
+    /// The pointer table (`argv`, NULL, `envp`, NULL) and every owned string
+    /// live in one contiguous allocation. Replacing an argument or variable
+    /// with a value that fits its slot rewrites the bytes in place, so
+    /// spawning from a template in a hot loop does no heap allocation.
+    ///
+    /// ## Layout
+    ///
+    /// ```
+    /// [ argv[0] … argv[n-1] NULL envp[0] … envp[m-1] NULL | "arg0\0" "arg1\0" … "K=V\0" … ]
+    ///   └──────────── pointer table ────────────────────┘   └──────── strings ─────────┘
+    /// ```
+    ///
+    /// A value that outgrows its slot is appended to the string area. The
+    /// old bytes become dead space, and the arena grows only when the
+    /// string area is full. Growth moves every string and rebuilds the
+    /// table in the same pass.
+    ///
+    /// ## Inherited Environment
+    ///
+    /// `.inherit` copies the pointers of `environ`, not the strings. Only
+    /// overridden variables are stored in the arena. The snapshot is taken
+    /// at init: do not `setenv`/`unsetenv`/`putenv` while it is in use,
+    /// since libc may free or reuse the strings it points to.
+    ///
+    /// ## Thread Safety
+    ///
+    /// Concurrent spawns from one arena are safe. Mutations must not overlap
+    /// with each other or with a spawn; `argv` and `envp` are only valid
+    /// until the next mutation.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let template = POSIX.Kernel.Process.Spawn.Arguments(
+    ///     ["/usr/local/bin/worker", "--task", "000000"],
+    ///     environment: .inherit
+    /// )
+    /// template.set(variable: "MODE", to: "batch")
+    ///
+    /// for task in tasks {
+    ///     template.set(2, to: task.id)        // fits the slot: no allocation
+    ///     _ = try POSIX.Kernel.Process.Spawn.spawn(template)
+    /// }
+    /// ```
+    public final class Arguments: @unchecked Sendable {
+        /// Table and string storage.
+        private var storage: UnsafeMutableRawPointer
+
+        /// Pointer slots in the table.
+        private var slots: Int
+
+        /// Bytes in the string area.
+        private var capacity: Int
+
+        /// Bytes of the string area in use, including dead space.
+        private var used: Int = 0
+
+        private var arguments: [Entry] = []
+        private var variables: [Entry] = []
+
+        /// Creates an arena for `arguments` and an environment.
+        ///
+        /// - Parameters:
+        ///   - arguments: The argument vector. `arguments[0]` is also the
+        ///     executable path used by `Spawn.spawn(_:)`. Must not be empty.
+        ///   - environment: The environment (default: empty).
+        public init(_ arguments: [String], environment: Environment = .explicit([])) {
+            precondition(!arguments.isEmpty, "argv must contain at least the program path")
+
+            var inherited: [UnsafePointer<CChar>] = []
+            var explicit: [String] = []
+            switch environment {
+            case .inherit:
+                if var entry = POSIX.Kernel.Process.Spawn.Arguments.environ {
+                    while let string = entry.pointee {
+                        inherited.append(UnsafePointer(string))
+                        entry += 1
+                    }
+                }
+            case .explicit(let strings):
+                explicit = strings
+            }
+
+            let bytes = (arguments + explicit).reduce(0) { $0 + $1.utf8.count + 1 }
+            self.slots = arguments.count + inherited.count + explicit.count + 2
+            self.capacity = max(bytes, 64)
+            self.storage = Self.allocate(slots: slots, capacity: capacity)
+
+            self.arguments.reserveCapacity(arguments.count)
+            for argument in arguments {
+                self.arguments.append(store(argument))
+            }
+
+            self.variables.reserveCapacity(inherited.count + explicit.count)
+            for pointer in inherited {
+                self.variables.append(.borrowed(pointer))
+            }
+            for variable in explicit {
+                self.variables.append(store(variable))
+            }
+
+            rebuild()
+        }
+
+        deinit {
+            storage.deallocate()
+        }
+    }
+}
+
+// MARK: - Environment
+
+extension POSIX.Kernel.Process.Spawn.Arguments {
+    /// Where the initial environment comes from.
+    public enum Environment: Sendable, Equatable {
+        /// The calling process's environment, by pointer (no string copies).
+        case inherit
+
+        /// Exactly these `NAME=value` strings.
+        case explicit([String])
+    }
+}
+
+// MARK: - Vectors
+
+extension POSIX.Kernel.Process.Spawn.Arguments {
+    /// Number of arguments (argc).
+    public var count: Int { arguments.count }
+
+    /// NULL-terminated argument vector. Valid until the next mutation.
+    public var argv: UnsafePointer<UnsafePointer<CChar>?> {
+        UnsafePointer(table)
+    }
+
+    /// NULL-terminated environment vector. Valid until the next mutation.
+    public var envp: UnsafePointer<UnsafePointer<CChar>?> {
+        UnsafePointer(table + arguments.count + 1)
+    }
+
+    /// `argv[0]`, used as the executable path. Valid until the next mutation.
+    public var path: UnsafePointer<CChar> {
+        table.pointee!
+    }
+
+    /// Argument at `index`, decoded as a String.
+    ///
+    /// Allocates; for diagnostics and tests, not the spawn path.
+    public subscript(index: Int) -> String {
+        String(cString: table[index]!)
+    }
+}
+
+// MARK: - Mutation
+
+extension POSIX.Kernel.Process.Spawn.Arguments {
+    /// Replaces the argument at `index`.
+    ///
+    /// In place, with no allocation, if `argument` is no longer than the
+    /// longest value this slot has held.
+    public func set(_ index: Int, to argument: String) {
+        precondition(index >= 0 && index < arguments.count, "argument index out of range")
+        let before = storage
+        let entry = store(argument, replacing: arguments[index])
+        arguments[index] = entry
+        if storage == before {
+            table[index] = pointer(entry)
+        } else {
+            rebuild()
+        }
+    }
+
+    /// Appends an argument.
+    public func append(_ argument: String) {
+        reserve(slots: arguments.count + variables.count + 3)
+        arguments.append(store(argument))
+        rebuild()
+    }
+
+    /// Sets `name=value`, replacing an existing definition of `name`.
+    ///
+    /// Overriding an inherited variable stores only the new `name=value`;
+    /// the rest of the environment stays borrowed.
+    public func set(variable name: String, to value: String) {
+        let index = find(name)
+        let before = storage
+        let entry = store(name, value, replacing: index.map { variables[$0] })
+
+        if let index {
+            variables[index] = entry
+            if storage == before {
+                table[arguments.count + 1 + index] = pointer(entry)
+                return
+            }
+        } else {
+            reserve(slots: arguments.count + variables.count + 3)
+            variables.append(entry)
+        }
+        rebuild()
+    }
+
+    /// Removes every definition of `name`.
+    public func remove(variable name: String) {
+        var removed = false
+        while let index = find(name) {
+            variables.remove(at: index)
+            removed = true
+        }
+        if removed { rebuild() }
+    }
+}
+
+// MARK: - Spawn / Execute
+
+extension POSIX.Kernel.Process.Spawn {
+    /// Spawns `arguments.path` with the arena's argv and envp.
+    ///
+    /// Same semantics as `spawn(path:argv:envp:fileActions:attributes:)`.
+    /// For a path that differs from `argv[0]`, pass `arguments.argv` and
+    /// `arguments.envp` to that overload.
+    public static func spawn(
+        _ arguments: Arguments,
+        fileActions: FileActions? = nil,
+        attributes: Attributes? = nil
+    ) throws(POSIX.Kernel.Process.Error) -> Kernel.Process.ID {
+        try withExtendedLifetime(arguments) { () throws(POSIX.Kernel.Process.Error) in
+            try spawn(
+                path: arguments.path,
+                argv: arguments.argv,
+                envp: arguments.envp,
+                fileActions: fileActions,
+                attributes: attributes
+            )
+        }
+    }
+}
+
+extension POSIX.Kernel.Process.Execute {
+    /// Replaces the process image with `arguments.path`.
+    ///
+    /// No allocation: safe between `fork` and `exec` once the arena is built.
+    public static func execve(
+        _ arguments: POSIX.Kernel.Process.Spawn.Arguments
+    ) throws(POSIX.Kernel.Process.Error) {
+        try withExtendedLifetime(arguments) { () throws(POSIX.Kernel.Process.Error) in
+            try execve(path: arguments.path, argv: arguments.argv, envp: arguments.envp)
+        }
+    }
+}
+
+// MARK: - Storage
+
+extension POSIX.Kernel.Process.Spawn.Arguments {
+    /// A table entry: a string in the arena, or a borrowed `environ` string.
+    fileprivate enum Entry {
+        /// Offset into the string area, and the slot size including NUL.
+        case owned(offset: Int, size: Int)
+
+        /// A string owned by someone else.
+        case borrowed(UnsafePointer<CChar>)
+    }
+
+    private typealias Slot = UnsafePointer<CChar>?
+
+    private var table: UnsafeMutablePointer<Slot> {
+        storage.assumingMemoryBound(to: Slot.self)
+    }
+
+    private var strings: UnsafeMutablePointer<CChar> {
+        (storage + slots * MemoryLayout<Slot>.stride).assumingMemoryBound(to: CChar.self)
+    }
+
+    private static func allocate(slots: Int, capacity: Int) -> UnsafeMutableRawPointer {
+        let storage = UnsafeMutableRawPointer.allocate(
+            byteCount: slots * MemoryLayout<Slot>.stride + capacity,
+            alignment: MemoryLayout<Slot>.alignment
+        )
+        storage.bindMemory(to: Slot.self, capacity: slots)
+        (storage + slots * MemoryLayout<Slot>.stride).bindMemory(to: CChar.self, capacity: capacity)
+        return storage
+    }
+
+    private func pointer(_ entry: Entry) -> UnsafePointer<CChar> {
+        switch entry {
+        case .owned(let offset, _):
+            return UnsafePointer(strings + offset)
+        case .borrowed(let pointer):
+            return pointer
+        }
+    }
+
+    /// Rewrites the whole pointer table.
+    private func rebuild() {
+        var slot = table
+        for entry in arguments {
+            slot.initialize(to: pointer(entry))
+            slot += 1
+        }
+        slot.initialize(to: nil)
+        slot += 1
+        for entry in variables {
+            slot.initialize(to: pointer(entry))
+            slot += 1
+        }
+        slot.initialize(to: nil)
+    }
+
+    /// Ensures room for `slots` table entries and `bytes` more string bytes.
+    private func reserve(slots needed: Int, bytes: Int = 0) {
+        guard needed > slots || used + bytes > capacity else { return }
+
+        let newSlots = needed > slots ? max(needed, slots * 2) : slots
+        let newCapacity = used + bytes > capacity ? max(used + bytes, capacity * 2) : capacity
+        let grown = Self.allocate(slots: newSlots, capacity: newCapacity)
+
+        let oldStrings = strings
+        (grown + newSlots * MemoryLayout<Slot>.stride)
+            .assumingMemoryBound(to: CChar.self)
+            .update(from: oldStrings, count: used)
+
+        storage.deallocate()
+        storage = grown
+        slots = newSlots
+        capacity = newCapacity
+    }
+
+    /// Writes `first`, or `first=second`, as one NUL-terminated string.
+    ///
+    /// Reuses `existing` if it is owned and large enough; otherwise appends.
+    /// May grow the arena; callers compare `storage` to detect that.
+    private func store(_ first: String, _ second: String? = nil, replacing existing: Entry? = nil) -> Entry {
+        let length = first.utf8.count + (second.map { $0.utf8.count + 1 } ?? 0)
+
+        let offset: Int
+        let size: Int
+        if case .owned(let existingOffset, let existingSize)? = existing, existingSize > length {
+            offset = existingOffset
+            size = existingSize
+        } else {
+            reserve(slots: slots, bytes: length + 1)
+            offset = used
+            size = length + 1
+            used += size
+        }
+
+        var cursor = strings + offset
+        func write(_ part: String) {
+            for byte in part.utf8 {
+                precondition(byte != 0, "argument or variable contains NUL")
+                cursor.pointee = CChar(bitPattern: byte)
+                cursor += 1
+            }
+        }
+
+        write(first)
+        if let second {
+            cursor.pointee = CChar(UInt8(ascii: "="))
+            cursor += 1
+            write(second)
+        }
+        cursor.pointee = 0
+        return .owned(offset: offset, size: size)
+    }
+
+    /// Index of the first variable named `name`.
+    private func find(_ name: String) -> Int? {
+        let utf8 = name.utf8
+        for (index, entry) in variables.enumerated() {
+            var cursor = pointer(entry)
+            var matched = true
+            for byte in utf8 where matched {
+                matched = UInt8(bitPattern: cursor.pointee) == byte
+                cursor += 1
+            }
+            if matched && cursor.pointee == CChar(UInt8(ascii: "=")) {
+                return index
+            }
+        }
+        return nil
+    }
+
+    /// The calling process's current `environ`.
+    fileprivate static var environ: UnsafeMutablePointer<UnsafeMutablePointer<CChar>?>? {
+        #if canImport(Darwin)
+            _NSGetEnviron().pointee
+        #elseif canImport(Glibc)
+            Glibc.environ
+        #elseif canImport(Musl)
+            Musl.environ
+        #endif
+    }
+}
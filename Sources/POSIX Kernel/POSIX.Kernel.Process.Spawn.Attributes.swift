@@ -0,0 +1,346 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    public import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    public import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    public import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Process.Spawn {
+    /// Process attributes applied to the child by `posix_spawn`.
+    ///
+    /// Wraps `posix_spawnattr_t`. Each setter records the value and enables
+    /// the matching `POSIX_SPAWN_*` flag; flags are never cleared.
+    ///
+    /// ## Reuse
+    ///
+    /// Like `FileActions`, build once and pass to many spawns. The attribute
+    /// object is handed to `posix_spawn` by pointer with no per-spawn setup.
+    ///
+    /// ## Thread Safety
+    ///
+    /// Setters are NOT synchronized. Finish configuring before sharing the
+    /// instance; concurrent spawns that only read it are safe.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let attributes = try POSIX.Kernel.Process.Spawn.Attributes()
+    /// try attributes.group(.same)                      // child leads a new group
+    /// try attributes.mask(POSIX.Kernel.Signal.Set())   // empty signal mask
+    /// try attributes.reset(.all)                       // SIG_DFL for every signal
+    /// try attributes.close(except: [socket])           // nothing else leaks into the child
+    /// try attributes.limit(.files, soft: 4096, hard: 4096)
+    ///
+    /// let child = try POSIX.Kernel.Process.Spawn.spawn(
+    ///     path: path,
+    ///     argv: argv,
+    ///     envp: envp,
+    ///     attributes: attributes
+    /// )
+    /// ```
+    public final class Attributes: @unchecked Sendable {
+        /// The initialized `posix_spawnattr_t` (owned).
+        internal let pointer: UnsafeMutablePointer<posix_spawnattr_t>
+
+        /// The same attributes as pre-exec steps, for the vfork engine and
+        /// for `Execute.execve(path:argv:envp:attributes:)`.
+        internal let steps = POSIX.Kernel.Process.Spawn.Steps()
+
+        /// Sorted descriptors kept by `close(except:)`, or `nil` if unset.
+        internal private(set) var kept: [Int32]?
+
+        /// Whether a setting has no `posix_spawn` equivalent here, so
+        /// `spawn` must run `steps` in the vfork engine instead.
+        internal private(set) var stepped = false
+
+        #if os(Linux)
+            /// cgroup v2 directory the child starts in, or -1.
+            internal private(set) var placement: Int32 = -1
+        #endif
+
+        #if canImport(Darwin)
+            /// Inherit actions for `kept`, used when `spawn` gets no file actions.
+            internal private(set) var inherit: POSIX.Kernel.Process.Spawn.FileActions?
+        #endif
+
+        /// Creates attributes with no flags set.
+        ///
+        /// - Throws: `POSIX.Kernel.Process.Error.spawn` if initialization fails (ENOMEM).
+        public init() throws(POSIX.Kernel.Process.Error) {
+            let pointer = UnsafeMutablePointer<posix_spawnattr_t>.allocate(capacity: 1)
+            let rc = posix_spawnattr_init(pointer)
+            guard rc == 0 else {
+                pointer.deallocate()
+                throw .spawn(.posix(rc))
+            }
+            self.pointer = pointer
+        }
+
+        deinit {
+            _ = posix_spawnattr_destroy(pointer)
+            pointer.deallocate()
+        }
+    }
+}
+
+// MARK: - Flags
+
+extension POSIX.Kernel.Process.Spawn.Attributes {
+    /// Adds `flag` to the attribute flags (posix_spawnattr_getflags/setflags).
+    internal func enable(_ flag: Int32) throws(POSIX.Kernel.Process.Error) {
+        var flags: Int16 = 0
+        var rc = posix_spawnattr_getflags(pointer, &flags)
+        guard rc == 0 else {
+            throw .spawn(.posix(rc))
+        }
+        rc = posix_spawnattr_setflags(pointer, flags | Int16(truncatingIfNeeded: flag))
+        guard rc == 0 else {
+            throw .spawn(.posix(rc))
+        }
+    }
+}
+
+// MARK: - Attributes
+
+extension POSIX.Kernel.Process.Spawn.Attributes {
+    /// Places the child in a process group (POSIX_SPAWN_SETPGROUP).
+    ///
+    /// - Parameter target: `.same` makes the child leader of a new group
+    ///   (pgroup 0); `.id(pgid)` joins an existing group.
+    /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
+    ///
+    /// The group change happens before `exec`, so there is no window in
+    /// which the child runs in the parent's group.
+    public func group(_ target: POSIX.Kernel.Process.Group.Target) throws(POSIX.Kernel.Process.Error) {
+        let pgid: pid_t =
+            switch target {
+            case .same:
+                0
+            case .id(let id):
+                id.rawValue
+            }
+
+        let rc = posix_spawnattr_setpgroup(pointer, pgid)
+        guard rc == 0 else {
+            throw .spawn(.posix(rc))
+        }
+        try enable(POSIX_SPAWN_SETPGROUP)
+        steps.group(target)
+    }
+
+    /// Makes the child leader of a new session (POSIX_SPAWN_SETSID).
+    ///
+    /// Equivalent to calling `setsid()` in the child before `exec`.
+    ///
+    /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
+    ///
+    /// ## Platform Availability
+    ///
+    /// Darwin, glibc 2.26+ and musl. Older C libraries reject the flag and
+    /// `spawn` fails with EINVAL.
+    public func session() throws(POSIX.Kernel.Process.Error) {
+        try enable(Int32(swift_POSIX_SPAWN_SETSID()))
+        steps.session()
+    }
+
+    /// Sets the child's initial signal mask (POSIX_SPAWN_SETSIGMASK).
+    ///
+    /// Without this, the child inherits the spawning thread's mask.
+    ///
+    /// - Parameter signals: Signals blocked in the child.
+    /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
+    public func mask(_ signals: POSIX.Kernel.Signal.Set) throws(POSIX.Kernel.Process.Error) {
+        let rc = signals.withUnsafePointer { set in
+            posix_spawnattr_setsigmask(pointer, set)
+        }
+        guard rc == 0 else {
+            throw .spawn(.posix(rc))
+        }
+        try enable(POSIX_SPAWN_SETSIGMASK)
+        steps.mask(signals)
+    }
+
+    /// Resets signals to their default action in the child (POSIX_SPAWN_SETSIGDEF).
+    ///
+    /// Signals the parent ignores stay ignored across `exec` unless reset here.
+    ///
+    /// - Parameter signals: Signals reset to `SIG_DFL` in the child.
+    /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
+    public func reset(_ signals: POSIX.Kernel.Signal.Set) throws(POSIX.Kernel.Process.Error) {
+        let rc = signals.withUnsafePointer { set in
+            posix_spawnattr_setsigdefault(pointer, set)
+        }
+        guard rc == 0 else {
+            throw .spawn(.posix(rc))
+        }
+        try enable(POSIX_SPAWN_SETSIGDEF)
+        steps.reset(signals)
+    }
+
+    /// Closes every descriptor in the child except `kept` and stdio.
+    ///
+    /// Replaces per-descriptor `FileActions.close` lists and FD_CLOEXEC
+    /// audits: descriptors the parent opened without O_CLOEXEC, including
+    /// those opened by other threads concurrently, do not leak. Descriptors
+    /// targeted by `FileActions` are always kept.
+    ///
+    /// - Parameter kept: Descriptors that stay open, at the same number.
+    ///   Standard input, output and error are always kept. Set the policy
+    ///   once per instance.
+    /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
+    ///
+    /// ## Platform Behavior
+    ///
+    /// | Platform | Mechanism |
+    /// |----------|-----------|
+    /// | Darwin | POSIX_SPAWN_CLOEXEC_DEFAULT plus `addinherit_np` per kept descriptor |
+    /// | Linux | vfork engine: `close_range(CLOSE_RANGE_CLOEXEC)` per gap, /proc/self/fd scan before 5.11 |
+    ///
+    /// glibc and musl `posix_spawn` have no "close all except" action, so
+    /// on Linux `spawn` switches to `clone(CLONE_VM | CLONE_VFORK)`, the
+    /// same mechanism glibc uses internally, and runs these attributes and
+    /// the file actions as `Spawn.Steps`. On Darwin, passing file actions
+    /// together with this policy builds a merged action list per spawn.
+    public func close(except kept: [Kernel.Descriptor]) throws(POSIX.Kernel.Process.Error) {
+        let list = POSIX.Kernel.Process.Spawn.Steps.kept(kept)
+        #if canImport(Darwin)
+            try enable(POSIX_SPAWN_CLOEXEC_DEFAULT)
+            let inherit = try POSIX.Kernel.Process.Spawn.FileActions()
+            try inherit.inherit(list)
+            self.inherit = inherit
+        #endif
+        steps.close(except: kept)
+        self.kept = list
+        #if !canImport(Darwin)
+            stepped = true
+        #endif
+    }
+}
+
+// MARK: - Resources
+
+extension POSIX.Kernel.Process.Spawn.Attributes {
+    /// Sets a resource limit in the child before `exec` (setrlimit).
+    ///
+    /// - Parameters:
+    ///   - resource: The resource to limit, such as `.address` or `.files`.
+    ///   - soft: The enforced limit.
+    ///   - hard: The ceiling for `soft`. Raising it requires privilege.
+    ///
+    /// `posix_spawn` has no rlimit attribute, so `spawn` runs these
+    /// attributes in the vfork engine (`Spawn.Steps`). A failing limit
+    /// fails the spawn with its errno.
+    public func limit(_ resource: POSIX.Kernel.Process.Limit.Resource, soft: UInt64, hard: UInt64) {
+        steps.limit(resource, soft: soft, hard: hard)
+        stepped = true
+    }
+
+    /// Sets the child's nice value before `exec` (setpriority).
+    ///
+    /// - Parameter value: `-20` (most favourable) to `19`.
+    ///
+    /// Runs in the vfork engine, like `limit(_:soft:hard:)`.
+    public func nice(_ value: Int32) {
+        steps.nice(value)
+        stepped = true
+    }
+}
+
+// MARK: - Scheduling
+
+#if os(Linux)
+
+    extension POSIX.Kernel.Process.Spawn.Attributes {
+        /// Restricts the child to `affinity` before `exec` (sched_setaffinity).
+        ///
+        /// The child's first instruction already runs on an allowed CPU,
+        /// so no work lands on a shared core before it is moved.
+        /// Runs in the vfork engine, like `limit(_:soft:hard:)`.
+        public func affinity(_ affinity: POSIX.Kernel.Process.Affinity) {
+            steps.affinity(affinity)
+            stepped = true
+        }
+
+        /// Sets the child's scheduling policy and priority
+        /// (POSIX_SPAWN_SETSCHEDULER | POSIX_SPAWN_SETSCHEDPARAM).
+        ///
+        /// - Parameters:
+        ///   - policy: The policy.
+        ///   - priority: Within `policy.priorities`; 0 for non-real-time policies.
+        /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure. An
+        ///   unprivileged real-time request fails at `spawn` with EPERM.
+        public func scheduler(
+            _ policy: POSIX.Kernel.Process.Scheduler.Policy,
+            priority: Int32 = 0
+        ) throws(POSIX.Kernel.Process.Error) {
+            var rc = posix_spawnattr_setschedpolicy(pointer, policy.rawValue)
+            guard rc == 0 else {
+                throw .spawn(.posix(rc))
+            }
+            rc = swift_posix_spawnattr_setschedparam(pointer, priority)
+            guard rc == 0 else {
+                throw .spawn(.posix(rc))
+            }
+            try enable(POSIX_SPAWN_SETSCHEDULER | POSIX_SPAWN_SETSCHEDPARAM)
+            steps.scheduler(policy, priority: priority)
+        }
+
+        /// Starts the child in a cgroup v2 group (clone3 CLONE_INTO_CGROUP).
+        ///
+        /// The child is a member from creation, so even its first page
+        /// faults are charged to the group, and no `cgroup.procs` write
+        /// follows the spawn. The descriptor is read at each spawn and is
+        /// not closed; keep it open while the attributes are in use.
+        ///
+        /// - Parameter directory: The group's directory, opened with
+        ///   `O_RDONLY | O_DIRECTORY` (or `O_PATH`).
+        ///
+        /// Runs in the vfork engine through `clone3`, which also hands
+        /// `Handle.spawn` the child's pidfd. Failures surface from `spawn`:
+        ///
+        /// - ENOSYS: Kernel older than 5.7, a seccomp filter that rejects
+        ///   `clone3`, or an architecture other than x86_64 and arm64.
+        ///   Unlike stepped spawns without a cgroup, which fall back to
+        ///   `clone` on ENOSYS or EPERM, a cgroup placement has no fallback.
+        /// - EBUSY: The group has child groups with controllers enabled
+        ///   (the "no internal processes" rule).
+        /// - EOPNOTSUPP: The group is a threaded-domain group.
+        /// - EACCES/EPERM: No write access to the group's `cgroup.procs`.
+        public func cgroup(_ directory: Kernel.Descriptor) {
+            placement = directory.rawValue
+            stepped = true
+        }
+
+        /// Sets the child's static priority under its inherited policy
+        /// (POSIX_SPAWN_SETSCHEDPARAM).
+        ///
+        /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
+        public func priority(_ priority: Int32) throws(POSIX.Kernel.Process.Error) {
+            let rc = swift_posix_spawnattr_setschedparam(pointer, priority)
+            guard rc == 0 else {
+                throw .spawn(.posix(rc))
+            }
+            try enable(POSIX_SPAWN_SETSCHEDPARAM)
+            steps.priority(priority)
+        }
+    }
+
+#endif
@@ -0,0 +1,188 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    public import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    public import Glibc
+#elseif canImport(Musl)
+    public import Musl
+#endif
+
+extension POSIX.Kernel.Process.Spawn {
+    /// Descriptor actions performed in the child before the new program starts.
+    ///
+    /// Wraps `posix_spawn_file_actions_t`. Actions run in the order they were
+    /// added, after the child is created and before `exec`.
+    ///
+    /// ## Reuse
+    ///
+    /// The underlying object is initialized once and handed to every spawn by
+    /// pointer. Build it once and reuse it across spawns; per-spawn cost is
+    /// only the `posix_spawn` syscall.
+    ///
+    /// ## Thread Safety
+    ///
+    /// Adding actions is NOT synchronized. Finish configuring before sharing
+    /// the instance; concurrent spawns that only read a configured instance
+    /// are safe (`posix_spawn` takes it by const pointer).
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let actions = try POSIX.Kernel.Process.Spawn.FileActions()
+    /// try actions.duplicate(pipeWrite, to: Kernel.Descriptor(rawValue: STDOUT_FILENO))
+    /// try actions.close(pipeRead)
+    ///
+    /// let child = try POSIX.Kernel.Process.Spawn.spawn(
+    ///     path: path,
+    ///     argv: argv,
+    ///     envp: envp,
+    ///     fileActions: actions
+    /// )
+    /// ```
+    public final class FileActions: @unchecked Sendable {
+        /// The initialized `posix_spawn_file_actions_t` (owned).
+        internal let pointer: UnsafeMutablePointer<posix_spawn_file_actions_t>
+
+        /// The same actions as pre-exec steps, for spawns that cannot use
+        /// `pointer` (see `Attributes.close(except:)`).
+        internal let steps = POSIX.Kernel.Process.Spawn.Steps()
+
+        /// Creates an empty action list.
+        ///
+        /// - Throws: `POSIX.Kernel.Process.Error.spawn` if initialization fails (ENOMEM).
+        public init() throws(POSIX.Kernel.Process.Error) {
+            let pointer = UnsafeMutablePointer<posix_spawn_file_actions_t>.allocate(capacity: 1)
+            let rc = posix_spawn_file_actions_init(pointer)
+            guard rc == 0 else {
+                pointer.deallocate()
+                throw .spawn(.posix(rc))
+            }
+            self.pointer = pointer
+        }
+
+        deinit {
+            _ = posix_spawn_file_actions_destroy(pointer)
+            pointer.deallocate()
+        }
+    }
+}
+
+// MARK: - Actions
+
+extension POSIX.Kernel.Process.Spawn.FileActions {
+    /// Duplicates `source` onto `target` in the child (dup2).
+    ///
+    /// - Parameters:
+    ///   - source: Descriptor open in the parent.
+    ///   - target: Descriptor number it should occupy in the child.
+    /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
+    ///
+    /// ## Common Errors
+    ///
+    /// - EBADF: A descriptor is negative or above `OPEN_MAX`.
+    /// - ENOMEM: Insufficient memory to record the action.
+    public func duplicate(
+        _ source: Kernel.Descriptor,
+        to target: Kernel.Descriptor
+    ) throws(POSIX.Kernel.Process.Error) {
+        let rc = posix_spawn_file_actions_adddup2(pointer, source.rawValue, target.rawValue)
+        guard rc == 0 else {
+            throw .spawn(.posix(rc))
+        }
+        steps.duplicate(source, to: target)
+    }
+
+    /// Opens `path` onto `target` in the child (open + dup2).
+    ///
+    /// The path is copied when the action is added; the caller's buffer
+    /// need not outlive this call.
+    ///
+    /// - Parameters:
+    ///   - target: Descriptor number the opened file should occupy in the child.
+    ///   - path: Path to open (null-terminated C string).
+    ///   - flags: `open(2)` flags (`O_RDONLY`, `O_WRONLY | O_CREAT`, ...).
+    ///   - mode: Permission bits used when `O_CREAT` creates the file.
+    /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
+    ///
+    /// Errors from the `open` itself are reported by `spawn`, not here.
+    public func open(
+        _ target: Kernel.Descriptor,
+        path: UnsafePointer<CChar>,
+        flags: Int32,
+        mode: mode_t = 0
+    ) throws(POSIX.Kernel.Process.Error) {
+        let rc = posix_spawn_file_actions_addopen(pointer, target.rawValue, path, flags, mode)
+        guard rc == 0 else {
+            throw .spawn(.posix(rc))
+        }
+        steps.open(target, path: path, flags: flags, mode: mode)
+    }
+
+    /// Closes `descriptor` in the child.
+    ///
+    /// - Parameter descriptor: Descriptor to close.
+    /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
+    public func close(_ descriptor: Kernel.Descriptor) throws(POSIX.Kernel.Process.Error) {
+        let rc = posix_spawn_file_actions_addclose(pointer, descriptor.rawValue)
+        guard rc == 0 else {
+            throw .spawn(.posix(rc))
+        }
+        steps.close(from: descriptor, through: descriptor)
+    }
+}
+
+#if canImport(Darwin)
+    // MARK: - Inherit
+
+    extension POSIX.Kernel.Process.Spawn.FileActions {
+        /// Keeps `descriptors` open under POSIX_SPAWN_CLOEXEC_DEFAULT
+        /// (posix_spawn_file_actions_addinherit_np).
+        internal func inherit(_ descriptors: [Int32]) throws(POSIX.Kernel.Process.Error) {
+            for descriptor in descriptors {
+                let rc = posix_spawn_file_actions_addinherit_np(pointer, descriptor)
+                guard rc == 0 else {
+                    throw .spawn(.posix(rc))
+                }
+            }
+        }
+
+        /// Appends the actions recorded in `other`, in order.
+        internal func append(contentsOf other: POSIX.Kernel.Process.Spawn.FileActions) throws(POSIX.Kernel.Process.Error) {
+            for index in 0..<other.steps.count {
+                let step = other.steps.pointer[index]
+                let rc: Int32
+                switch Int(step.kind) {
+                case Int(SWIFT_STEP_DUP2):
+                    rc = posix_spawn_file_actions_adddup2(pointer, step.first, step.second)
+                case Int(SWIFT_STEP_OPEN):
+                    rc = posix_spawn_file_actions_addopen(
+                        pointer,
+                        step.first,
+                        step.pointer.assumingMemoryBound(to: CChar.self),
+                        step.second,
+                        mode_t(truncatingIfNeeded: step.flags)
+                    )
+                default:
+                    rc = posix_spawn_file_actions_addclose(pointer, step.first)
+                }
+                guard rc == 0 else {
+                    throw .spawn(.posix(rc))
+                }
+            }
+        }
+    }
+#endif
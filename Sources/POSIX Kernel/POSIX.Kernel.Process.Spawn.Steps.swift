@@ -0,0 +1,390 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    public import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    public import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    public import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Process.Spawn {
+    /// A pre-exec step list for vfork-mode spawns.
+    ///
+    /// Steps run in order in a child that shares the parent's address space:
+    /// `clone(CLONE_VM | CLONE_VFORK)` on a private stack on Linux, `vfork`
+    /// on Darwin. No page tables are copied, so spawn cost does not depend
+    /// on parent RSS, unlike `Fork.fork`. The step interpreter is C in
+    /// `CPOSIXProcessShim` and makes only async-signal-safe syscalls. No
+    /// Swift code runs in the child.
+    ///
+    /// ## Steps
+    ///
+    /// | Method | Child syscall |
+    /// |--------|---------------|
+    /// | `duplicate(_:to:)` | `dup2` (clears FD_CLOEXEC if source == target) |
+    /// | `open(_:path:flags:mode:)` | `open` + `dup2` |
+    /// | `directory(_:)` | `chdir` |
+    /// | `group(_:)` | `setpgid(0, pgid)` |
+    /// | `session()` | `setsid` |
+    /// | `close(from:through:)` | `close_range`, or a close loop |
+    /// | `close(except:)` | `close_range(CLOSE_RANGE_CLOEXEC)` per gap |
+    /// | `reset(_:)` | `sigaction(SIG_DFL)` per signal |
+    /// | `mask(_:)` | signal mask installed just before `execve` |
+    /// | `limit(_:soft:hard:)` | `setrlimit` |
+    /// | `nice(_:)` | `setpriority(PRIO_PROCESS, 0, value)` |
+    /// | `affinity(_:)` | `sched_setaffinity` (Linux) |
+    /// | `scheduler(_:priority:)` | `sched_setscheduler` (Linux) |
+    /// | `priority(_:)` | `sched_setparam` (Linux) |
+    ///
+    /// `Fork.fork(preparing:)` runs the same list in a child that does not
+    /// exec: there `close(except:)` closes outright and `mask(_:)` is
+    /// installed after the last step.
+    ///
+    /// ## Signals
+    ///
+    /// The spawning thread blocks every signal across the vfork. In the
+    /// child, every caught signal is reset to SIG_DFL before the first step,
+    /// so a parent handler never runs on the shared address space. The
+    /// child execs with the caller's mask unless `mask(_:)` replaces it.
+    ///
+    /// ## Reuse
+    ///
+    /// Like `FileActions`, build once and pass to many spawns. Builders are
+    /// not synchronized; concurrent spawns that only read the list are safe.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let steps = POSIX.Kernel.Process.Spawn.Steps()
+    /// steps.duplicate(log, to: Kernel.Descriptor(rawValue: STDOUT_FILENO))
+    /// steps.directory("/srv/sandbox")
+    /// steps.session()
+    /// steps.limit(.files, soft: 1024, hard: 1024)
+    /// steps.close(from: Kernel.Descriptor(rawValue: 3))
+    ///
+    /// let child = try POSIX.Kernel.Process.Spawn.spawn(path: path, argv: argv, envp: envp, steps: steps)
+    /// ```
+    public final class Steps: @unchecked Sendable {
+        /// The step array handed to `swift_vfork_spawn`.
+        internal private(set) var pointer: UnsafeMutablePointer<swift_spawn_step>
+
+        /// Number of steps.
+        public private(set) var count: Int = 0
+
+        private var capacity: Int
+
+        /// Paths and signal sets referenced by steps (owned).
+        private var owned: [UnsafeMutableRawPointer] = []
+
+        /// Creates an empty step list.
+        public init() {
+            self.capacity = 8
+            self.pointer = .allocate(capacity: capacity)
+        }
+
+        deinit {
+            pointer.deinitialize(count: count)
+            pointer.deallocate()
+            for allocation in owned {
+                allocation.deallocate()
+            }
+        }
+    }
+}
+
+// MARK: - Builders
+
+extension POSIX.Kernel.Process.Spawn.Steps {
+    /// Duplicates `source` onto `target` (dup2).
+    ///
+    /// If `source == target`, clears FD_CLOEXEC so the descriptor survives exec.
+    public func duplicate(_ source: Kernel.Descriptor, to target: Kernel.Descriptor) {
+        append(Int32(SWIFT_STEP_DUP2), first: source.rawValue, second: target.rawValue)
+    }
+
+    /// Opens `path` onto `target` (open + dup2).
+    ///
+    /// - Parameters:
+    ///   - target: Descriptor number the opened file should occupy.
+    ///   - path: Copied; the caller's buffer need not outlive the list.
+    ///   - flags: `open(2)` flags.
+    ///   - mode: Permission bits used when `O_CREAT` creates the file.
+    public func open(
+        _ target: Kernel.Descriptor,
+        path: UnsafePointer<CChar>,
+        flags: Int32,
+        mode: mode_t = 0
+    ) {
+        let bytes = strlen(path) + 1
+        let copy = UnsafeMutableRawPointer.allocate(byteCount: bytes, alignment: 1)
+        copy.copyMemory(from: path, byteCount: bytes)
+        owned.append(copy)
+        append(
+            Int32(SWIFT_STEP_OPEN),
+            first: target.rawValue,
+            second: flags,
+            flags: Int32(truncatingIfNeeded: mode),
+            pointer: UnsafeRawPointer(copy)
+        )
+    }
+
+    /// Changes the working directory (chdir).
+    ///
+    /// - Parameter path: Copied; the caller's string need not outlive the list.
+    public func directory(_ path: String) {
+        let bytes = path.utf8.count + 1
+        let copy = UnsafeMutableRawPointer.allocate(byteCount: bytes, alignment: 1)
+        path.withCString { copy.copyMemory(from: $0, byteCount: bytes) }
+        owned.append(copy)
+        append(Int32(SWIFT_STEP_CHDIR), pointer: UnsafeRawPointer(copy))
+    }
+
+    /// Places the child in a process group (setpgid).
+    ///
+    /// - Parameter target: `.same` for a new group led by the child;
+    ///   `.id(pgid)` to join an existing group.
+    public func group(_ target: POSIX.Kernel.Process.Group.Target) {
+        let pgid: pid_t =
+            switch target {
+            case .same:
+                0
+            case .id(let id):
+                id.rawValue
+            }
+        append(Int32(SWIFT_STEP_SETPGID), first: pgid)
+    }
+
+    /// Makes the child leader of a new session (setsid).
+    public func session() {
+        append(Int32(SWIFT_STEP_SETSID))
+    }
+
+    /// Closes descriptors `first` through `last` (close_range).
+    ///
+    /// - Parameters:
+    ///   - first: Lowest descriptor to close.
+    ///   - last: Highest descriptor to close, or `nil` for all above `first`.
+    ///
+    /// Uses `close_range(2)` on Linux 5.9+, then a /proc/self/fd scan;
+    /// otherwise a loop bounded by RLIMIT_NOFILE (`getrlimit`).
+    public func close(from first: Kernel.Descriptor, through last: Kernel.Descriptor? = nil) {
+        append(Int32(SWIFT_STEP_CLOSE_RANGE), first: first.rawValue, second: last?.rawValue ?? -1)
+    }
+
+    /// Closes every descriptor except `kept` and standard input, output and error.
+    ///
+    /// Descriptors are marked close-on-exec rather than closed, so later
+    /// steps can still use them; the kernel closes them at `execve`.
+    /// Under `Fork.fork(preparing:)`, where no `execve` follows, they are
+    /// closed at once instead. `kept` is sorted and copied when the step
+    /// is added.
+    ///
+    /// Uses one `close_range(CLOSE_RANGE_CLOEXEC)` per gap between kept
+    /// descriptors (Linux 5.11+). Older kernels scan /proc/self/fd, so the
+    /// cost follows the number of open descriptors, not RLIMIT_NOFILE;
+    /// Darwin uses a loop bounded by RLIMIT_NOFILE.
+    public func close(except kept: [Kernel.Descriptor]) {
+        let list = POSIX.Kernel.Process.Spawn.Steps.kept(kept)
+        let copy = UnsafeMutablePointer<Int32>.allocate(capacity: list.count)
+        copy.initialize(from: list, count: list.count)
+        owned.append(UnsafeMutableRawPointer(copy))
+        append(Int32(SWIFT_STEP_CLOSE_EXCEPT), first: Int32(list.count), pointer: UnsafeRawPointer(copy))
+    }
+
+    /// `kept` plus stdio, sorted, without duplicates or negative numbers.
+    internal static func kept(_ kept: [Kernel.Descriptor]) -> [Int32] {
+        var list: [Int32] = [0, 1, 2]
+        list.reserveCapacity(kept.count + 3)
+        for descriptor in kept where descriptor.rawValue > 2 {
+            list.append(descriptor.rawValue)
+        }
+        list.sort()
+        var unique = 0
+        for index in list.indices where index == 0 || list[index] != list[unique - 1] {
+            list[unique] = list[index]
+            unique += 1
+        }
+        list.removeLast(list.count - unique)
+        return list
+    }
+
+    /// Resets `signals` to their default action (SIG_DFL).
+    ///
+    /// Caught signals are always reset; use this for signals the parent
+    /// ignores, which otherwise stay ignored across exec.
+    public func reset(_ signals: POSIX.Kernel.Signal.Set) {
+        append(Int32(SWIFT_STEP_SIGNAL_RESET), pointer: retain(signals))
+    }
+
+    /// Sets the signal mask the child execs with.
+    ///
+    /// Under `Fork.fork(preparing:)`, the mask the child returns with.
+    public func mask(_ signals: POSIX.Kernel.Signal.Set) {
+        append(Int32(SWIFT_STEP_SIGNAL_MASK), pointer: retain(signals))
+    }
+
+    /// Sets a resource limit (setrlimit).
+    ///
+    /// - Parameters:
+    ///   - resource: The resource to limit.
+    ///   - soft: The enforced limit.
+    ///   - hard: The ceiling for `soft`. Raising it requires privilege.
+    ///     Use `Limit.infinity` for no limit.
+    public func limit(_ resource: POSIX.Kernel.Process.Limit.Resource, soft: UInt64, hard: UInt64) {
+        append(Int32(SWIFT_STEP_RLIMIT), first: resource.rawValue, soft: soft, hard: hard)
+    }
+
+    /// Sets the nice value (setpriority).
+    ///
+    /// - Parameter value: `-20` (most favourable) to `19`. Lowering it
+    ///   below the parent's requires CAP_SYS_NICE or RLIMIT_NICE.
+    public func nice(_ value: Int32) {
+        append(Int32(SWIFT_STEP_NICE), first: value)
+    }
+}
+
+#if os(Linux)
+
+    extension POSIX.Kernel.Process.Spawn.Steps {
+        /// Restricts the child to `affinity` (sched_setaffinity).
+        ///
+        /// - Parameter affinity: Copied when the step is added.
+        public func affinity(_ affinity: POSIX.Kernel.Process.Affinity) {
+            let bytes = affinity.words.count * MemoryLayout<UInt64>.stride
+            let copy = UnsafeMutableRawPointer.allocate(byteCount: bytes, alignment: MemoryLayout<UInt64>.alignment)
+            affinity.words.withUnsafeBytes { copy.copyMemory(from: $0.baseAddress!, byteCount: bytes) }
+            owned.append(copy)
+            append(Int32(SWIFT_STEP_AFFINITY), first: Int32(bytes), pointer: UnsafeRawPointer(copy))
+        }
+
+        /// Sets the scheduling policy and static priority (sched_setscheduler).
+        ///
+        /// - Parameters:
+        ///   - policy: The policy.
+        ///   - priority: Within `policy.priorities`; 0 for non-real-time policies.
+        public func scheduler(_ policy: POSIX.Kernel.Process.Scheduler.Policy, priority: Int32 = 0) {
+            append(Int32(SWIFT_STEP_SCHEDULER), first: policy.rawValue, second: priority)
+        }
+
+        /// Sets the static priority under the inherited policy (sched_setparam).
+        public func priority(_ priority: Int32) {
+            append(Int32(SWIFT_STEP_SCHEDULER), first: -1, second: priority)
+        }
+    }
+
+#endif
+
+// MARK: - Storage
+
+extension POSIX.Kernel.Process.Spawn.Steps {
+    private func append(
+        _ kind: Int32,
+        first: Int32 = 0,
+        second: Int32 = 0,
+        flags: Int32 = 0,
+        soft: UInt64 = 0,
+        hard: UInt64 = 0,
+        pointer referenced: UnsafeRawPointer? = nil
+    ) {
+        if count == capacity {
+            let grown = UnsafeMutablePointer<swift_spawn_step>.allocate(capacity: capacity * 2)
+            grown.moveInitialize(from: pointer, count: count)
+            pointer.deallocate()
+            pointer = grown
+            capacity *= 2
+        }
+
+        (pointer + count).initialize(
+            to: swift_spawn_step(
+                kind: kind,
+                first: first,
+                second: second,
+                flags: flags,
+                soft: soft,
+                hard: hard,
+                pointer: referenced
+            )
+        )
+        count += 1
+    }
+
+    /// Copies a signal set into owned storage.
+    private func retain(_ signals: POSIX.Kernel.Signal.Set) -> UnsafeRawPointer {
+        let copy = UnsafeMutablePointer<sigset_t>.allocate(capacity: 1)
+        copy.initialize(to: signals.storage)
+        owned.append(UnsafeMutableRawPointer(copy))
+        return UnsafeRawPointer(copy)
+    }
+}
+
+// MARK: - Spawn
+
+extension POSIX.Kernel.Process.Spawn {
+    /// Spawns a program after running a pre-exec step list in a vfork child.
+    ///
+    /// Opt-in alternative to `posix_spawn` for setup that file actions and
+    /// attributes cannot express. The cost does not depend on parent RSS.
+    ///
+    /// - Parameters:
+    ///   - path: Path to the executable.
+    ///   - argv: Argument vector (NULL-terminated).
+    ///   - envp: Environment vector (NULL-terminated).
+    ///   - steps: Steps run in the child, in order, before `execve`.
+    /// - Returns: The process ID of the child, which has already exec'd.
+    /// - Throws: `POSIX.Kernel.Process.Error.spawn` with the errno of the
+    ///   first failing step or of `execve`. A child that failed has already
+    ///   been reaped.
+    ///
+    /// ## Thread Safety
+    ///
+    /// Safe from multithreaded processes: only the calling thread is
+    /// suspended while the child runs its steps.
+    public static func spawn(
+        path: UnsafePointer<CChar>,
+        argv: UnsafePointer<UnsafePointer<CChar>?>,
+        envp: UnsafePointer<UnsafePointer<CChar>?>,
+        steps: Steps
+    ) throws(POSIX.Kernel.Process.Error) -> Kernel.Process.ID {
+        var error: Int32 = 0
+        var failed: Int32 = 0
+
+        let start = POSIX.Kernel.Trace.start()
+        let pid = withExtendedLifetime(steps) {
+            swift_vfork_spawn(path, argv, envp, steps.pointer, Int32(steps.count), &error, &failed)
+        }
+
+        guard pid > 0 else {
+            throw .spawn(.posix(error))
+        }
+        POSIX.Kernel.Trace.finish(.spawn, since: start, pid: pid)
+        return Kernel.Process.ID(pid)
+    }
+
+    /// Spawns `arguments.path` with a pre-exec step list.
+    ///
+    /// Same semantics as `spawn(path:argv:envp:steps:)`.
+    public static func spawn(
+        _ arguments: Arguments,
+        steps: Steps
+    ) throws(POSIX.Kernel.Process.Error) -> Kernel.Process.ID {
+        try withExtendedLifetime(arguments) { () throws(POSIX.Kernel.Process.Error) in
+            try spawn(path: arguments.path, argv: arguments.argv, envp: arguments.envp, steps: steps)
+        }
+    }
+}
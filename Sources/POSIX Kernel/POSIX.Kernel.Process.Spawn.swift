@@ -41,6 +41,8 @@ extension POSIX.Kernel.Process.Spawn {
     ///   - path: Path to the executable (null-terminated C string).
     ///   - argv: Argument vector (null-terminated array of C strings).
     ///   - envp: Environment vector (null-terminated array of C strings).
+    ///   - fileActions: Descriptor actions run in the child before `exec`, or `nil`.
+    ///   - attributes: Process attributes applied to the child, or `nil`.
     /// - Returns: The process ID of the spawned child.
     /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
     ///
@@ -76,21 +78,87 @@ extension POSIX.Kernel.Process.Spawn {
     ///
     /// let result = try Kernel.Process.Wait.wait(.process(child))
     /// ```
+    ///
+    /// ## Redirection and Attributes
+    ///
+    /// `FileActions` and `Attributes` are built once and reused; passing them
+    /// adds no per-spawn work beyond the syscall.
+    ///
+    /// ```swift
+    /// let actions = try POSIX.Kernel.Process.Spawn.FileActions()
+    /// try actions.duplicate(logFile, to: Kernel.Descriptor(rawValue: STDOUT_FILENO))
+    ///
+    /// let attributes = try POSIX.Kernel.Process.Spawn.Attributes()
+    /// try attributes.group(.same)
+    ///
+    /// for _ in 0..<workers {
+    ///     _ = try POSIX.Kernel.Process.Spawn.spawn(
+    ///         path: path,
+    ///         argv: argv,
+    ///         envp: envp,
+    ///         fileActions: actions,
+    ///         attributes: attributes
+    ///     )
+    /// }
+    /// ```
+    ///
+    /// ## Reusable Arguments
+    ///
+    /// `Kernel.Path.scope.array` allocates every string and the pointer array
+    /// on each call. For hot loops, build a `Spawn.Arguments` arena once and
+    /// call `spawn(_:fileActions:attributes:)`.
+    ///
+    /// ## Closing Inherited Descriptors
+    ///
+    /// `Attributes.close(except:)` closes everything but stdio and a kept
+    /// list in the child. On Linux it routes the spawn through the vfork
+    /// engine (`Spawn.Steps`) because `posix_spawn` cannot express it.
+    /// So do `Attributes.limit`, `nice`, `affinity` and `cgroup`.
     public static func spawn(
         path: UnsafePointer<CChar>,
         argv: UnsafePointer<UnsafePointer<CChar>?>,
-        envp: UnsafePointer<UnsafePointer<CChar>?>
+        envp: UnsafePointer<UnsafePointer<CChar>?>,
+        fileActions: FileActions? = nil,
+        attributes: Attributes? = nil
+    ) throws(POSIX.Kernel.Process.Error) -> Kernel.Process.ID {
+        let start = POSIX.Kernel.Trace.start()
+        let pid = try launch(path: path, argv: argv, envp: envp, fileActions: fileActions, attributes: attributes)
+        POSIX.Kernel.Trace.finish(.spawn, since: start, pid: pid.rawValue)
+        return pid
+    }
+
+    /// `spawn` without the trace hook, routed by attributes.
+    private static func launch(
+        path: UnsafePointer<CChar>,
+        argv: UnsafePointer<UnsafePointer<CChar>?>,
+        envp: UnsafePointer<UnsafePointer<CChar>?>,
+        fileActions: FileActions?,
+        attributes: Attributes?
     ) throws(POSIX.Kernel.Process.Error) -> Kernel.Process.ID {
+        if let attributes {
+            if attributes.stepped {
+                return try spawn(path: path, argv: argv, envp: envp, fileActions: fileActions, stepping: attributes)
+            }
+            #if canImport(Darwin)
+                if attributes.kept != nil {
+                    return try spawn(path: path, argv: argv, envp: envp, fileActions: fileActions, closing: attributes)
+                }
+            #endif
+        }
+
         var pid: pid_t = 0
 
-        let rc = swift_posix_spawn(
-            &pid,
-            path,
-            nil,  // file_actions
-            nil,  // attrp
-            argv,
-            envp
-        )
+        // Keep the owners alive until posix_spawn has read their pointers
+        let rc = withExtendedLifetime((fileActions, attributes)) {
+            swift_posix_spawn(
+                &pid,
+                path,
+                fileActions?.pointer,
+                attributes?.pointer,
+                argv,
+                envp
+            )
+        }
 
         // posix_spawn returns the error code directly (not via errno)
         guard rc == 0 else {
@@ -100,3 +168,89 @@ extension POSIX.Kernel.Process.Spawn {
         return Kernel.Process.ID(pid)
     }
 }
+
+// MARK: - Close Except
+
+#if canImport(Darwin)
+
+    extension POSIX.Kernel.Process.Spawn {
+        /// `spawn` for attributes carrying a `close(except:)` policy.
+        private static func spawn(
+            path: UnsafePointer<CChar>,
+            argv: UnsafePointer<UnsafePointer<CChar>?>,
+            envp: UnsafePointer<UnsafePointer<CChar>?>,
+            fileActions: FileActions?,
+            closing attributes: Attributes
+        ) throws(POSIX.Kernel.Process.Error) -> Kernel.Process.ID {
+            // POSIX_SPAWN_CLOEXEC_DEFAULT closes everything not inherited
+            // through the action list, so the kept list joins the actions
+            let actions: FileActions?
+            if let fileActions {
+                let merged = try FileActions()
+                try merged.inherit(attributes.kept ?? [])
+                try merged.append(contentsOf: fileActions)
+                actions = merged
+            } else {
+                actions = attributes.inherit
+            }
+
+            var pid: pid_t = 0
+            let rc = withExtendedLifetime((actions, attributes)) {
+                swift_posix_spawn(&pid, path, actions?.pointer, attributes.pointer, argv, envp)
+            }
+            guard rc == 0 else {
+                throw .spawn(.posix(rc))
+            }
+            return Kernel.Process.ID(pid)
+        }
+    }
+
+#endif
+
+// MARK: - Stepped
+
+extension POSIX.Kernel.Process.Spawn {
+    /// `spawn` for attributes that `posix_spawn` cannot express.
+    ///
+    /// - Parameter pidfd: Receives the child's pidfd from `clone3`, or -1
+    ///   if the kernel has no `clone3`. Linux only; ignored on Darwin.
+    internal static func spawn(
+        path: UnsafePointer<CChar>,
+        argv: UnsafePointer<UnsafePointer<CChar>?>,
+        envp: UnsafePointer<UnsafePointer<CChar>?>,
+        fileActions: FileActions?,
+        stepping attributes: Attributes,
+        pidfd: UnsafeMutablePointer<Int32>? = nil
+    ) throws(POSIX.Kernel.Process.Error) -> Kernel.Process.ID {
+        #if os(Linux)
+            let cgroup = attributes.placement
+        #else
+            let cgroup: Int32 = -1
+        #endif
+
+        // CLOSE_EXCEPT only marks descriptors close-on-exec, so the file
+        // action steps after it can still read their sources, and the
+        // targets they create are not close-on-exec
+        var error: Int32 = 0
+        var failed: Int32 = 0
+        let pid = withExtendedLifetime((fileActions, attributes)) {
+            swift_vfork_spawn_clone(
+                path,
+                argv,
+                envp,
+                attributes.steps.pointer,
+                Int32(attributes.steps.count),
+                fileActions?.steps.pointer,
+                Int32(fileActions?.steps.count ?? 0),
+                cgroup,
+                pidfd,
+                &error,
+                &failed
+            )
+        }
+        guard pid > 0 else {
+            throw .spawn(.posix(error))
+        }
+        return Kernel.Process.ID(pid)
+    }
+}
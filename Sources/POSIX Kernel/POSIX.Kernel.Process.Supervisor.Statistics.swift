@@ -0,0 +1,131 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+// MARK: - Statistics
+
+extension POSIX.Kernel.Process.Supervisor {
+    /// Counters and latency histograms of a supervisor's loop.
+    ///
+    /// The loop publishes a snapshot once per iteration. Counters only grow;
+    /// sample twice and divide by the interval for throughput.
+    public struct Statistics: Sendable, Equatable {
+        /// Children spawned, restarts included.
+        public var spawned: Int = 0
+
+        /// Restarts scheduled by a policy.
+        public var restarted: Int = 0
+
+        /// Children reaped.
+        public var exited: Int = 0
+
+        /// Spawns and waits that failed.
+        public var failed: Int = 0
+
+        /// Records read from the signal stream.
+        public var signals: Int = 0
+
+        /// Times the loop woke from its poller.
+        public var iterations: Int = 0
+
+        /// Most spawns made in one iteration.
+        public var largestBatch: Int = 0
+
+        /// Children running at the last snapshot.
+        public var running: Int = 0
+
+        /// Children waiting for a start: new, due for restart, or backing off.
+        public var queued: Int = 0
+
+        /// Nanoseconds from spawn submit to return, pidfd or kqueue included.
+        public var spawn = Histogram()
+
+        /// Nanoseconds from the poller reporting an exit to the child being
+        /// reaped; grows with the number of exits handled per iteration.
+        public var reap = Histogram()
+
+        public init() {}
+    }
+}
+
+// MARK: - Histogram
+
+extension POSIX.Kernel.Process.Supervisor {
+    /// A log2 histogram of nanosecond latencies.
+    ///
+    /// Bucket `i` counts values in `[2^i, 2^(i+1))`, and zero lands in
+    /// bucket 0, so 64 buckets cover every `UInt64`. Recording is a
+    /// leading-zero count and an increment.
+    ///
+    /// The buckets are stored inline, so copying a histogram (as each
+    /// published snapshot does) never shares a heap buffer that the next
+    /// `record` would have to copy.
+    public struct Histogram: Sendable, Equatable {
+        /// Counts per power of two.
+        public private(set) var buckets = InlineArray<64, UInt64>(repeating: 0)
+
+        /// Values recorded.
+        public private(set) var count: UInt64 = 0
+
+        /// Sum of the values recorded, wrapping.
+        public private(set) var total: UInt64 = 0
+
+        /// Largest value recorded.
+        public private(set) var maximum: UInt64 = 0
+
+        public init() {}
+
+        /// Records one value.
+        public mutating func record(_ nanoseconds: UInt64) {
+            let index = nanoseconds == 0 ? 0 : UInt64.bitWidth - 1 - nanoseconds.leadingZeroBitCount
+            buckets[index] += 1
+            count += 1
+            total &+= nanoseconds
+            maximum = Swift.max(maximum, nanoseconds)
+        }
+
+        /// Mean of the values recorded; 0 when empty.
+        public var mean: UInt64 {
+            count == 0 ? 0 : total / count
+        }
+
+        /// An upper bound on the `fraction` quantile (0.5 for the median).
+        ///
+        /// The top of the bucket that holds it, capped at `maximum`; within
+        /// a factor of two of the exact value. 0 when empty.
+        public func percentile(_ fraction: Double) -> UInt64 {
+            guard count > 0 else { return 0 }
+            let rank = Swift.max(1, UInt64((Double(count) * Swift.min(Swift.max(fraction, 0), 1)).rounded(.up)))
+            var seen: UInt64 = 0
+            for index in buckets.indices {
+                seen += buckets[index]
+                if seen >= rank {
+                    let top = index == 63 ? UInt64.max : (UInt64(1) << (index + 1)) - 1
+                    return Swift.min(top, maximum)
+                }
+            }
+            return maximum
+        }
+
+        // InlineArray is not Equatable
+        public static func == (lhs: Self, rhs: Self) -> Bool {
+            guard lhs.count == rhs.count, lhs.total == rhs.total, lhs.maximum == rhs.maximum else {
+                return false
+            }
+            for index in lhs.buckets.indices where lhs.buckets[index] != rhs.buckets[index] {
+                return false
+            }
+            return true
+        }
+    }
+}
@@ -0,0 +1,671 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+internal import Synchronization
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Process {
+    /// A restart-policy supervisor for many children, driven by one loop.
+    ///
+    /// `run()` owns the calling thread. It sleeps in one epoll (Linux) or
+    /// kqueue (Darwin) instance watching every child's `Handle` descriptor,
+    /// an optional `Signal.Stream` and a wake pipe. Each wakeup reaps the
+    /// exited, schedules restarts, and spawns up to `batch` children while
+    /// fewer than `limit` run. No SIGCHLD handler and no per-child thread.
+    ///
+    /// | Piece | Mechanism |
+    /// |-------|-----------|
+    /// | Spawn | `Handle.spawn` from reusable `Spawn.Arguments` |
+    /// | Exit | handle readable, then `Wait.wait(handle, .no.hang)` |
+    /// | Restart | `Policy`: exponential backoff, reset after a stable run |
+    /// | Shutdown | `Signal.Send.toAll` over handles, SIGKILL after the grace period |
+    ///
+    /// ## Threads
+    ///
+    /// `add`, `stop`, `shutdown` and `statistics` may be called from any
+    /// thread. They queue a command and wake the loop. Children, queues and
+    /// counters are touched only by the loop, without locks.
+    ///
+    /// ## Signals
+    ///
+    /// With `signals`, SIGTERM and SIGINT read from the stream begin a
+    /// shutdown that forwards that signal. Every record is reported as an
+    /// `Event.signal`. Create the stream before starting other threads, so
+    /// that they inherit the blocked mask.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// var signals = POSIX.Kernel.Signal.Set()
+    /// try signals.insert(.terminate)
+    /// try signals.insert(.interrupt)
+    /// let stream = try POSIX.Kernel.Signal.Stream(signals)
+    /// let supervisor = try POSIX.Kernel.Process.Supervisor(limit: 512, signals: stream) { event in
+    ///     log(event)
+    /// }
+    /// for index in 0..<2_000 {
+    ///     let arguments = POSIX.Kernel.Process.Spawn.Arguments(["/usr/bin/worker", "\(index)"])
+    ///     supervisor.add(arguments, policy: .init(restart: .onFailure))
+    /// }
+    /// try supervisor.run()    // returns once a shutdown has reaped every child
+    /// ```
+    public final class Supervisor: @unchecked Sendable {
+        /// Most children running at once.
+        public let limit: Int
+
+        /// Most spawns per loop iteration, so exits are not starved.
+        public let batch: Int
+
+        /// How long a signal-triggered shutdown waits before SIGKILL.
+        public let grace: Duration
+
+        private let poller: Int32
+        private let wake: (read: Kernel.Descriptor, write: Kernel.Descriptor)
+        private let signals: POSIX.Kernel.Signal.Stream?
+        private let events: Handler?
+
+        private let inbox = Mutex(Inbox())
+        private let published = Mutex(Statistics())
+        private let running = Atomic<Bool>(false)
+
+        // Loop state: only `run` touches these.
+        private var slots: [Slot] = []
+        private var ready: [Int] = []
+        private var readyHead = 0
+        /// Backing-off restarts, latest due first, so the next is `last`.
+        private var delayed: [(due: ContinuousClock.Instant, slot: Int)] = []
+        private var live = 0
+        private var stopping: Stopping?
+        private var counters = Statistics()
+        private let clock = ContinuousClock()
+
+        /// Creates a supervisor with no children.
+        ///
+        /// - Parameters:
+        ///   - limit: Most children running at once; more wait in a queue.
+        ///   - batch: Most spawns per loop iteration.
+        ///   - grace: Wait between forwarding a stream signal and SIGKILL.
+        ///   - signals: A stream whose SIGTERM/SIGINT shut the supervisor
+        ///     down. Not closed by the supervisor.
+        ///   - events: Called on the loop thread for each `Event`; must not block.
+        /// - Throws: `POSIX.Kernel.Process.Error.supervisor` if the poller
+        ///   cannot be created or a descriptor cannot be registered, `.pipe`
+        ///   if the wake pipe cannot be created.
+        public init(
+            limit: Int = .max,
+            batch: Int = 64,
+            grace: Duration = .seconds(10),
+            signals: POSIX.Kernel.Signal.Stream? = nil,
+            events: Handler? = nil
+        ) throws(POSIX.Kernel.Process.Error) {
+            precondition(limit > 0 && batch > 0, "limit and batch must be positive")
+
+            let poller = swift_poller_open()
+            guard poller >= 0 else {
+                throw .supervisor(POSIX.Kernel.Error.captureErrno())
+            }
+
+            let wake: (read: Kernel.Descriptor, write: Kernel.Descriptor)
+            do {
+                wake = try POSIX.Kernel.Process.Pipe.create([.cloexec, .nonblocking])
+            } catch {
+                release(poller)
+                throw error
+            }
+
+            var registered = swift_poller_add(poller, wake.read.rawValue, Token.wake) == 0
+            if registered, let signals {
+                registered = swift_poller_add(poller, signals.descriptor.rawValue, Token.signals) == 0
+            }
+            guard registered else {
+                let code = POSIX.Kernel.Error.captureErrno()
+                release(poller)
+                POSIX.Kernel.Process.Pipe.close(wake.read)
+                POSIX.Kernel.Process.Pipe.close(wake.write)
+                throw .supervisor(code)
+            }
+
+            self.limit = limit
+            self.batch = batch
+            self.grace = grace
+            self.poller = poller
+            self.wake = wake
+            self.signals = signals
+            self.events = events
+        }
+
+        /// Closes the poller and the handles of children still running.
+        ///
+        /// The children are neither signalled nor reaped; `shutdown` and
+        /// let `run` return first.
+        deinit {
+            for slot in slots {
+                if let handle = slot.handle {
+                    try? POSIX.Kernel.Process.Handle.close(handle)
+                }
+            }
+            release(poller)
+            POSIX.Kernel.Process.Pipe.close(wake.read)
+            POSIX.Kernel.Process.Pipe.close(wake.write)
+        }
+    }
+}
+
+// MARK: - ID, Policy, Event
+
+extension POSIX.Kernel.Process.Supervisor {
+    /// A supervised child, across its restarts.
+    public struct ID: RawRepresentable, Sendable, Hashable {
+        public let rawValue: Int
+
+        public init(rawValue: Int) {
+            self.rawValue = rawValue
+        }
+    }
+
+    /// When and how soon a child is restarted.
+    public struct Policy: Sendable, Equatable {
+        /// Which exits restart the child.
+        public enum Restart: Sendable, Equatable {
+            /// Never restart.
+            case never
+
+            /// Restart unless the child exited with status 0.
+            case onFailure
+
+            /// Restart after every exit.
+            case always
+        }
+
+        /// Which exits restart the child.
+        public var restart: Restart
+
+        /// Delay before the first restart; doubled for each restart after.
+        public var initial: Duration
+
+        /// Longest delay.
+        public var maximum: Duration
+
+        /// A run at least this long resets the delay to `initial`.
+        public var stable: Duration
+
+        /// Most restarts over the child's lifetime.
+        public var restarts: Int
+
+        public init(
+            restart: Restart = .onFailure,
+            initial: Duration = .milliseconds(100),
+            maximum: Duration = .seconds(30),
+            stable: Duration = .seconds(60),
+            restarts: Int = .max
+        ) {
+            self.restart = restart
+            self.initial = initial
+            self.maximum = maximum
+            self.stable = stable
+            self.restarts = restarts
+        }
+
+        /// The delay before a restart that follows `consecutive` quick ones.
+        ///
+        /// `min(initial * 2^consecutive, maximum)`.
+        public func delay(after consecutive: Int) -> Duration {
+            var delay = initial
+            for _ in 0..<Swift.min(consecutive, 62) where delay < maximum {
+                delay *= 2
+            }
+            return Swift.min(delay, maximum)
+        }
+    }
+
+    /// Something the loop did or saw.
+    public enum Event: Sendable {
+        /// A child was spawned.
+        case started(ID, Kernel.Process.ID)
+
+        /// A child was reaped.
+        case exited(ID, POSIX.Kernel.Process.Wait.Result, restarting: Bool)
+
+        /// Spawning or waiting for a child failed.
+        case failed(ID, POSIX.Kernel.Process.Error, restarting: Bool)
+
+        /// A record was read from the signal stream.
+        case signal(POSIX.Kernel.Signal.Stream.Record)
+    }
+
+    /// Receives events on the loop thread.
+    public typealias Handler = @Sendable (Event) -> Void
+}
+
+// MARK: - Commands
+
+extension POSIX.Kernel.Process.Supervisor {
+    /// Supervises a new child: it is started by the loop's next iteration
+    /// that has room under `limit`.
+    ///
+    /// - Parameters:
+    ///   - arguments: Path, argv and envp; reused for every restart.
+    ///   - fileActions: Applied to every start.
+    ///   - attributes: Applied to every start.
+    ///   - policy: Restart policy.
+    /// - Returns: The child's ID, stable across restarts. After a shutdown
+    ///   has begun, the child is never started.
+    @discardableResult
+    public func add(
+        _ arguments: POSIX.Kernel.Process.Spawn.Arguments,
+        fileActions: POSIX.Kernel.Process.Spawn.FileActions? = nil,
+        attributes: POSIX.Kernel.Process.Spawn.Attributes? = nil,
+        policy: Policy = Policy()
+    ) -> ID {
+        let slot = Slot(arguments: arguments, fileActions: fileActions, attributes: attributes, policy: policy)
+        let id = inbox.withLock { inbox in
+            // IDs follow queue order, so the loop's slot index is the ID
+            let id = ID(rawValue: inbox.next)
+            inbox.next += 1
+            inbox.commands.append(.add(slot))
+            return id
+        }
+        notify()
+        return id
+    }
+
+    /// Stops supervising a child: sends it `signal` if running, and never
+    /// starts it again.
+    public func stop(_ id: ID, signal: POSIX.Kernel.Signal.Number = .terminate) {
+        inbox.withLock { $0.commands.append(.stop(id, signal)) }
+        notify()
+    }
+
+    /// Sends `signal` to every running child, starts nothing more, and sends
+    /// SIGKILL to those still running after `grace`. `run` returns once all
+    /// are reaped. Final: a supervisor is not restartable.
+    public func shutdown(_ signal: POSIX.Kernel.Signal.Number = .terminate, grace: Duration = .seconds(10)) {
+        inbox.withLock { $0.commands.append(.shutdown(signal, grace)) }
+        notify()
+    }
+
+    /// The counters as of the loop's last iteration.
+    public var statistics: Statistics {
+        published.withLock { $0 }
+    }
+
+    private func notify() {
+        var byte: UInt8 = 0
+        // A full pipe already guarantees a wakeup
+        _ = write(wake.write.rawValue, &byte, 1)
+    }
+}
+
+// MARK: - Loop
+
+extension POSIX.Kernel.Process.Supervisor {
+    /// Runs the loop on the calling thread until a shutdown has reaped
+    /// every child.
+    ///
+    /// - Throws: `POSIX.Kernel.Process.Error.supervisor` with EBUSY if the
+    ///   loop is already running, or with the poller's errno. Spawn and
+    ///   wait failures are reported as `Event.failed`, not thrown.
+    public func run() throws(POSIX.Kernel.Process.Error) {
+        guard running.compareExchange(expected: false, desired: true, ordering: .acquiring).exchanged else {
+            throw .supervisor(.posix(EBUSY))
+        }
+        defer { running.store(false, ordering: .releasing) }
+
+        let tokens = UnsafeMutablePointer<UInt64>.allocate(capacity: Int(SWIFT_POLLER_BATCH))
+        let records = UnsafeMutableBufferPointer<POSIX.Kernel.Signal.Stream.Record>.allocate(capacity: 64)
+        defer {
+            tokens.deallocate()
+            records.deallocate()
+        }
+
+        while true {
+            receive()
+            let now = clock.now
+            promote(now)
+            if let stopping, !stopping.killed, now >= stopping.deadline {
+                _ = POSIX.Kernel.Signal.Send.toAll(.kill, slots.compactMap(\.handle))
+                self.stopping?.killed = true
+            }
+            launch()
+            publish()
+
+            if stopping != nil && live == 0 {
+                return
+            }
+
+            let count = swift_poller_wait(poller, tokens, SWIFT_POLLER_BATCH, timeout(clock.now))
+            guard count >= 0 else {
+                throw .supervisor(POSIX.Kernel.Error.captureErrno())
+            }
+            counters.iterations += 1
+
+            let woke = clock.now
+            for index in 0..<Int(count) {
+                switch tokens[index] {
+                case Token.wake:
+                    drain()
+                case Token.signals:
+                    consume(records)
+                case let token:
+                    reap(Int(token), since: woke)
+                }
+            }
+        }
+    }
+
+    /// Applies queued commands.
+    private func receive() {
+        let commands = inbox.withLock { inbox in
+            let commands = inbox.commands
+            inbox.commands.removeAll(keepingCapacity: true)
+            return commands
+        }
+
+        for command in commands {
+            switch command {
+            case .add(let slot):
+                slots.append(slot)
+                if stopping == nil {
+                    ready.append(slots.count - 1)
+                }
+
+            case .stop(let id, let signal):
+                guard slots.indices.contains(id.rawValue) else { continue }
+                slots[id.rawValue].stopped = true
+                if let handle = slots[id.rawValue].handle {
+                    _ = POSIX.Kernel.Signal.Send.toAll(signal, CollectionOfOne(handle))
+                }
+
+            case .shutdown(let signal, let grace):
+                begin(signal, grace: grace)
+            }
+        }
+    }
+
+    /// Starts a shutdown, unless one is under way.
+    private func begin(_ signal: POSIX.Kernel.Signal.Number, grace: Duration) {
+        guard stopping == nil else { return }
+        stopping = Stopping(deadline: clock.now + grace)
+        ready.removeAll()
+        readyHead = 0
+        delayed.removeAll()
+        _ = POSIX.Kernel.Signal.Send.toAll(signal, slots.compactMap(\.handle))
+    }
+
+    /// Moves restarts that are due to the ready queue.
+    private func promote(_ now: ContinuousClock.Instant) {
+        while let next = delayed.last, next.due <= now {
+            delayed.removeLast()
+            ready.append(next.slot)
+        }
+    }
+
+    /// Spawns up to `batch` ready children while fewer than `limit` run.
+    private func launch() {
+        var spawned = 0
+        while spawned < batch, live < limit, readyHead < ready.count {
+            let index = ready[readyHead]
+            readyHead += 1
+            if slots[index].stopped { continue }
+            start(index)
+            spawned += 1
+        }
+        if readyHead == ready.count {
+            ready.removeAll(keepingCapacity: true)
+            readyHead = 0
+        }
+        counters.largestBatch = Swift.max(counters.largestBatch, spawned)
+    }
+
+    private func start(_ index: Int) {
+        let slot = slots[index]
+        let begin = clock.now
+        let handle: POSIX.Kernel.Process.Handle
+        do {
+            handle = try withExtendedLifetime(slot.arguments) { () throws(POSIX.Kernel.Process.Error) in
+                try POSIX.Kernel.Process.Handle.spawn(
+                    path: slot.arguments.path,
+                    argv: slot.arguments.argv,
+                    envp: slot.arguments.envp,
+                    fileActions: slot.fileActions,
+                    attributes: slot.attributes
+                )
+            }
+        } catch {
+            failed(index, error)
+            return
+        }
+        counters.spawn.record(Self.nanoseconds(clock.now - begin))
+
+        guard swift_poller_add(poller, handle.descriptor.rawValue, UInt64(index)) == 0 else {
+            // An unwatched child would never be reaped
+            let code = POSIX.Kernel.Error.captureErrno()
+            _ = POSIX.Kernel.Signal.Send.toAll(.kill, CollectionOfOne(handle))
+            _ = try? POSIX.Kernel.Process.Wait.wait(handle)
+            try? POSIX.Kernel.Process.Handle.close(handle)
+            failed(index, .supervisor(code))
+            return
+        }
+
+        slots[index].handle = handle
+        slots[index].started = begin
+        live += 1
+        counters.spawned += 1
+        events?(.started(ID(rawValue: index), handle.pid))
+    }
+
+    /// Reaps the child in `index` once its handle is readable.
+    private func reap(_ index: Int, since woke: ContinuousClock.Instant) {
+        guard slots.indices.contains(index), let handle = slots[index].handle else { return }
+
+        let result: POSIX.Kernel.Process.Wait.Result?
+        do {
+            result = try POSIX.Kernel.Process.Wait.wait(handle, options: .no.hang)
+        } catch {
+            finish(index, handle)
+            failed(index, error)
+            return
+        }
+        // Readable before the exit is reapable (Darwin): the next wakeup reaps
+        guard let result else { return }
+
+        let now = clock.now
+        finish(index, handle)
+        counters.exited += 1
+        counters.reap.record(Self.nanoseconds(now - woke))
+
+        if now - slots[index].started >= slots[index].policy.stable {
+            slots[index].consecutive = 0
+        }
+        let clean = result.status.exited && result.status.exit.code == 0
+        let restarting = reschedule(index, failed: !clean, now: now)
+        events?(.exited(ID(rawValue: index), result, restarting: restarting))
+    }
+
+    /// Forgets a reaped or lost child's handle.
+    private func finish(_ index: Int, _ handle: POSIX.Kernel.Process.Handle) {
+        // Closing the descriptor also removes it from the poller
+        try? POSIX.Kernel.Process.Handle.close(handle)
+        slots[index].handle = nil
+        live -= 1
+    }
+
+    private func failed(_ index: Int, _ error: POSIX.Kernel.Process.Error) {
+        counters.failed += 1
+        let restarting = reschedule(index, failed: true, now: clock.now)
+        events?(.failed(ID(rawValue: index), error, restarting: restarting))
+    }
+
+    /// Queues a restart if the policy asks for one.
+    private func reschedule(_ index: Int, failed: Bool, now: ContinuousClock.Instant) -> Bool {
+        let policy = slots[index].policy
+        guard stopping == nil, !slots[index].stopped, slots[index].restarts < policy.restarts else {
+            return false
+        }
+        switch policy.restart {
+        case .never:
+            return false
+        case .onFailure where !failed:
+            return false
+        case .onFailure, .always:
+            break
+        }
+
+        let delay = policy.delay(after: slots[index].consecutive)
+        slots[index].consecutive += 1
+        slots[index].restarts += 1
+        counters.restarted += 1
+
+        if delay <= .zero {
+            ready.append(index)
+        } else {
+            let due = now + delay
+            var low = 0
+            var high = delayed.count
+            while low < high {
+                let middle = (low + high) / 2
+                if delayed[middle].due > due {
+                    low = middle + 1
+                } else {
+                    high = middle
+                }
+            }
+            delayed.insert((due, index), at: low)
+        }
+        return true
+    }
+
+    /// Reads the signal stream; SIGTERM and SIGINT begin a shutdown.
+    private func consume(_ records: UnsafeMutableBufferPointer<POSIX.Kernel.Signal.Stream.Record>) {
+        guard let signals else { return }
+        var count: Int
+        repeat {
+            guard let read = try? signals.read(into: records) else { return }
+            count = read
+            for record in records[..<count] {
+                counters.signals += 1
+                events?(.signal(record))
+                if record.signal == .terminate || record.signal == .interrupt {
+                    begin(record.signal, grace: grace)
+                }
+            }
+        } while count == records.count
+    }
+
+    /// Empties the wake pipe.
+    private func drain() {
+        var bytes: (UInt64, UInt64, UInt64, UInt64) = (0, 0, 0, 0)
+        while withUnsafeMutableBytes(of: &bytes, { read(wake.read.rawValue, $0.baseAddress, $0.count) }) > 0 {}
+    }
+
+    /// Milliseconds until the next restart or kill is due; -1 for none.
+    private func timeout(_ now: ContinuousClock.Instant) -> Int32 {
+        if readyHead < ready.count && live < limit {
+            return 0
+        }
+        var next = delayed.last?.due
+        if let stopping, !stopping.killed {
+            next = Swift.min(next ?? stopping.deadline, stopping.deadline)
+        }
+        guard let next else { return -1 }
+        let milliseconds = (Self.nanoseconds(next - now) + 999_999) / 1_000_000
+        return Int32(clamping: milliseconds)
+    }
+
+    private func publish() {
+        counters.running = live
+        counters.queued = ready.count - readyHead + delayed.count
+        let snapshot = counters
+        published.withLock { $0 = snapshot }
+    }
+
+    private static func nanoseconds(_ duration: Duration) -> UInt64 {
+        let (seconds, attoseconds) = duration.components
+        guard seconds >= 0 else { return 0 }
+        return UInt64(seconds) &* 1_000_000_000 &+ UInt64(attoseconds / 1_000_000_000)
+    }
+}
+
+// MARK: - State
+
+extension POSIX.Kernel.Process.Supervisor {
+    /// Poller tokens that are not slot indices.
+    private enum Token {
+        static let wake = UInt64.max
+        static let signals = UInt64.max - 1
+    }
+
+    /// One supervised child.
+    private struct Slot {
+        let arguments: POSIX.Kernel.Process.Spawn.Arguments
+        let fileActions: POSIX.Kernel.Process.Spawn.FileActions?
+        let attributes: POSIX.Kernel.Process.Spawn.Attributes?
+        let policy: Policy
+        var handle: POSIX.Kernel.Process.Handle?
+        var started = ContinuousClock.now
+        var restarts = 0
+        /// Restarts since the last stable run.
+        var consecutive = 0
+        /// Not to be started again.
+        var stopped = false
+
+        init(
+            arguments: POSIX.Kernel.Process.Spawn.Arguments,
+            fileActions: POSIX.Kernel.Process.Spawn.FileActions?,
+            attributes: POSIX.Kernel.Process.Spawn.Attributes?,
+            policy: Policy
+        ) {
+            self.arguments = arguments
+            self.fileActions = fileActions
+            self.attributes = attributes
+            self.policy = policy
+        }
+    }
+
+    private enum Command {
+        case add(Slot)
+        case stop(ID, POSIX.Kernel.Signal.Number)
+        case shutdown(POSIX.Kernel.Signal.Number, Duration)
+    }
+
+    private struct Inbox {
+        var next = 0
+        var commands: [Command] = []
+    }
+
+    private struct Stopping {
+        let deadline: ContinuousClock.Instant
+        var killed = false
+    }
+}
+
+/// Closes a descriptor, ignoring errors.
+private func release(_ descriptor: Int32) {
+    #if canImport(Darwin)
+        _ = Darwin.close(descriptor)
+    #elseif canImport(Glibc)
+        _ = Glibc.close(descriptor)
+    #elseif canImport(Musl)
+        _ = Musl.close(descriptor)
+    #endif
+}
@@ -0,0 +1,220 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Process {
+    /// Descendant trees: snapshots and bulk teardown.
+    ///
+    /// Groups and sessions only reach processes that stayed in them; a
+    /// tree follows parent links, so it also finds descendants that
+    /// called `setsid` or `setpgid`.
+    ///
+    /// | Platform | Children of a PID |
+    /// |----------|-------------------|
+    /// | Linux | `/proc/<pid>/task/*/children`; a `/proc/*/stat` scan without CONFIG_PROC_CHILDREN |
+    /// | Darwin | `proc_listchildpids` |
+    ///
+    /// ## Orphans
+    ///
+    /// A descendant whose parent exits is reparented to the nearest
+    /// subreaper ancestor, or init, and leaves the tree. On Linux, make
+    /// the supervisor a subreaper (`subreaper(true)`) before spawning, so
+    /// orphans land on it instead and `teardown` can reap whole trees.
+    public enum Tree {}
+}
+
+// MARK: - Snapshot
+
+extension POSIX.Kernel.Process.Tree {
+    /// Enumerates the descendants of `root`, breadth-first.
+    ///
+    /// The buffer doubles as the traversal queue, so nothing is allocated.
+    /// Processes that exit mid-walk are skipped; ones forked after their
+    /// parent was visited are missed. Freeze the tree first (SIGSTOP) for
+    /// an exact snapshot, as `teardown` does.
+    ///
+    /// - Parameters:
+    ///   - root: The process whose descendants to list (not included).
+    ///   - buffer: Receives the PIDs, parents before their children.
+    /// - Returns: Descendants written; `buffer.count` means there may be more.
+    /// - Throws: `POSIX.Kernel.Process.Error.tree` if `root` does not exist
+    ///   (ESRCH) or `/proc` cannot be read.
+    public static func snapshot(
+        of root: Kernel.Process.ID,
+        into buffer: UnsafeMutableBufferPointer<Kernel.Process.ID>
+    ) throws(POSIX.Kernel.Process.Error) -> Int {
+        guard let base = buffer.baseAddress else { return 0 }
+
+        var count = try children(of: root, into: base, capacity: buffer.count)
+        var index = 0
+        while index < count && count < buffer.count {
+            // A descendant that already exited has no children to add
+            count += (try? children(of: base[index], into: base + count, capacity: buffer.count - count)) ?? 0
+            index += 1
+        }
+        return count
+    }
+
+    /// Direct children of `parent`, written at `base`; at most `capacity`.
+    private static func children(
+        of parent: Kernel.Process.ID,
+        into base: UnsafeMutablePointer<Kernel.Process.ID>,
+        capacity: Int
+    ) throws(POSIX.Kernel.Process.Error) -> Int {
+        let found = base.withMemoryRebound(to: pid_t.self, capacity: capacity) {
+            swift_process_children(parent.rawValue, $0, Int32(capacity))
+        }
+        guard found >= 0 else {
+            throw .tree(POSIX.Kernel.Error.captureErrno())
+        }
+        return min(Int(found), capacity)
+    }
+}
+
+// MARK: - Teardown
+
+extension POSIX.Kernel.Process.Tree {
+    /// The outcome of a `teardown`.
+    public struct Teardown: Sendable, Equatable {
+        /// Processes found in the tree, root included.
+        public let count: Int
+
+        /// Processes sent SIGKILL.
+        public let killed: Int
+
+        /// Processes reaped by the caller.
+        public let reaped: Int
+
+        public init(count: Int, killed: Int, reaped: Int) {
+            self.count = count
+            self.killed = killed
+            self.reaped = reaped
+        }
+    }
+
+    /// Kills `root` and every descendant, then reaps them.
+    ///
+    /// 1. Freeze: SIGSTOP the snapshot and walk again, until a walk finds
+    ///    no new process, so nothing forks past the kill.
+    /// 2. Kill: one SIGKILL pass over the frozen snapshot.
+    /// 3. Reap: blocking `waitpid` in breadth-first order. Each parent has
+    ///    exited by the time its children are waited for, so a subreaper
+    ///    caller has already inherited them.
+    ///
+    /// No step polls or sleeps; cost follows the size of the tree.
+    ///
+    /// - Parameters:
+    ///   - root: A child of the caller.
+    ///   - buffer: Scratch space for the snapshot, one slot per process.
+    ///     A tree larger than the buffer is killed only as far as it fits.
+    /// - Returns: Counts per phase. Without subreaper status (or on
+    ///   Darwin) only `root` and processes that are already the caller's
+    ///   children are reaped; the rest go to init.
+    /// - Throws: `POSIX.Kernel.Process.Error.tree` if `root` does not exist,
+    ///   `.wait` if reaping fails other than with ECHILD.
+    public static func teardown(
+        _ root: Kernel.Process.ID,
+        into buffer: UnsafeMutableBufferPointer<Kernel.Process.ID>
+    ) throws(POSIX.Kernel.Process.Error) -> Teardown {
+        guard let base = buffer.baseAddress else {
+            return Teardown(count: 0, killed: 0, reaped: 0)
+        }
+        base.initialize(to: root)
+        let rest = UnsafeMutableBufferPointer(rebasing: buffer[1...])
+
+        // Freeze
+        var count = 1
+        _ = kill(root.rawValue, SIGSTOP)
+        for _ in 0..<Self.rounds {
+            let found = 1 + (try snapshot(of: root, into: rest))
+            // Stopping an already stopped process is a no-op
+            for index in 1..<found {
+                _ = kill(base[index].rawValue, SIGSTOP)
+            }
+            let settled = found == count
+            count = found
+            if settled { break }
+        }
+
+        // Kill
+        var killed = 0
+        for index in 0..<count where kill(base[index].rawValue, SIGKILL) == 0 {
+            killed += 1
+        }
+
+        // Reap
+        var reaped = 0
+        for index in 0..<count {
+            var status: Int32 = 0
+            var result: pid_t
+            repeat {
+                result = waitpid(base[index].rawValue, &status, 0)
+            } while result == -1 && errno == EINTR
+
+            if result > 0 {
+                reaped += 1
+            } else if errno != ECHILD {
+                throw .wait(POSIX.Kernel.Error.captureErrno())
+            }
+        }
+
+        return Teardown(count: count, killed: killed, reaped: reaped)
+    }
+
+    /// Walks before giving up on the tree settling; a process that keeps
+    /// forking between SIGSTOP being sent and taking effect is rare.
+    private static let rounds = 16
+}
+
+#if os(Linux)
+
+    // MARK: - Subreaper
+
+    extension POSIX.Kernel.Process.Tree {
+        /// Makes the calling process a child subreaper, or stops it being one
+        /// (PR_SET_CHILD_SUBREAPER).
+        ///
+        /// Orphaned descendants are then reparented to the caller instead of
+        /// init, and must be reaped by it. Not inherited across fork.
+        ///
+        /// - Throws: `POSIX.Kernel.Process.Error.tree` on failure.
+        public static func subreaper(_ enabled: Bool) throws(POSIX.Kernel.Process.Error) {
+            guard swift_subreaper_set(enabled ? 1 : 0) == 0 else {
+                throw .tree(POSIX.Kernel.Error.captureErrno())
+            }
+        }
+
+        /// Whether the calling process is a child subreaper (PR_GET_CHILD_SUBREAPER).
+        ///
+        /// - Throws: `POSIX.Kernel.Process.Error.tree` on failure.
+        public static func isSubreaper() throws(POSIX.Kernel.Process.Error) -> Bool {
+            let enabled = swift_subreaper_get()
+            guard enabled >= 0 else {
+                throw .tree(POSIX.Kernel.Error.captureErrno())
+            }
+            return enabled == 1
+        }
+    }
+
+#endif
@@ -0,0 +1,108 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+#elseif canImport(Glibc)
+    internal import Glibc
+#elseif canImport(Musl)
+    internal import Musl
+#endif
+
+// MARK: - Drain Operation
+
+extension POSIX.Kernel.Process.Wait {
+    /// Reaps every child that is ready, without blocking.
+    ///
+    /// Loops `waitpid(selector, WNOHANG | options)` and writes one `Result`
+    /// per reaped child into `buffer`, so a single SIGCHLD wakeup can collect
+    /// everything that has exited.
+    ///
+    /// - Parameters:
+    ///   - selector: Which child(ren) to reap (default: `.any`).
+    ///   - options: Additional wait options. `no.hang` is always added.
+    ///   - buffer: Caller-owned storage, written from index 0. `Result` is a
+    ///     trivial type, so the memory may be uninitialized.
+    /// - Returns: The number of results written.
+    /// - Throws: `POSIX.Kernel.Process.Error.wait` only if the first
+    ///   `waitpid` fails with something other than ECHILD.
+    ///
+    /// ## Stop Conditions
+    ///
+    /// | Condition | Behavior |
+    /// |-----------|----------|
+    /// | No child ready (`waitpid` returns 0) | Returns count |
+    /// | No children left (ECHILD) | Returns count, never throws |
+    /// | Buffer full | Returns count; more children may be ready |
+    /// | Other error after ≥1 result | Returns count; the error recurs on the next call |
+    ///
+    /// ## Allocation
+    ///
+    /// None. Each iteration is one `waitpid` and one store into `buffer`.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let buffer = UnsafeMutableBufferPointer<POSIX.Kernel.Process.Wait.Result>.allocate(capacity: 256)
+    /// defer { buffer.deallocate() }
+    ///
+    /// // On every SIGCHLD:
+    /// var count: Int
+    /// repeat {
+    ///     count = try POSIX.Kernel.Process.Wait.drain(into: buffer)
+    ///     for result in buffer[..<count] { complete(result) }
+    /// } while count == buffer.count
+    /// ```
+    public static func drain(
+        _ selector: Selector = .any,
+        options: Options = [],
+        into buffer: UnsafeMutableBufferPointer<Result>
+    ) throws(POSIX.Kernel.Process.Error) -> Int {
+        guard let base = buffer.baseAddress else { return 0 }
+
+        let pid = selector.pid
+        let flags = options.rawValue | WNOHANG
+        var count = 0
+
+        while count < buffer.count {
+            var status: Int32 = 0
+            let result = waitpid(pid, &status, flags)
+
+            if result == -1 {
+                let code = POSIX.Kernel.Error.captureErrno()
+                if code.posix == ECHILD || count > 0 {
+                    return count
+                }
+                throw .wait(code)
+            }
+
+            // Nothing (more) ready
+            if result == 0 {
+                return count
+            }
+
+            POSIX.Kernel.Trace.mark(.reap, pid: result, detail: status)
+
+            (base + count).initialize(
+                to: Result(
+                    pid: Kernel.Process.ID(result),
+                    status: POSIX.Kernel.Process.Status(rawValue: status)
+                )
+            )
+            count += 1
+        }
+
+        return count
+    }
+}
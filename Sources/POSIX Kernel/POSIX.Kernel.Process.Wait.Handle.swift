@@ -0,0 +1,80 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+// MARK: - Wait on Handle
+
+extension POSIX.Kernel.Process.Wait {
+    /// Waits for the child referenced by a process handle.
+    ///
+    /// - Parameters:
+    ///   - handle: Handle from `Process.Handle.open` or `Process.Handle.spawn`.
+    ///   - options: Wait options (default: blocking).
+    /// - Returns: Result, or `nil` if `no.hang` and the child has not changed state.
+    /// - Throws: `POSIX.Kernel.Process.Error.wait` on failure.
+    ///
+    /// ## Implementation
+    ///
+    /// - Linux: `waitid(P_PIDFD, fd, ..., WEXITED | options)`; the siginfo is
+    ///   re-encoded as a wait status so `Status` decodes it unchanged.
+    /// - Darwin: `waitpid(pid, ...)`; the kqueue only provides readiness.
+    ///
+    /// ## Event Loop Usage
+    ///
+    /// Poll `handle.descriptor` for readability, then call with `.no.hang`:
+    ///
+    /// ```swift
+    /// if let result = try POSIX.Kernel.Process.Wait.wait(handle, options: .no.hang) {
+    ///     try POSIX.Kernel.Process.Handle.close(handle)
+    /// }
+    /// ```
+    public static func wait(
+        _ handle: POSIX.Kernel.Process.Handle,
+        options: Options = []
+    ) throws(POSIX.Kernel.Process.Error) -> Result? {
+        var status: Int32 = 0
+
+        #if os(Linux)
+            let result = swift_waitid_pidfd(handle.descriptor.rawValue, options.rawValue, &status)
+        #else
+            let result = waitpid(handle.pid.rawValue, &status, options.rawValue)
+        #endif
+
+        if result == -1 {
+            throw .wait(POSIX.Kernel.Error.captureErrno())
+        }
+
+        // WNOHANG: returns 0 if the child has not changed state
+        if result == 0 {
+            return nil
+        }
+
+        POSIX.Kernel.Trace.mark(.reap, pid: result, detail: status)
+
+        return Result(
+            pid: Kernel.Process.ID(result),
+            status: POSIX.Kernel.Process.Status(rawValue: status)
+        )
+    }
+}
@@ -0,0 +1,189 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+#elseif canImport(Glibc)
+    internal import Glibc
+#elseif canImport(Musl)
+    internal import Musl
+#endif
+
+extension POSIX.Kernel.Process.Wait {
+    /// Resource usage of a reaped child (struct rusage from wait4).
+    ///
+    /// Captured by the kernel in the same syscall that reaps the child, so
+    /// there is no race with PID reuse and no second round-trip through
+    /// `/proc` or `getrusage(RUSAGE_CHILDREN)`.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// if let result = try POSIX.Kernel.Process.Wait.Usage.wait(.process(child)),
+    ///    let usage = result.usage {
+    ///     bill(cpu: usage.time.user + usage.time.system, rss: usage.memory.peak)
+    /// }
+    /// ```
+    public struct Usage: Sendable, Equatable, Hashable {
+        /// CPU time consumed.
+        public let time: Time
+
+        /// Memory high-water mark.
+        public let memory: Memory
+
+        /// Page fault counts.
+        public let faults: Faults
+
+        /// Context switch counts.
+        public let switches: Switches
+
+        public init(time: Time, memory: Memory, faults: Faults, switches: Switches) {
+            self.time = time
+            self.memory = memory
+            self.faults = faults
+            self.switches = switches
+        }
+    }
+}
+
+// MARK: - Nest.Name Components
+
+extension POSIX.Kernel.Process.Wait.Usage {
+    /// CPU time (ru_utime, ru_stime).
+    public struct Time: Sendable, Equatable, Hashable {
+        /// Time spent executing in user mode.
+        public let user: Duration
+
+        /// Time spent executing in the kernel on the child's behalf.
+        public let system: Duration
+
+        public init(user: Duration, system: Duration) {
+            self.user = user
+            self.system = system
+        }
+    }
+
+    /// Memory usage (ru_maxrss).
+    public struct Memory: Sendable, Equatable, Hashable {
+        /// Maximum resident set size, in bytes.
+        ///
+        /// Normalized across platforms: Linux reports KiB, Darwin bytes.
+        public let peak: Int
+
+        public init(peak: Int) {
+            self.peak = peak
+        }
+    }
+
+    /// Page faults (ru_minflt, ru_majflt).
+    public struct Faults: Sendable, Equatable, Hashable {
+        /// Faults serviced without I/O.
+        public let minor: Int
+
+        /// Faults that required I/O.
+        public let major: Int
+
+        public init(minor: Int, major: Int) {
+            self.minor = minor
+            self.major = major
+        }
+    }
+
+    /// Context switches (ru_nvcsw, ru_nivcsw).
+    public struct Switches: Sendable, Equatable, Hashable {
+        /// The child yielded the CPU (blocked on I/O, slept).
+        public let voluntary: Int
+
+        /// The child was preempted.
+        public let involuntary: Int
+
+        public init(voluntary: Int, involuntary: Int) {
+            self.voluntary = voluntary
+            self.involuntary = involuntary
+        }
+    }
+}
+
+// MARK: - rusage Conversion
+
+extension POSIX.Kernel.Process.Wait.Usage {
+    /// Creates usage from a raw `rusage`.
+    internal init(_ raw: rusage) {
+        #if canImport(Darwin)
+            let peak = Int(raw.ru_maxrss)
+        #else
+            let peak = Int(raw.ru_maxrss) * 1024
+        #endif
+
+        self.init(
+            time: Time(user: Duration(raw.ru_utime), system: Duration(raw.ru_stime)),
+            memory: Memory(peak: peak),
+            faults: Faults(minor: Int(raw.ru_minflt), major: Int(raw.ru_majflt)),
+            switches: Switches(voluntary: Int(raw.ru_nvcsw), involuntary: Int(raw.ru_nivcsw))
+        )
+    }
+}
+
+extension Duration {
+    /// Creates a duration from a `timeval`.
+    internal init(_ tv: timeval) {
+        self = .seconds(Int64(tv.tv_sec)) + .microseconds(Int64(tv.tv_usec))
+    }
+}
+
+// MARK: - Wait with Usage
+
+extension POSIX.Kernel.Process.Wait.Usage {
+    /// Waits for child process(es) and captures resource usage (wait4).
+    ///
+    /// Same selector, options, and return semantics as `Wait.wait`, with
+    /// `Result.usage` filled in. Use `Wait.wait` when usage is not needed;
+    /// it does not copy a `rusage` out of the kernel.
+    ///
+    /// - Parameters:
+    ///   - selector: Which child(ren) to wait for.
+    ///   - options: Wait options (default: blocking).
+    /// - Returns: Result with `usage`, or `nil` if `no.hang` and no child changed state.
+    /// - Throws: `POSIX.Kernel.Process.Error.wait` on failure.
+    ///
+    /// ## Stopped and Continued Children
+    ///
+    /// Usage is only meaningful once the child has terminated; for stop or
+    /// continue reports the kernel returns zeroed counters.
+    public static func wait(
+        _ selector: POSIX.Kernel.Process.Wait.Selector,
+        options: POSIX.Kernel.Process.Wait.Options = []
+    ) throws(POSIX.Kernel.Process.Error) -> POSIX.Kernel.Process.Wait.Result? {
+        var status: Int32 = 0
+        var raw = rusage()
+        let result = wait4(selector.pid, &status, options.rawValue, &raw)
+
+        if result == -1 {
+            throw .wait(POSIX.Kernel.Error.captureErrno())
+        }
+
+        // WNOHANG: returns 0 if no child changed state
+        if result == 0 {
+            return nil
+        }
+
+        POSIX.Kernel.Trace.mark(.reap, pid: result, detail: status)
+
+        return POSIX.Kernel.Process.Wait.Result(
+            pid: Kernel.Process.ID(result),
+            status: POSIX.Kernel.Process.Status(rawValue: status),
+            usage: Self(raw)
+        )
+    }
+}
@@ -64,6 +64,22 @@ extension POSIX.Kernel.Process.Wait {
     }
 }
 
+extension POSIX.Kernel.Process.Wait.Selector {
+    /// The waitpid pid argument for this selector.
+    internal var pid: pid_t {
+        switch self {
+        case .any:
+            -1
+        case .process(let id):
+            id.rawValue
+        case .group(let pgid):
+            -pgid.rawValue
+        case .current:
+            0
+        }
+    }
+}
+
 // MARK: - Result
 
 extension POSIX.Kernel.Process.Wait {
@@ -75,9 +91,19 @@ extension POSIX.Kernel.Process.Wait {
         /// The status of the process.
         public let status: POSIX.Kernel.Process.Status
 
-        public init(pid: Kernel.Process.ID, status: POSIX.Kernel.Process.Status) {
+        /// Resource usage of the child, if requested.
+        ///
+        /// Only `Wait.Usage.wait` fills this; every other wait leaves it `nil`.
+        public let usage: Usage?
+
+        public init(
+            pid: Kernel.Process.ID,
+            status: POSIX.Kernel.Process.Status,
+            usage: Usage? = nil
+        ) {
             self.pid = pid
             self.status = status
+            self.usage = usage
         }
     }
 }
@@ -122,20 +148,8 @@ extension POSIX.Kernel.Process.Wait {
         _ selector: Selector,
         options: Options = []
     ) throws(POSIX.Kernel.Process.Error) -> Result? {
-        let pid: pid_t =
-            switch selector {
-            case .any:
-                -1
-            case .process(let id):
-                id.rawValue
-            case .group(let pgid):
-                -pgid.rawValue
-            case .current:
-                0
-            }
-
         var status: Int32 = 0
-        let result = waitpid(pid, &status, options.rawValue)
+        let result = waitpid(selector.pid, &status, options.rawValue)
 
         if result == -1 {
             throw .wait(POSIX.Kernel.Error.captureErrno())
@@ -146,6 +160,8 @@ extension POSIX.Kernel.Process.Wait {
             return nil
         }
 
+        POSIX.Kernel.Trace.mark(.reap, pid: result, detail: status)
+
         return Result(
             pid: Kernel.Process.ID(result),
             status: POSIX.Kernel.Process.Status(rawValue: status)
@@ -0,0 +1,147 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+internal import Synchronization
+
+extension POSIX.Kernel.Process.Zygote {
+    /// Keeps a fixed number of zygote workers forked ahead of demand.
+    ///
+    /// A warm worker is already running `entry`, usually blocked reading
+    /// its channel for its first assignment. `acquire()` hands one out
+    /// without any syscall. `replenish()` forks replacements and can run
+    /// off the latency-critical path.
+    ///
+    /// ## Cost
+    ///
+    /// Each warm worker is an idle process. Its pages are shared
+    /// copy-on-write with the zygote until either side writes to them.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let pool = try POSIX.Kernel.Process.Zygote.Pool(zygote, capacity: 8)
+    ///
+    /// // On request:
+    /// let worker = try pool.acquire()
+    /// dispatch(job, to: worker.channel)
+    /// try pool.replenish()
+    /// ```
+    ///
+    /// ## Teardown
+    ///
+    /// Deinit closes the channels of all warm workers, so idle workers see
+    /// EOF. Acquired workers belong to the caller.
+    public final class Pool: @unchecked Sendable {
+        /// The zygote that forks the workers.
+        public let zygote: POSIX.Kernel.Process.Zygote
+
+        /// Number of workers `replenish()` keeps warm.
+        public let capacity: Int
+
+        private let warm: Mutex<[Worker]>
+
+        /// Creates a pool and forks `capacity` warm workers.
+        ///
+        /// - Parameters:
+        ///   - zygote: A started zygote.
+        ///   - capacity: Number of workers to keep warm.
+        /// - Throws: `POSIX.Kernel.Process.Error.zygote` if a fork request
+        ///   fails. Workers forked before the failure are released.
+        public init(
+            _ zygote: POSIX.Kernel.Process.Zygote,
+            capacity: Int
+        ) throws(POSIX.Kernel.Process.Error) {
+            precondition(capacity >= 0, "capacity must be non-negative")
+
+            var workers: [Worker] = []
+            workers.reserveCapacity(capacity)
+            do {
+                for _ in 0..<capacity {
+                    workers.append(try zygote.fork())
+                }
+            } catch {
+                for worker in workers {
+                    try? Worker.close(worker)
+                }
+                throw error
+            }
+
+            self.zygote = zygote
+            self.capacity = capacity
+            self.warm = Mutex(workers)
+        }
+
+        deinit {
+            let workers = warm.withLock { warm in
+                let workers = warm
+                warm.removeAll()
+                return workers
+            }
+            for worker in workers {
+                try? Worker.close(worker)
+            }
+        }
+    }
+}
+
+// MARK: - Operations
+
+extension POSIX.Kernel.Process.Zygote.Pool {
+    /// Number of warm workers currently available.
+    public var available: Int {
+        warm.withLock { $0.count }
+    }
+
+    /// Takes a warm worker, or forks one if none is available.
+    ///
+    /// - Returns: A worker owned by the caller.
+    /// - Throws: `POSIX.Kernel.Process.Error.zygote` if the pool is empty
+    ///   and the fork request fails.
+    public func acquire() throws(POSIX.Kernel.Process.Error) -> POSIX.Kernel.Process.Zygote.Worker {
+        if let worker = warm.withLock({ $0.popLast() }) {
+            return worker
+        }
+        return try zygote.fork()
+    }
+
+    /// Forks workers until `capacity` are warm.
+    ///
+    /// Fork requests run outside the pool lock, so `acquire()` is never
+    /// blocked behind a fork. If concurrent calls overshoot `capacity`,
+    /// the extra workers are released.
+    ///
+    /// - Returns: The number of workers added.
+    /// - Throws: `POSIX.Kernel.Process.Error.zygote` if a fork request
+    ///   fails. Workers forked before the failure are kept.
+    @discardableResult
+    public func replenish() throws(POSIX.Kernel.Process.Error) -> Int {
+        let deficit = capacity - available
+        var added = 0
+
+        while added < deficit {
+            let worker = try zygote.fork()
+            let kept = warm.withLock { warm in
+                guard warm.count < capacity else { return false }
+                warm.append(worker)
+                return true
+            }
+            guard kept else {
+                try? POSIX.Kernel.Process.Zygote.Worker.close(worker)
+                break
+            }
+            added += 1
+        }
+
+        return added
+    }
+}
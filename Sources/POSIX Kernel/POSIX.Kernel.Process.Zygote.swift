@@ -0,0 +1,445 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+internal import Synchronization
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Process {
+    /// A single-threaded fork server that creates pre-initialized workers.
+    ///
+    /// `start` forks the zygote once, early. The zygote runs `prepare`
+    /// (load libraries, build caches) and then waits on a control socket.
+    /// Each `fork()` request makes it fork a worker that runs `entry` at
+    /// once, with no exec and no dynamic linking. The worker inherits
+    /// everything `prepare` built, shared copy-on-write.
+    ///
+    /// ## Fork-Safety Contract
+    ///
+    /// `Fork.fork` warns that only async-signal-safe functions may run in a
+    /// child of a multithreaded process. The zygote avoids that limit by
+    /// never having more than one thread:
+    ///
+    /// - **Call `start` before creating any thread.** This includes
+    ///   Swift concurrency tasks, `Signal.Stream.records()`, and libraries
+    ///   that start threads in their initializers. The zygote is a fork of
+    ///   the caller. If any other thread held a lock (malloc, the Swift
+    ///   runtime, stdio) at fork time, the lock stays held forever in the
+    ///   zygote and in every worker.
+    /// - **`prepare` must not create threads.** Threads do not survive
+    ///   `fork`. A thread started in `prepare` would make every worker a
+    ///   child of a multithreaded process.
+    /// - **`entry` runs in a child of a single-threaded process**, so it may
+    ///   allocate, use the Swift runtime, and start threads of its own.
+    /// - The worker returns from `entry` through `Exit.now` (`_exit`).
+    ///   atexit handlers and stdio buffers inherited from the caller are
+    ///   not run or flushed.
+    ///
+    /// ## Process Layout
+    ///
+    /// The zygote leads its own process group (`Placement.group`) or session
+    /// (`Placement.session`), and every worker joins it. One
+    /// `Signal.Send.toGroup(.kill, pgid: zygote.group)` tears everything down.
+    ///
+    /// Workers are children of the zygote, not of the caller: `Wait.wait`
+    /// cannot reap them. The zygote ignores SIGCHLD, so the kernel reaps
+    /// workers automatically. A worker's exit shows up as EOF on its
+    /// `channel`.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// // First thing in main(), before any thread exists:
+    /// let zygote = try POSIX.Kernel.Process.Zygote.start(
+    ///     prepare: { Sandbox.preload() },
+    ///     entry: { channel in Sandbox.serve(channel) }
+    /// )
+    ///
+    /// let worker = try zygote.fork()
+    /// // Talk to the worker over worker.channel
+    /// ```
+    public final class Zygote: @unchecked Sendable {
+        /// The zygote process ID.
+        public let pid: Kernel.Process.ID
+
+        /// The process group shared by the zygote and all of its workers.
+        public let group: POSIX.Kernel.Process.Group.ID
+
+        /// Parent end of the control socket.
+        private let control: Int32
+
+        /// `true` once closed. The lock also serializes request/reply pairs
+        /// on `control`.
+        private let closed = Mutex(false)
+
+        private init(pid: Kernel.Process.ID, control: Int32) {
+            self.pid = pid
+            self.group = POSIX.Kernel.Process.Group.ID(pid.rawValue)
+            self.control = control
+        }
+
+        deinit {
+            close()
+        }
+    }
+}
+
+// MARK: - Placement
+
+extension POSIX.Kernel.Process.Zygote {
+    /// Where the zygote and its workers live relative to the caller.
+    public enum Placement: Sendable, Equatable {
+        /// New process group in the caller's session (setpgid).
+        ///
+        /// Workers still receive terminal signals through the session, but
+        /// not those sent to the caller's foreground group.
+        case group
+
+        /// New session with no controlling terminal (setsid).
+        case session
+    }
+}
+
+// MARK: - Worker
+
+extension POSIX.Kernel.Process.Zygote {
+    /// A worker forked by the zygote.
+    public struct Worker: Sendable, Equatable, Hashable {
+        /// The worker's process ID.
+        public let pid: Kernel.Process.ID
+
+        /// Caller end of a stream socket pair connected to the worker.
+        ///
+        /// Close-on-exec. The worker's end is the descriptor passed to
+        /// `entry`. EOF means the worker has exited.
+        public let channel: Kernel.Socket.Descriptor
+
+        public init(pid: Kernel.Process.ID, channel: Kernel.Socket.Descriptor) {
+            self.pid = pid
+            self.channel = channel
+        }
+    }
+}
+
+extension POSIX.Kernel.Process.Zygote.Worker {
+    /// Closes the worker's channel.
+    ///
+    /// The worker sees EOF on its end. This does not signal the worker.
+    ///
+    /// - Parameter worker: The worker to release. Its channel is invalid afterwards.
+    /// - Throws: `POSIX.Kernel.Process.Error.zygote` on failure.
+    public static func close(_ worker: Self) throws(POSIX.Kernel.Process.Error) {
+        guard POSIX.Kernel.Process.Zygote.release(worker.channel.rawValue) == 0 else {
+            throw .zygote(POSIX.Kernel.Error.captureErrno())
+        }
+    }
+}
+
+// MARK: - Wire Format
+
+extension POSIX.Kernel.Process.Zygote {
+    /// Control socket messages. Host layout: both ends run the same binary.
+    internal enum Message {
+        /// Request: fork one worker.
+        static let fork: Int32 = 1
+
+        /// Reply to a request, and the zygote's readiness report.
+        ///
+        /// Exactly one of `pid` (> 0) or `error` (errno) is meaningful.
+        struct Reply {
+            var pid: Int32
+            var error: Int32
+        }
+    }
+
+    /// Sends a reply, with an optional descriptor (-1 for none).
+    internal static func send(_ reply: Message.Reply, descriptor: Int32 = -1, on socket: Int32) -> Bool {
+        var reply = reply
+        let sent = withUnsafeBytes(of: &reply) { bytes in
+            swift_descriptor_send(socket, bytes.baseAddress, bytes.count, descriptor)
+        }
+        return sent == MemoryLayout<Message.Reply>.size
+    }
+
+    /// Receives a reply and the descriptor that came with it (-1 if none).
+    ///
+    /// Returns `nil` on EOF, a short read, or an error. In those cases errno
+    /// is meaningful only when the underlying receive returned -1.
+    internal static func receive(on socket: Int32) -> (reply: Message.Reply, descriptor: Int32)? {
+        var reply = Message.Reply(pid: 0, error: 0)
+        var descriptor: Int32 = -1
+        let received = withUnsafeMutableBytes(of: &reply) { bytes in
+            swift_descriptor_receive(socket, bytes.baseAddress, bytes.count, &descriptor)
+        }
+        guard received == MemoryLayout<Message.Reply>.size else {
+            if descriptor >= 0 { _ = release(descriptor) }
+            return nil
+        }
+        return (reply, descriptor)
+    }
+
+    /// Closes a raw descriptor.
+    internal static func release(_ descriptor: Int32) -> Int32 {
+        #if canImport(Darwin)
+            Darwin.close(descriptor)
+        #elseif canImport(Glibc)
+            Glibc.close(descriptor)
+        #elseif canImport(Musl)
+            Musl.close(descriptor)
+        #endif
+    }
+
+    /// Sets FD_CLOEXEC on a raw descriptor.
+    internal static func closeOnExec(_ descriptor: Int32) {
+        _ = fcntl(descriptor, F_SETFD, FD_CLOEXEC)
+    }
+
+    /// Creates a stream socket pair as raw descriptors.
+    internal static func pair() -> Swift.Result<(Int32, Int32), POSIX.Kernel.Process.Error> {
+        do {
+            let (first, second) = try POSIX.Kernel.Socket.Pair.create()
+            return .success((first.rawValue, second.rawValue))
+        } catch {
+            switch error {
+            case .platform(.posix(let code)):
+                return .failure(.zygote(.posix(code)))
+            }
+        }
+    }
+}
+
+// MARK: - Start
+
+extension POSIX.Kernel.Process.Zygote {
+    /// Forks the zygote and waits until it is ready to serve requests.
+    ///
+    /// Neither closure escapes: both run only in the forked zygote, which
+    /// never returns from this call.
+    ///
+    /// - Parameters:
+    ///   - placement: Process group or session for the zygote and its workers.
+    ///   - preparation: Applied by the zygote to every worker fork; see
+    ///     `Fork.Preparation`. Regions must be mapped in the zygote, which
+    ///     is itself forked without it.
+    ///   - prepare: Runs once in the zygote before it reports ready.
+    ///   - entry: Runs in each worker with the worker's end of its channel.
+    ///     The return value becomes the worker's exit status.
+    /// - Returns: A zygote ready for `fork()`.
+    /// - Throws: `.fork` if the zygote cannot be forked, or `.zygote` if the
+    ///   control socket or the zygote's setpgid/setsid fails.
+    ///
+    /// See the type documentation for the fork-safety contract.
+    public static func start(
+        _ placement: Placement = .group,
+        preparation: POSIX.Kernel.Process.Fork.Preparation? = nil,
+        prepare: () -> Void = {},
+        entry: (Kernel.Socket.Descriptor) -> Int32
+    ) throws(POSIX.Kernel.Process.Error) -> POSIX.Kernel.Process.Zygote {
+        let (control, remote) = try pair().get()
+        closeOnExec(control)
+
+        let result: POSIX.Kernel.Process.Fork.Result
+        do {
+            result = try POSIX.Kernel.Process.Fork.fork()
+        } catch {
+            _ = release(control)
+            _ = release(remote)
+            throw error
+        }
+
+        switch result {
+        case .child:
+            _ = release(control)
+            serve(remote, placement: placement, preparation: preparation, prepare: prepare, entry: entry)
+
+        case .parent(let child):
+            _ = release(remote)
+            let zygote = POSIX.Kernel.Process.Zygote(pid: child, control: control)
+
+            guard let ready = receive(on: control) else {
+                zygote.close()
+                throw .zygote(.posix(EPIPE))
+            }
+            if ready.descriptor >= 0 { _ = release(ready.descriptor) }
+
+            guard ready.reply.error == 0 else {
+                zygote.close()
+                throw .zygote(.posix(ready.reply.error))
+            }
+            return zygote
+        }
+    }
+}
+
+// MARK: - Zygote Process
+
+extension POSIX.Kernel.Process.Zygote {
+    /// The zygote's main loop. Runs single-threaded; exits when the caller
+    /// closes its end of the control socket.
+    private static func serve(
+        _ control: Int32,
+        placement: Placement,
+        preparation: POSIX.Kernel.Process.Fork.Preparation?,
+        prepare: () -> Void,
+        entry: (Kernel.Socket.Descriptor) -> Int32
+    ) -> Never {
+        do {
+            switch placement {
+            case .group:
+                try POSIX.Kernel.Process.Group.set(.current, to: .same)
+            case .session:
+                _ = try POSIX.Kernel.Process.Session.create()
+            }
+        } catch {
+            _ = send(Message.Reply(pid: 0, error: error.code.posix ?? EINVAL), on: control)
+            POSIX.Kernel.Process.Exit.now(1)
+        }
+
+        // Workers are observed through their channels; let the kernel reap them
+        _ = try? POSIX.Kernel.Signal.Action.set(signal: .child, .init(handler: .ignore))
+
+        prepare()
+
+        guard send(Message.Reply(pid: getpid(), error: 0), on: control) else {
+            POSIX.Kernel.Process.Exit.now(1)
+        }
+
+        while true {
+            var command: Int32 = 0
+            var stray: Int32 = -1
+            let received = withUnsafeMutableBytes(of: &command) { bytes in
+                swift_descriptor_receive(control, bytes.baseAddress, bytes.count, &stray)
+            }
+            if stray >= 0 { _ = release(stray) }
+
+            // EOF or a broken control socket: the caller is gone
+            guard received == MemoryLayout<Int32>.size else {
+                POSIX.Kernel.Process.Exit.now(0)
+            }
+
+            guard command == Message.fork else {
+                _ = send(Message.Reply(pid: 0, error: EINVAL), on: control)
+                continue
+            }
+
+            let local: Int32
+            let worker: Int32
+            switch pair() {
+            case .success(let descriptors):
+                (local, worker) = descriptors
+            case .failure(let error):
+                _ = send(Message.Reply(pid: 0, error: error.code.posix ?? EINVAL), on: control)
+                continue
+            }
+
+            let result: POSIX.Kernel.Process.Fork.Result
+            do {
+                if let preparation {
+                    result = try POSIX.Kernel.Process.Fork.fork(preparing: preparation)
+                } else {
+                    result = try POSIX.Kernel.Process.Fork.fork()
+                }
+            } catch {
+                _ = release(local)
+                _ = release(worker)
+                _ = send(Message.Reply(pid: 0, error: error.code.posix ?? EAGAIN), on: control)
+                continue
+            }
+
+            switch result {
+            case .child:
+                _ = release(control)
+                _ = release(local)
+                _ = try? POSIX.Kernel.Signal.Action.set(signal: .child, .init(handler: .default))
+                POSIX.Kernel.Process.Exit.now(entry(Kernel.Socket.Descriptor(rawValue: worker)))
+
+            case .parent(let child):
+                _ = release(worker)
+                _ = send(Message.Reply(pid: child.rawValue, error: 0), descriptor: local, on: control)
+                _ = release(local)
+            }
+        }
+    }
+}
+
+// MARK: - Requests
+
+extension POSIX.Kernel.Process.Zygote {
+    /// Asks the zygote to fork one worker.
+    ///
+    /// One round trip on the control socket plus one `fork` in the zygote.
+    /// No exec and no dynamic linking. Safe to call from any thread;
+    /// concurrent requests are serialized.
+    ///
+    /// - Returns: The new worker, already running `entry`.
+    /// - Throws: `POSIX.Kernel.Process.Error.zygote` if the zygote is closed
+    ///   or gone (EPIPE), or if its socketpair/fork failed (that errno).
+    public func fork() throws(POSIX.Kernel.Process.Error) -> Worker {
+        let control = self.control
+        let result: Swift.Result<Worker, POSIX.Kernel.Process.Error> = closed.withLock { closed in
+            guard !closed else { return .failure(.zygote(.posix(EPIPE))) }
+
+            var command = Message.fork
+            let sent = withUnsafeBytes(of: &command) { bytes in
+                swift_descriptor_send(control, bytes.baseAddress, bytes.count, -1)
+            }
+            guard sent == MemoryLayout<Int32>.size else {
+                return .failure(.zygote(sent < 0 ? POSIX.Kernel.Error.captureErrno() : .posix(EPIPE)))
+            }
+
+            guard let message = Self.receive(on: control) else {
+                return .failure(.zygote(.posix(EPIPE)))
+            }
+            let (reply, descriptor) = message
+            guard reply.error == 0, descriptor >= 0 else {
+                if descriptor >= 0 { _ = Self.release(descriptor) }
+                return .failure(.zygote(.posix(reply.error == 0 ? EPIPE : reply.error)))
+            }
+
+            return .success(
+                Worker(
+                    pid: Kernel.Process.ID(reply.pid),
+                    channel: Kernel.Socket.Descriptor(rawValue: descriptor)
+                )
+            )
+        }
+        return try result.get()
+    }
+
+    /// Shuts the zygote down and reaps it.
+    ///
+    /// Closing the control socket makes the zygote exit. Running workers are
+    /// not affected. Idempotent; also called on deinit.
+    public func close() {
+        let first = closed.withLock { closed in
+            guard !closed else { return false }
+            closed = true
+            return true
+        }
+        guard first else { return }
+
+        _ = Self.release(control)
+
+        var status: Int32 = 0
+        while waitpid(pid.rawValue, &status, 0) == -1 && errno == EINTR {}
+    }
+}
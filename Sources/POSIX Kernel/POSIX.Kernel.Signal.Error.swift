@@ -42,6 +42,9 @@ extension POSIX.Kernel.Signal {
 
         /// Signal send operation failed (kill/raise).
         case send(Kernel.Error.Code)
+
+        /// Signal stream operation failed (signalfd/kqueue/read).
+        case stream(Kernel.Error.Code)
     }
 }
 
@@ -70,7 +73,7 @@ extension POSIX.Kernel.Signal.Error {
         switch self {
         case .interrupted:
             return nil
-        case .set(let c), .mask(let c), .action(let c), .send(let c):
+        case .set(let c), .mask(let c), .action(let c), .send(let c), .stream(let c):
             return c
         }
     }
@@ -131,6 +134,8 @@ extension POSIX.Kernel.Signal.Error: CustomStringConvertible {
             return "signal action operation failed: \(code)"
         case .send(let code):
             return "signal send operation failed: \(code)"
+        case .stream(let code):
+            return "signal stream operation failed: \(code)"
         }
     }
 }
@@ -0,0 +1,94 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Signal.Mask {
+    /// Runs `body` with `signals` blocked on the calling thread.
+    ///
+    /// The outermost scope blocks with one `pthread_sigmask(SIG_BLOCK)` and
+    /// restores the previous mask with one `SIG_SETMASK` on exit, however
+    /// `body` exits. A nested scope whose signals are already blocked by
+    /// an enclosing one only bumps a thread-local depth counter, so nesting
+    /// costs no syscalls.
+    ///
+    /// - Parameters:
+    ///   - signals: The signals to block. Defaults to `.blockable`, a cached set.
+    ///   - body: The critical section.
+    /// - Returns: The value `body` returns.
+    /// - Throws: Whatever `body` throws.
+    ///
+    /// ## Contract
+    ///
+    /// - `body` runs synchronously on the calling thread.
+    /// - Do not call `change` inside a scope in a way that unblocks the
+    ///   scope's signals: nested scopes trust the recorded state.
+    /// - SIGKILL and SIGSTOP can never be blocked.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// POSIX.Kernel.Signal.Mask.withBlocked(.termination) {
+    ///     registry.insert(child)
+    ///     POSIX.Kernel.Signal.Mask.withBlocked(.termination) {
+    ///         // No syscall: already blocked
+    ///     }
+    /// }
+    /// ```
+    public static func withBlocked<R, E: Swift.Error>(
+        _ signals: POSIX.Kernel.Signal.Set = .blockable,
+        _ body: () throws(E) -> R
+    ) throws(E) -> R {
+        let scope = swift_signal_scope_current()!
+
+        if scope.pointee.depth > 0, signals.isSubset(of: POSIX.Kernel.Signal.Set(storage: scope.pointee.covered)) {
+            scope.pointee.depth += 1
+            defer { scope.pointee.depth -= 1 }
+            return try body()
+        }
+
+        var previous = sigset_t()
+        let blocked = signals.withUnsafePointer { pthread_sigmask(SIG_BLOCK, $0, &previous) }
+        // Only EINVAL (a bad `how`) is possible, and SIG_BLOCK is valid
+        precondition(blocked == 0, "pthread_sigmask(SIG_BLOCK) failed: \(blocked)")
+
+        let outer = scope.pointee.covered
+        scope.pointee.covered =
+            scope.pointee.depth == 0
+            ? signals.storage
+            : POSIX.Kernel.Signal.Set(storage: outer).union(signals).storage
+        scope.pointee.depth += 1
+
+        defer {
+            scope.pointee.depth -= 1
+            scope.pointee.covered = outer
+            _ = pthread_sigmask(SIG_SETMASK, &previous, nil)
+        }
+        return try body()
+    }
+
+    /// Nesting depth of `withBlocked` scopes on the calling thread.
+    public static var depth: Int {
+        Int(swift_signal_scope_current()!.pointee.depth)
+    }
+}
@@ -0,0 +1,313 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+// MARK: - Disposition
+
+extension POSIX.Kernel.Signal.Number {
+    /// What a signal does to a process that has not changed its action.
+    ///
+    /// - POSIX: `SIG_DFL` semantics
+    public enum Disposition: Sendable, Equatable, Hashable {
+        /// Terminates the process.
+        case terminate
+
+        /// Terminates the process and may write a core dump.
+        case core
+
+        /// Discarded.
+        case ignore
+
+        /// Stops the process.
+        case stop
+
+        /// Continues the process if stopped.
+        case `continue`
+    }
+}
+
+// MARK: - Info
+
+extension POSIX.Kernel.Signal.Number {
+    /// Static metadata for one signal.
+    public struct Info: Sendable {
+        /// The signal this describes.
+        public let number: POSIX.Kernel.Signal.Number
+
+        /// The C name, e.g. `"SIGTERM"`; `"SIGRTMIN"` for real-time signals.
+        public let name: StaticString
+
+        /// Offset from SIGRTMIN for real-time signals; 0 otherwise.
+        public let offset: Int32
+
+        /// The default action.
+        public let disposition: Disposition
+
+        /// Whether a handler can be installed (false for SIGKILL and SIGSTOP).
+        public let isCatchable: Bool
+
+        /// Whether this is a real-time (queued) signal.
+        public let isRealtime: Bool
+
+        internal init(
+            _ rawValue: Int32,
+            _ name: StaticString,
+            _ disposition: Disposition,
+            catchable: Bool = true
+        ) {
+            self.number = POSIX.Kernel.Signal.Number(rawValue: rawValue)
+            self.name = name
+            self.offset = 0
+            self.disposition = disposition
+            self.isCatchable = catchable
+            self.isRealtime = false
+        }
+
+        /// A real-time signal, SIGRTMIN + `offset`.
+        internal init(realtime rawValue: Int32, offset: Int32) {
+            self.number = POSIX.Kernel.Signal.Number(rawValue: rawValue)
+            self.name = "SIGRTMIN"
+            self.offset = offset
+            self.disposition = .terminate
+            self.isCatchable = true
+            self.isRealtime = true
+        }
+    }
+}
+
+// MARK: - Lookup
+
+extension POSIX.Kernel.Signal.Number {
+    /// Metadata for this signal, or `nil` if the platform does not define it.
+    ///
+    /// O(1): one bounds check and one table load, no allocation.
+    public var info: Info? {
+        let table = Info.table
+        let raw = Int(rawValue)
+        if raw > 0 && raw < table.index.count {
+            let slot = table.index[raw]
+            if slot >= 0 {
+                return table.entries[Int(slot)]
+            }
+        }
+        guard let bounds = Info.bounds, bounds.contains(rawValue) else { return nil }
+        return Info(realtime: rawValue, offset: rawValue - bounds.lowerBound)
+    }
+
+    /// Looks up a signal by name.
+    ///
+    /// Accepts the C name with or without the `SIG` prefix (`"SIGTERM"`,
+    /// `"TERM"`), and `RTMIN+n` / `RTMAX-n` for real-time signals. Names
+    /// are case-sensitive. Standard names go through a perfect hash: one
+    /// hash, one probe, one comparison, no allocation.
+    public init?(name: String) {
+        var name = name
+        let found: Self? = name.withUTF8 { utf8 in
+            var bytes = UnsafeRawBufferPointer(utf8)
+            if bytes.count > 3 && bytes[0] == 0x53 && bytes[1] == 0x49 && bytes[2] == 0x47 {
+                bytes = UnsafeRawBufferPointer(rebasing: bytes[3...])
+            }
+            if let info = Info.table.lookup(bytes) {
+                return info.number
+            }
+            return Info.realtime(bytes)
+        }
+        guard let found else { return nil }
+        self = found
+    }
+
+    /// Every signal the platform defines, standard signals first.
+    public static let all: [Self] = Info.table.entries.map(\.number) + realtime
+
+    /// SIGRTMIN...SIGRTMAX; empty on Darwin.
+    public static let realtime: [Self] = Info.bounds.map { $0.map(Self.init(rawValue:)) } ?? []
+
+    /// SIGRTMIN + `offset`, or `nil` past SIGRTMAX or on Darwin.
+    public static func realtime(_ offset: Int32) -> Self? {
+        guard let bounds = Info.bounds, offset >= 0, offset <= bounds.upperBound - bounds.lowerBound else {
+            return nil
+        }
+        return Self(rawValue: bounds.lowerBound + offset)
+    }
+}
+
+// MARK: - Table
+
+extension POSIX.Kernel.Signal.Number.Info {
+    /// SIGRTMIN...SIGRTMAX as the C library reports them, or `nil`.
+    internal static let bounds: ClosedRange<Int32>? = {
+        let lower = swift_SIGRTMIN()
+        let upper = swift_SIGRTMAX()
+        return lower > 0 && upper >= lower ? lower...upper : nil
+    }()
+
+    /// The standard signals, built once.
+    internal static let table = Table([
+        Self(SIGHUP, "SIGHUP", .terminate),
+        Self(SIGINT, "SIGINT", .terminate),
+        Self(SIGQUIT, "SIGQUIT", .core),
+        Self(SIGILL, "SIGILL", .core),
+        Self(SIGTRAP, "SIGTRAP", .core),
+        Self(SIGABRT, "SIGABRT", .core),
+        Self(SIGBUS, "SIGBUS", .core),
+        Self(SIGFPE, "SIGFPE", .core),
+        Self(SIGKILL, "SIGKILL", .terminate, catchable: false),
+        Self(SIGUSR1, "SIGUSR1", .terminate),
+        Self(SIGSEGV, "SIGSEGV", .core),
+        Self(SIGUSR2, "SIGUSR2", .terminate),
+        Self(SIGPIPE, "SIGPIPE", .terminate),
+        Self(SIGALRM, "SIGALRM", .terminate),
+        Self(SIGTERM, "SIGTERM", .terminate),
+        Self(SIGCHLD, "SIGCHLD", .ignore),
+        Self(SIGCONT, "SIGCONT", .continue),
+        Self(SIGSTOP, "SIGSTOP", .stop, catchable: false),
+        Self(SIGTSTP, "SIGTSTP", .stop),
+        Self(SIGTTIN, "SIGTTIN", .stop),
+        Self(SIGTTOU, "SIGTTOU", .stop),
+        Self(SIGURG, "SIGURG", .ignore),
+        Self(SIGXCPU, "SIGXCPU", .core),
+        Self(SIGXFSZ, "SIGXFSZ", .core),
+        Self(SIGVTALRM, "SIGVTALRM", .terminate),
+        Self(SIGPROF, "SIGPROF", .terminate),
+        Self(SIGWINCH, "SIGWINCH", .ignore),
+        Self(SIGSYS, "SIGSYS", .core),
+    ] + platform)
+
+    #if canImport(Darwin)
+        private static let platform = [
+            Self(SIGIO, "SIGIO", .ignore),
+            Self(SIGEMT, "SIGEMT", .core),
+            Self(SIGINFO, "SIGINFO", .ignore),
+        ]
+    #else
+        private static let platform = [
+            Self(SIGIO, "SIGIO", .terminate),
+            Self(SIGSTKFLT, "SIGSTKFLT", .terminate),
+            Self(SIGPWR, "SIGPWR", .terminate),
+        ]
+    #endif
+
+    /// Parses `RTMIN`, `RTMIN+n`, `RTMAX` and `RTMAX-n`.
+    internal static func realtime(_ bytes: UnsafeRawBufferPointer) -> POSIX.Kernel.Signal.Number? {
+        guard let bounds, bytes.count >= 5,
+            bytes[0] == 0x52, bytes[1] == 0x54, bytes[2] == 0x4D  // "RTM"
+        else { return nil }
+
+        let base: Int32
+        let sign: UInt8
+        switch (bytes[3], bytes[4]) {
+        case (0x49, 0x4E):  // "IN"
+            base = bounds.lowerBound
+            sign = 0x2B  // "+"
+        case (0x41, 0x58):  // "AX"
+            base = bounds.upperBound
+            sign = 0x2D  // "-"
+        default:
+            return nil
+        }
+
+        var offset: Int32 = 0
+        if bytes.count > 5 {
+            guard bytes[5] == sign, bytes.count > 6, bytes.count <= 9 else { return nil }
+            for byte in bytes[6...] {
+                guard byte >= 0x30 && byte <= 0x39 else { return nil }
+                offset = offset * 10 + Int32(byte - 0x30)
+            }
+        }
+
+        let raw = sign == 0x2B ? base + offset : base - offset
+        return bounds.contains(raw) ? POSIX.Kernel.Signal.Number(rawValue: raw) : nil
+    }
+}
+
+extension POSIX.Kernel.Signal.Number.Info {
+    /// Number-indexed and name-hashed views of the standard signals.
+    ///
+    /// `index[n]` is the entry for signal `n`, or -1. Names (without the
+    /// `SIG` prefix) hash into `slots` with a seed chosen at build time so
+    /// that no two names collide, making every lookup a single probe.
+    internal struct Table: Sendable {
+        let entries: [POSIX.Kernel.Signal.Number.Info]
+        let index: [Int16]
+        let slots: [Int16]
+        let seed: UInt32
+
+        init(_ entries: [POSIX.Kernel.Signal.Number.Info]) {
+            self.entries = entries
+
+            let highest = entries.map { Int($0.number.rawValue) }.max() ?? 0
+            var index = [Int16](repeating: -1, count: highest + 1)
+            for (position, entry) in entries.enumerated() {
+                index[Int(entry.number.rawValue)] = Int16(position)
+            }
+            self.index = index
+            (self.slots, self.seed) = Self.perfect(entries)
+        }
+
+        /// Searches seeds, widening the table until one is collision-free.
+        private static func perfect(_ entries: [POSIX.Kernel.Signal.Number.Info]) -> ([Int16], UInt32) {
+            var size = 1
+            while size < entries.count * 2 {
+                size <<= 1
+            }
+            while true {
+                search: for seed in UInt32(1)...UInt32(4096) {
+                    var slots = [Int16](repeating: -1, count: size)
+                    for (position, entry) in entries.enumerated() {
+                        let hash = entry.name.withUTF8Buffer {
+                            Self.hash(UnsafeRawBufferPointer(rebasing: UnsafeRawBufferPointer($0)[3...]), seed)
+                        }
+                        let slot = hash & (size - 1)
+                        if slots[slot] >= 0 {
+                            continue search
+                        }
+                        slots[slot] = Int16(position)
+                    }
+                    return (slots, seed)
+                }
+                size <<= 1
+            }
+        }
+
+        /// FNV-1a over `bytes`, seeded.
+        static func hash(_ bytes: UnsafeRawBufferPointer, _ seed: UInt32) -> Int {
+            var hash: UInt32 = 2_166_136_261 ^ seed
+            for byte in bytes {
+                hash = (hash ^ UInt32(byte)) &* 16_777_619
+            }
+            return Int(hash ^ (hash >> 15))
+        }
+
+        /// The entry whose prefix-less name is exactly `bytes`, or `nil`.
+        func lookup(_ bytes: UnsafeRawBufferPointer) -> POSIX.Kernel.Signal.Number.Info? {
+            let slot = slots[Self.hash(bytes, seed) & (slots.count - 1)]
+            guard slot >= 0 else { return nil }
+            let entry = entries[Int(slot)]
+            let matches = entry.name.withUTF8Buffer { name in
+                name.count - 3 == bytes.count && zip(name[3...], bytes).allSatisfy { $0 == $1 }
+            }
+            return matches ? entry : nil
+        }
+    }
+}
@@ -198,37 +198,10 @@ extension POSIX.Kernel.Signal.Number {
 // MARK: - CustomStringConvertible
 
 extension POSIX.Kernel.Signal.Number: CustomStringConvertible {
+    /// The C name from `info` (`"SIGTERM"`, `"SIGRTMIN+2"`), or `"signal(n)"`.
     public var description: String {
-        switch self {
-        case .hangup: return "SIGHUP"
-        case .interrupt: return "SIGINT"
-        case .quit: return "SIGQUIT"
-        case .illegal: return "SIGILL"
-        case .trap: return "SIGTRAP"
-        case .abort: return "SIGABRT"
-        case .bus: return "SIGBUS"
-        case .floatingPoint: return "SIGFPE"
-        case .kill: return "SIGKILL"
-        case .user1: return "SIGUSR1"
-        case .segmentation: return "SIGSEGV"
-        case .user2: return "SIGUSR2"
-        case .pipe: return "SIGPIPE"
-        case .alarm: return "SIGALRM"
-        case .terminate: return "SIGTERM"
-        case .child: return "SIGCHLD"
-        case .continue: return "SIGCONT"
-        case .stop: return "SIGSTOP"
-        case .terminalStop: return "SIGTSTP"
-        case .terminalInput: return "SIGTTIN"
-        case .terminalOutput: return "SIGTTOU"
-        case .urgent: return "SIGURG"
-        case .cpuLimit: return "SIGXCPU"
-        case .fileLimit: return "SIGXFSZ"
-        case .virtualAlarm: return "SIGVTALRM"
-        case .profiling: return "SIGPROF"
-        case .windowChange: return "SIGWINCH"
-        case .io: return "SIGIO"
-        default: return "signal(\(rawValue))"
-        }
+        guard let info else { return "signal(\(rawValue))" }
+        guard info.offset > 0 else { return "\(info.name)" }
+        return "\(info.name)+\(info.offset)"
     }
 }
@@ -0,0 +1,160 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+// MARK: - Delivery
+
+extension POSIX.Kernel.Signal.Send {
+    /// The per-target outcome of a `toAll` fan-out.
+    ///
+    /// One bit per target, set when the send failed. The bitmap is not
+    /// allocated until the first failure, so a fully delivered fan-out
+    /// allocates nothing. Only the first failure's error code is kept.
+    public struct Delivery: Sendable, Equatable {
+        /// Number of targets signalled.
+        public let count: Int
+
+        /// Number of targets the signal could not be sent to.
+        public private(set) var failures: Int = 0
+
+        /// The error code of the first failed target, or `nil`.
+        public private(set) var error: Kernel.Error.Code?
+
+        /// Failure bits, 64 targets per word; empty until the first failure.
+        public private(set) var words: [UInt64] = []
+
+        internal init(count: Int) {
+            self.count = count
+        }
+    }
+}
+
+extension POSIX.Kernel.Signal.Send.Delivery {
+    /// Whether the signal was sent to every target.
+    public var isComplete: Bool { failures == 0 }
+
+    /// Whether the signal was sent to the target at `index`.
+    public subscript(index: Int) -> Bool {
+        precondition(index >= 0 && index < count, "index out of range")
+        guard !words.isEmpty else { return true }
+        return words[index >> 6] & (1 << UInt64(index & 63)) == 0
+    }
+
+    /// Indices of the targets the signal could not be sent to, ascending.
+    public var failed: [Int] {
+        var indices: [Int] = []
+        indices.reserveCapacity(failures)
+        for (offset, word) in words.enumerated() {
+            var remaining = word
+            while remaining != 0 {
+                indices.append(offset << 6 + remaining.trailingZeroBitCount)
+                remaining &= remaining - 1
+            }
+        }
+        return indices
+    }
+
+    /// Records a failure at `index`, capturing errno only for the first one.
+    internal mutating func fail(_ index: Int) {
+        if words.isEmpty {
+            // Capture before allocating; malloc may clobber errno
+            error = POSIX.Kernel.Error.captureErrno()
+            words = [UInt64](repeating: 0, count: (count + 63) >> 6)
+        }
+        words[index >> 6] |= 1 << UInt64(index & 63)
+        failures += 1
+    }
+}
+
+// MARK: - Fan-out
+
+extension POSIX.Kernel.Signal.Send {
+    /// Sends a signal to every process in `handles`.
+    ///
+    /// Built for draining a large fleet of children: a failed target sets
+    /// its bit in the result instead of throwing, so every target is tried
+    /// and no error is materialized past the first.
+    ///
+    /// - Parameters:
+    ///   - signal: The signal to send.
+    ///   - handles: Open handles for unreaped children.
+    /// - Returns: Which targets the signal was sent to.
+    ///
+    /// ## Platform Mapping
+    ///
+    /// | Platform | Call | PID reuse |
+    /// |----------|------|-----------|
+    /// | Linux | `pidfd_send_signal` (5.1+) on `descriptor` | Impossible: the pidfd names the process |
+    /// | Darwin | `kill(pid)` | Impossible while the child is unreaped |
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let delivery = POSIX.Kernel.Signal.Send.toAll(.terminate, workers)
+    /// for index in delivery.failed {
+    ///     try? POSIX.Kernel.Process.Kill.kill(workers[index].pid, .kill)
+    /// }
+    /// ```
+    public static func toAll(
+        _ signal: POSIX.Kernel.Signal.Number,
+        _ handles: some Collection<POSIX.Kernel.Process.Handle>
+    ) -> Delivery {
+        let start = POSIX.Kernel.Trace.start()
+        var delivery = Delivery(count: handles.count)
+        for (index, handle) in handles.enumerated() {
+            #if os(Linux)
+                let rc = swift_pidfd_send_signal(handle.descriptor.rawValue, signal.rawValue)
+            #else
+                let rc = kill(handle.pid.rawValue, signal.rawValue)
+            #endif
+            if rc != 0 {
+                delivery.fail(index)
+            }
+        }
+        POSIX.Kernel.Trace.finish(.send, since: start, detail: signal.rawValue)
+        return delivery
+    }
+
+    /// Sends a signal to every process in `pids`.
+    ///
+    /// Same contract as `toAll(_:_:)` over `kill`. Prefer handles: a PID
+    /// that is not an unreaped child of the caller may have been recycled.
+    ///
+    /// - Parameters:
+    ///   - signal: The signal to send.
+    ///   - pids: Target process IDs.
+    /// - Returns: Which targets the signal was sent to.
+    public static func toAll(
+        _ signal: POSIX.Kernel.Signal.Number,
+        pids: some Collection<Kernel.Process.ID>
+    ) -> Delivery {
+        let start = POSIX.Kernel.Trace.start()
+        var delivery = Delivery(count: pids.count)
+        for (index, pid) in pids.enumerated() where kill(pid.rawValue, signal.rawValue) != 0 {
+            delivery.fail(index)
+        }
+        POSIX.Kernel.Trace.finish(.send, since: start, detail: signal.rawValue)
+        return delivery
+    }
+}
@@ -58,9 +58,11 @@ extension POSIX.Kernel.Signal.Send {
         _ signal: POSIX.Kernel.Signal.Number,
         pid: Kernel.Process.ID
     ) throws(POSIX.Kernel.Signal.Error) {
+        let start = POSIX.Kernel.Trace.start()
         guard kill(pid.rawValue, signal.rawValue) == 0 else {
             throw .send(POSIX.Kernel.Error.captureErrno())
         }
+        POSIX.Kernel.Trace.finish(.send, since: start, pid: pid.rawValue, detail: signal.rawValue)
     }
 
     /// Sends a signal to the calling process.
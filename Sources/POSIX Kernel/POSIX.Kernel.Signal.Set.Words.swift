@@ -0,0 +1,270 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+#elseif canImport(Glibc)
+    internal import Glibc
+#elseif canImport(Musl)
+    internal import Musl
+#endif
+
+// MARK: - Words
+//
+// Signal n is bit (n - 1) of the `sigset_t` viewed as an array of words:
+// one `UInt32` on Darwin, `unsigned long`s on glibc and musl. These are
+// the layouts `sigaddset`/`sigismember` use, so word-built sets interoperate
+// with libc-built ones.
+
+extension POSIX.Kernel.Signal.Set {
+    #if canImport(Darwin)
+        internal typealias Word = UInt32
+    #else
+        internal typealias Word = UInt
+    #endif
+
+    /// Words in a `sigset_t`.
+    internal static let words = MemoryLayout<sigset_t>.size / MemoryLayout<Word>.size
+
+    /// The highest signal number on this platform (SIGRTMAX on Linux).
+    internal static let highest: Int32 = max(
+        POSIX.Kernel.Signal.Number.Info.bounds?.upperBound ?? 0,
+        POSIX.Kernel.Signal.Number.Info.table.entries.map(\.number.rawValue).max() ?? 0
+    )
+
+    /// Applies `operation` word by word to `self` and `other`.
+    private mutating func combine(_ other: Self, _ operation: (Word, Word) -> Word) {
+        let stride = MemoryLayout<Word>.stride
+        Swift.withUnsafeBytes(of: other.storage) { rhs in
+            Swift.withUnsafeMutableBytes(of: &storage) { lhs in
+                for offset in Swift.stride(from: 0, to: Self.words * stride, by: stride) {
+                    let word = operation(
+                        lhs.load(fromByteOffset: offset, as: Word.self),
+                        rhs.load(fromByteOffset: offset, as: Word.self)
+                    )
+                    lhs.storeBytes(of: word, toByteOffset: offset, as: Word.self)
+                }
+            }
+        }
+    }
+
+    /// Sets or clears the bit for `signal`; ignores numbers outside the set.
+    private mutating func update(_ signal: POSIX.Kernel.Signal.Number, _ present: Bool) {
+        let index = Int(signal.rawValue) - 1
+        guard index >= 0 && index < Self.words * Word.bitWidth else { return }
+
+        let offset = (index / Word.bitWidth) * MemoryLayout<Word>.stride
+        let bit = Word(1) << Word(index % Word.bitWidth)
+        Swift.withUnsafeMutableBytes(of: &storage) { bytes in
+            let word = bytes.load(fromByteOffset: offset, as: Word.self)
+            bytes.storeBytes(of: present ? word | bit : word & ~bit, toByteOffset: offset, as: Word.self)
+        }
+    }
+}
+
+// MARK: - Bulk Construction
+
+extension POSIX.Kernel.Signal.Set {
+    /// Creates a set from signals without validation, by setting bits directly.
+    ///
+    /// No libc call per signal. Numbers outside the platform's `sigset_t`
+    /// are dropped rather than reported; use the throwing `init(_:)` for
+    /// untrusted input.
+    public init(__unchecked: Void, _ signals: some Sequence<POSIX.Kernel.Signal.Number>) {
+        self.init()
+        for signal in signals {
+            update(signal, true)
+        }
+    }
+
+    /// Adds `signal` by setting its bit, without validation.
+    public mutating func insert(__unchecked: Void, _ signal: POSIX.Kernel.Signal.Number) {
+        update(signal, true)
+    }
+
+    /// Removes `signal` by clearing its bit, without validation.
+    public mutating func remove(__unchecked: Void, _ signal: POSIX.Kernel.Signal.Number) {
+        update(signal, false)
+    }
+
+    /// Whether the bit for `signal` is set; `false` for out-of-range numbers.
+    public func contains(__unchecked: Void, _ signal: POSIX.Kernel.Signal.Number) -> Bool {
+        let index = Int(signal.rawValue) - 1
+        guard index >= 0 && index < Self.words * Word.bitWidth else { return false }
+
+        let offset = (index / Word.bitWidth) * MemoryLayout<Word>.stride
+        let word = Swift.withUnsafeBytes(of: storage) { $0.load(fromByteOffset: offset, as: Word.self) }
+        return word & (Word(1) << Word(index % Word.bitWidth)) != 0
+    }
+}
+
+// MARK: - Algebra
+
+extension POSIX.Kernel.Signal.Set {
+    /// Signals in either set.
+    public func union(_ other: Self) -> Self {
+        var result = self
+        result.formUnion(other)
+        return result
+    }
+
+    /// Signals in both sets.
+    public func intersection(_ other: Self) -> Self {
+        var result = self
+        result.formIntersection(other)
+        return result
+    }
+
+    /// Signals in `self` but not in `other`.
+    public func subtracting(_ other: Self) -> Self {
+        var result = self
+        result.subtract(other)
+        return result
+    }
+
+    /// Adds every signal in `other`.
+    public mutating func formUnion(_ other: Self) {
+        combine(other) { $0 | $1 }
+    }
+
+    /// Keeps only signals also in `other`.
+    public mutating func formIntersection(_ other: Self) {
+        combine(other) { $0 & $1 }
+    }
+
+    /// Removes every signal in `other`.
+    public mutating func subtract(_ other: Self) {
+        combine(other) { $0 & ~$1 }
+    }
+
+    /// Whether every signal in `self` is also in `other`.
+    public func isSubset(of other: Self) -> Bool {
+        Swift.withUnsafeBytes(of: storage) { lhs in
+            Swift.withUnsafeBytes(of: other.storage) { rhs in
+                let stride = MemoryLayout<Word>.stride
+                for offset in Swift.stride(from: 0, to: Self.words * stride, by: stride) {
+                    let word = lhs.load(fromByteOffset: offset, as: Word.self)
+                    if word & ~rhs.load(fromByteOffset: offset, as: Word.self) != 0 {
+                        return false
+                    }
+                }
+                return true
+            }
+        }
+    }
+
+    /// Whether no signal of this platform is in the set.
+    public var isEmpty: Bool {
+        var members = members
+        return members.next() == nil
+    }
+
+    /// Number of signals of this platform in the set.
+    public var count: Int {
+        var count = 0
+        for _ in members {
+            count += 1
+        }
+        return count
+    }
+}
+
+// MARK: - Equatable, Hashable
+
+extension POSIX.Kernel.Signal.Set: Equatable, Hashable {
+    /// Compares every word of the `sigset_t`.
+    public static func == (lhs: Self, rhs: Self) -> Bool {
+        Swift.withUnsafeBytes(of: lhs.storage) { left in
+            Swift.withUnsafeBytes(of: rhs.storage) { right in
+                left.elementsEqual(right)
+            }
+        }
+    }
+
+    public func hash(into hasher: inout Hasher) {
+        Swift.withUnsafeBytes(of: storage) { hasher.combine(bytes: $0) }
+    }
+}
+
+// MARK: - Members
+
+extension POSIX.Kernel.Signal.Set {
+    /// The signals in the set, ascending, up to SIGRTMAX (or NSIG - 1).
+    ///
+    /// Iterates set bits a word at a time with no libc calls. Bits past
+    /// the platform's highest signal (which `sigfillset` sets on glibc)
+    /// are skipped.
+    public var members: Members { Members(self) }
+
+    /// A sequence of the signals in a set.
+    public struct Members: Sequence, IteratorProtocol, Sendable {
+        private let set: POSIX.Kernel.Signal.Set
+        private var index = 0
+        private var remaining: Word
+
+        internal init(_ set: POSIX.Kernel.Signal.Set) {
+            self.set = set
+            self.remaining = set.word(0)
+        }
+
+        public mutating func next() -> POSIX.Kernel.Signal.Number? {
+            let limit = Int(POSIX.Kernel.Signal.Set.highest)
+            while remaining == 0 {
+                index += 1
+                guard index < POSIX.Kernel.Signal.Set.words, index * Word.bitWidth < limit else { return nil }
+                remaining = set.word(index)
+            }
+
+            let number = index * Word.bitWidth + remaining.trailingZeroBitCount + 1
+            guard number <= limit else { return nil }
+            remaining &= remaining - 1
+            return POSIX.Kernel.Signal.Number(rawValue: Int32(number))
+        }
+    }
+
+    /// The word at `index`.
+    fileprivate func word(_ index: Int) -> Word {
+        Swift.withUnsafeBytes(of: storage) {
+            $0.load(fromByteOffset: index * MemoryLayout<Word>.stride, as: Word.self)
+        }
+    }
+}
+
+// MARK: - Canonical Sets
+
+extension POSIX.Kernel.Signal.Set {
+    /// Every signal that can be blocked: `.all` without SIGKILL and SIGSTOP.
+    ///
+    /// Built once, so blocking "everything" costs a copy, not a `sigfillset`.
+    public static let blockable: Self = {
+        var set = Self.all
+        set.remove(__unchecked: (), .kill)
+        set.remove(__unchecked: (), .stop)
+        return set
+    }()
+
+    /// The catchable job-control signals: SIGTSTP, SIGTTIN, SIGTTOU, SIGCONT.
+    ///
+    /// SIGSTOP is excluded: it cannot be blocked or caught.
+    public static let jobControl = Self(
+        __unchecked: (),
+        [.terminalStop, .terminalInput, .terminalOutput, .continue]
+    )
+
+    /// The signals that ask a process to exit: SIGHUP, SIGINT, SIGQUIT, SIGTERM.
+    public static let termination = Self(
+        __unchecked: (),
+        [.hangup, .interrupt, .quit, .terminate]
+    )
+}
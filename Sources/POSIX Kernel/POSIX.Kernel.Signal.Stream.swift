@@ -0,0 +1,398 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+internal import Synchronization
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Signal {
+    /// Synchronous signal delivery through a pollable descriptor.
+    ///
+    /// Blocks the given signals on the calling thread and routes them to a
+    /// descriptor instead of an asynchronous handler:
+    ///
+    /// | Platform | Descriptor | Batching |
+    /// |----------|------------|----------|
+    /// | Linux | `signalfd` | Many `signalfd_siginfo` per `read` |
+    /// | Darwin | kqueue with `EVFILT_SIGNAL` | Repeats coalesced into `Record.count` |
+    ///
+    /// Consume it either from an event loop (poll `descriptor`, then `read(into:)`)
+    /// or as an `AsyncSequence` through `records()`.
+    ///
+    /// ## Signal Mask
+    ///
+    /// Signals must be blocked in EVERY thread, or the kernel may deliver
+    /// them to a thread that still has them unblocked. Create the stream on
+    /// the main thread before other threads start, so they inherit the mask.
+    /// Closing the stream does not unblock the signals.
+    ///
+    /// ## Reaping
+    ///
+    /// Standard signals coalesce: several exiting children can produce one
+    /// `.child` record. Answer each `.child` record with `Wait.drain`
+    /// rather than a single `Wait.wait`.
+    ///
+    /// ```swift
+    /// var signals = POSIX.Kernel.Signal.Set()
+    /// try signals.insert(.child)
+    /// try signals.insert(.terminate)
+    /// let stream = try POSIX.Kernel.Signal.Stream(signals)
+    ///
+    /// for await record in try stream.records() {
+    ///     switch record.signal {
+    ///     case .child:
+    ///         var count: Int
+    ///         repeat {
+    ///             count = try POSIX.Kernel.Process.Wait.drain(into: buffer)
+    ///             for result in buffer[..<count] { complete(result) }
+    ///         } while count == buffer.count
+    ///     case .terminate:
+    ///         stream.close()
+    ///     default:
+    ///         break
+    ///     }
+    /// }
+    /// ```
+    ///
+    /// ## Thread Safety
+    ///
+    /// `read(into:)` may be called from one thread at a time. `records()`
+    /// and `close()` are synchronized.
+    public final class Stream: @unchecked Sendable {
+        /// The signals routed to this stream.
+        public let signals: POSIX.Kernel.Signal.Set
+
+        /// Nonblocking, close-on-exec descriptor that is readable while
+        /// signals are pending (signalfd on Linux, kqueue on Darwin).
+        public let descriptor: Kernel.Descriptor
+
+        private let state = Mutex(State())
+
+        /// Creates a stream for `signals`, blocking them on the calling thread.
+        ///
+        /// - Parameter signals: Signals to route to the stream.
+        /// - Throws: `Error.mask` if blocking fails, `Error.stream` if the
+        ///   descriptor cannot be created (the previous mask is restored).
+        public init(_ signals: POSIX.Kernel.Signal.Set) throws(POSIX.Kernel.Signal.Error) {
+            let previous = try POSIX.Kernel.Signal.Mask.change(.block, signals: signals)
+
+            let fd = signals.withUnsafePointer { mask in
+                swift_signal_stream_open(mask)
+            }
+            guard fd >= 0 else {
+                let code = POSIX.Kernel.Error.captureErrno()
+                _ = try? POSIX.Kernel.Signal.Mask.change(.set, signals: previous)
+                throw .stream(code)
+            }
+
+            self.signals = signals
+            self.descriptor = Kernel.Descriptor(rawValue: fd)
+        }
+
+        deinit {
+            close()
+        }
+    }
+}
+
+// MARK: - Record
+
+extension POSIX.Kernel.Signal.Stream {
+    /// One signal notification read from the stream.
+    public struct Record: Sendable, Equatable {
+        /// The signal that was delivered.
+        public let signal: POSIX.Kernel.Signal.Number
+
+        /// Deliveries coalesced into this record.
+        ///
+        /// Always 1 on Linux; on Darwin, the number of times the signal was
+        /// sent since the previous read.
+        public let count: Int
+
+        /// The sending process, where the platform reports it.
+        ///
+        /// Set on Linux (`ssi_pid`); always `nil` on Darwin.
+        public let sender: Kernel.Process.ID?
+
+        public init(
+            signal: POSIX.Kernel.Signal.Number,
+            count: Int = 1,
+            sender: Kernel.Process.ID? = nil
+        ) {
+            self.signal = signal
+            self.count = count
+            self.sender = sender
+        }
+
+        internal init(_ raw: swift_signal_record) {
+            #if POSIX_KERNEL_TRACING
+                if raw.signo == SIGCHLD {
+                    POSIX.Kernel.Trace.mark(.child, pid: raw.pid, detail: raw.signo)
+                }
+            #endif
+            self.init(
+                signal: POSIX.Kernel.Signal.Number(rawValue: raw.signo),
+                count: Int(raw.count),
+                sender: raw.pid > 0 ? Kernel.Process.ID(raw.pid) : nil
+            )
+        }
+    }
+}
+
+// MARK: - Read
+
+extension POSIX.Kernel.Signal.Stream {
+    /// Reads pending signals without blocking.
+    ///
+    /// One syscall reads up to 64 records; call again while the
+    /// return value equals `min(buffer.count, 64)` to drain a burst.
+    ///
+    /// - Parameter buffer: Caller-owned storage, written from index 0.
+    /// - Returns: The number of records written (0 if none pending or
+    ///   `buffer` is empty; no syscall is made for an empty buffer).
+    /// - Throws: `Error.stream` on failure.
+    public func read(
+        into buffer: UnsafeMutableBufferPointer<Record>
+    ) throws(POSIX.Kernel.Signal.Error) -> Int {
+        guard !buffer.isEmpty, let base = buffer.baseAddress else { return 0 }
+
+        let capacity = min(buffer.count, Int(SWIFT_SIGNAL_BATCH))
+        let result: Swift.Result<Int, POSIX.Kernel.Signal.Error> = withUnsafeTemporaryAllocation(
+            of: swift_signal_record.self,
+            capacity: capacity
+        ) { raw in
+            let n = swift_signal_stream_read(descriptor.rawValue, raw.baseAddress!, Int32(capacity))
+            guard n >= 0 else {
+                return .failure(.stream(POSIX.Kernel.Error.captureErrno()))
+            }
+            for i in 0..<Int(n) {
+                (base + i).initialize(to: Record(raw[i]))
+            }
+            return .success(Int(n))
+        }
+        return try result.get()
+    }
+}
+
+// MARK: - AsyncSequence
+
+extension POSIX.Kernel.Signal.Stream {
+    /// Returns the stream's records as an `AsyncSequence`.
+    ///
+    /// The first call starts one reader thread that sleeps in `poll` and
+    /// yields each batch it reads; later calls return the same sequence.
+    /// The sequence finishes when the stream is closed.
+    ///
+    /// Do not mix with `read(into:)`: both consume the same records.
+    ///
+    /// - Returns: The record sequence.
+    /// - Throws: `Error.stream` if the reader thread cannot be started.
+    public func records() throws(POSIX.Kernel.Signal.Error) -> AsyncStream<Record> {
+        let descriptor = self.descriptor.rawValue
+        let result: Swift.Result<AsyncStream<Record>, POSIX.Kernel.Signal.Error> = state.withLock { state in
+            if let reader = state.reader {
+                return .success(reader.records)
+            }
+
+            if state.closed {
+                let (records, continuation) = AsyncStream.makeStream(of: Record.self)
+                continuation.finish()
+                return .success(records)
+            }
+
+            switch Reader.start(descriptor: descriptor) {
+            case .success(let reader):
+                state.reader = reader
+                return .success(reader.records)
+            case .failure(let error):
+                return .failure(error)
+            }
+        }
+        return try result.get()
+    }
+}
+
+// MARK: - Close
+
+extension POSIX.Kernel.Signal.Stream {
+    /// Stops the reader thread (if any) and closes the descriptor.
+    ///
+    /// Idempotent. Finishes the `records()` sequence. The signals stay
+    /// blocked; pending ones remain pending.
+    public func close() {
+        let (first, reader): (Bool, Reader?) = state.withLock { state in
+            guard !state.closed else { return (false, nil) }
+            state.closed = true
+            let reader = state.reader
+            state.reader = nil
+            return (true, reader)
+        }
+        guard first else { return }
+
+        // Join the reader before closing, so it never polls a recycled descriptor
+        reader?.stop()
+        #if canImport(Darwin)
+            _ = Darwin.close(descriptor.rawValue)
+        #elseif canImport(Glibc)
+            _ = Glibc.close(descriptor.rawValue)
+        #elseif canImport(Musl)
+            _ = Musl.close(descriptor.rawValue)
+        #endif
+    }
+}
+
+// MARK: - State
+
+extension POSIX.Kernel.Signal.Stream {
+    fileprivate struct State {
+        var closed = false
+        var reader: Reader?
+    }
+}
+
+// MARK: - Reader Thread
+
+extension POSIX.Kernel.Signal.Stream {
+    /// Background thread that polls the stream and feeds `records()`.
+    ///
+    /// Woken for shutdown through a private pipe, since closing a
+    /// descriptor does not interrupt a `poll` on it.
+    ///
+    /// The thread starts with every signal blocked. It would otherwise
+    /// inherit the mask of whichever thread calls `records()`, which need
+    /// not block the stream's signals, and a process-directed signal could
+    /// take its default action there instead of reaching the stream.
+    fileprivate final class Reader: @unchecked Sendable {
+        let descriptor: Int32
+        let wake: (read: Int32, write: Int32)
+        let records: AsyncStream<Record>
+        let continuation: AsyncStream<Record>.Continuation
+        var thread: pthread_t?
+
+        private init(descriptor: Int32, wake: (read: Int32, write: Int32)) {
+            self.descriptor = descriptor
+            self.wake = wake
+            let (records, continuation) = AsyncStream.makeStream(of: Record.self)
+            self.records = records
+            self.continuation = continuation
+        }
+
+        static func start(descriptor: Int32) -> Swift.Result<Reader, POSIX.Kernel.Signal.Error> {
+            // Atomic pipe2(O_CLOEXEC) on Linux, so a concurrent fork+exec
+            // cannot inherit either end; Darwin has no pipe2
+            var read: Int32 = -1
+            var write: Int32 = -1
+            guard swift_pipe(Int32(SWIFT_PIPE_CLOEXEC), &read, &write) == 0 else {
+                return .failure(.stream(POSIX.Kernel.Error.captureErrno()))
+            }
+
+            let reader = Reader(descriptor: descriptor, wake: (read, write))
+            let context = Unmanaged.passRetained(reader).toOpaque()
+
+            // The new thread inherits this mask; restored once it exists
+            var all = sigset_t()
+            var previous = sigset_t()
+            sigfillset(&all)
+            _ = pthread_sigmask(SIG_SETMASK, &all, &previous)
+            defer { _ = pthread_sigmask(SIG_SETMASK, &previous, nil) }
+
+            #if canImport(Darwin)
+                var thread: pthread_t?
+                let rc = pthread_create(&thread, nil, { context in
+                    Unmanaged<Reader>.fromOpaque(context).takeRetainedValue().run()
+                    return nil
+                }, context)
+            #else
+                var thread = pthread_t()
+                let rc = pthread_create(&thread, nil, { context in
+                    Unmanaged<Reader>.fromOpaque(context!).takeRetainedValue().run()
+                    return nil
+                }, context)
+            #endif
+
+            guard rc == 0 else {
+                Unmanaged<Reader>.fromOpaque(context).release()
+                reader.closeWake()
+                return .failure(.stream(.posix(rc)))
+            }
+
+            reader.thread = thread
+            return .success(reader)
+        }
+
+        /// Thread body: poll, batch-read, yield.
+        private func run() {
+            let polls = UnsafeMutablePointer<pollfd>.allocate(capacity: 2)
+            let raw = UnsafeMutablePointer<swift_signal_record>.allocate(capacity: Int(SWIFT_SIGNAL_BATCH))
+            defer {
+                polls.deallocate()
+                raw.deallocate()
+            }
+            polls.initialize(to: pollfd(fd: descriptor, events: Int16(POLLIN), revents: 0))
+            (polls + 1).initialize(to: pollfd(fd: wake.read, events: Int16(POLLIN), revents: 0))
+
+            while true {
+                polls[0].revents = 0
+                polls[1].revents = 0
+                if poll(polls, 2, -1) < 0 {
+                    if errno == EINTR { continue }
+                    break
+                }
+                if polls[1].revents != 0 {
+                    break
+                }
+
+                let n = swift_signal_stream_read(descriptor, raw, SWIFT_SIGNAL_BATCH)
+                if n < 0 {
+                    break
+                }
+                for i in 0..<Int(n) {
+                    continuation.yield(Record(raw[i]))
+                }
+            }
+            continuation.finish()
+        }
+
+        /// Wakes and joins the thread, then releases the wake pipe.
+        func stop() {
+            var byte: UInt8 = 0
+            _ = write(wake.write, &byte, 1)
+            if let thread {
+                _ = pthread_join(thread, nil)
+            }
+            closeWake()
+        }
+
+        private func closeWake() {
+            #if canImport(Darwin)
+                _ = Darwin.close(wake.read)
+                _ = Darwin.close(wake.write)
+            #elseif canImport(Glibc)
+                _ = Glibc.close(wake.read)
+                _ = Glibc.close(wake.write)
+            #elseif canImport(Musl)
+                _ = Musl.close(wake.read)
+                _ = Musl.close(wake.write)
+            #endif
+        }
+    }
+}
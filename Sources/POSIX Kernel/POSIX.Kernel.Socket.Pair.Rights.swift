@@ -0,0 +1,182 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+
+#if canImport(Darwin)
+    internal import Darwin
+    internal import CPOSIXProcessShim
+#elseif canImport(Glibc)
+    internal import Glibc
+    internal import CPOSIXProcessShim
+#elseif canImport(Musl)
+    internal import Musl
+    internal import CPOSIXProcessShim
+#endif
+
+extension POSIX.Kernel.Socket.Pair {
+    /// Descriptor passing over a socket pair (SCM_RIGHTS).
+    ///
+    /// Sends a batch of descriptors together with a payload in one
+    /// `sendmsg`. The receiver gets new descriptors for the same open files:
+    /// an accepting process can hand connections to workers without proxying
+    /// their bytes. The control buffer is on the stack; no call allocates.
+    ///
+    /// ## Message Boundaries
+    ///
+    /// Use a `.sequenced` or `.datagram` pair so each `receive` returns
+    /// exactly one `send` with its descriptors. On a `.stream` pair the
+    /// payload must be at least one byte, and descriptors attach to the
+    /// first byte of their payload.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let (parent, worker) = try POSIX.Kernel.Socket.Pair.create(.sequenced, options: .cloexec)
+    ///
+    /// // Accepting process: one syscall per batch
+    /// var tag: UInt8 = 0
+    /// _ = try withUnsafeBytes(of: &tag) { bytes in
+    ///     try POSIX.Kernel.Socket.Pair.Rights.send(parent, accepted, bytes: bytes)
+    /// }
+    ///
+    /// // Worker
+    /// let received = try POSIX.Kernel.Socket.Pair.Rights.receive(worker, into: descriptors, bytes: buffer)
+    /// for client in descriptors.prefix(received.descriptors) { ... }
+    /// ```
+    public enum Rights {}
+}
+
+extension POSIX.Kernel.Socket.Pair.Rights {
+    /// Most descriptors in one message (Linux SCM_MAX_FD).
+    public static var maximum: Int { Int(SWIFT_RIGHTS_MAX) }
+
+    /// The outcome of a `receive`.
+    public struct Received: Sendable, Equatable {
+        /// Payload bytes received. Zero means the peer closed.
+        public let bytes: Int
+
+        /// Descriptors written to the front of the buffer.
+        public let descriptors: Int
+
+        public init(bytes: Int, descriptors: Int) {
+            self.bytes = bytes
+            self.descriptors = descriptors
+        }
+    }
+}
+
+// MARK: - Send
+
+extension POSIX.Kernel.Socket.Pair.Rights {
+    /// Sends `bytes` and `descriptors` in one message (sendmsg).
+    ///
+    /// The caller keeps its descriptors; close them once sent if the
+    /// receiver now owns the files.
+    ///
+    /// - Parameters:
+    ///   - socket: Sending end of the pair.
+    ///   - descriptors: Up to `maximum` descriptors. May be empty.
+    ///   - bytes: Payload sent with the descriptors.
+    /// - Returns: Payload bytes sent.
+    /// - Throws: ``POSIX/Kernel/Socket/Pair/Error`` on failure (EINVAL for
+    ///   more than `maximum` descriptors). Retries on EINTR.
+    @discardableResult
+    public static func send(
+        _ socket: Kernel.Socket.Descriptor,
+        _ descriptors: UnsafeBufferPointer<Kernel.Descriptor>,
+        bytes: UnsafeRawBufferPointer
+    ) throws(POSIX.Kernel.Socket.Pair.Error) -> Int {
+        guard descriptors.count <= maximum else {
+            throw .platform(.posix(EINVAL))
+        }
+
+        // errno is read inside the closure, before the buffer is released
+        let result: Swift.Result<Int, POSIX.Kernel.Socket.Pair.Error> =
+            withUnsafeTemporaryAllocation(of: Int32.self, capacity: max(descriptors.count, 1)) { raw in
+                for (index, descriptor) in descriptors.enumerated() {
+                    raw[index] = descriptor.rawValue
+                }
+                let sent = swift_descriptors_send(
+                    socket.rawValue,
+                    bytes.baseAddress,
+                    bytes.count,
+                    raw.baseAddress,
+                    Int32(descriptors.count)
+                )
+                return sent >= 0 ? .success(sent) : .failure(POSIX.Kernel.Socket.Pair.currentError())
+            }
+        return try result.get()
+    }
+
+    /// Sends `bytes` and `descriptors` in one message.
+    ///
+    /// Same semantics as `send(_:_:bytes:)`.
+    @discardableResult
+    public static func send(
+        _ socket: Kernel.Socket.Descriptor,
+        _ descriptors: [Kernel.Descriptor],
+        bytes: UnsafeRawBufferPointer
+    ) throws(POSIX.Kernel.Socket.Pair.Error) -> Int {
+        try descriptors.withUnsafeBufferPointer { buffer throws(POSIX.Kernel.Socket.Pair.Error) in
+            try send(socket, buffer, bytes: bytes)
+        }
+    }
+}
+
+// MARK: - Receive
+
+extension POSIX.Kernel.Socket.Pair.Rights {
+    /// Receives one message and the descriptors passed with it (recvmsg).
+    ///
+    /// Received descriptors are close-on-exec (MSG_CMSG_CLOEXEC on Linux,
+    /// `fcntl` on Darwin) and owned by the caller.
+    ///
+    /// - Parameters:
+    ///   - socket: Receiving end of the pair.
+    ///   - descriptors: Buffer for up to `maximum` received descriptors.
+    ///     Elements past `Received.descriptors` are left untouched.
+    ///   - bytes: Buffer for the payload.
+    /// - Returns: Payload and descriptor counts.
+    /// - Throws: ``POSIX/Kernel/Socket/Pair/Error`` on failure. Retries on
+    ///   EINTR; EAGAIN on a `.nonblocking` pair with nothing queued.
+    ///   EMSGSIZE if the sender passed more descriptors than `descriptors`
+    ///   holds (MSG_CTRUNC): the message is consumed and every descriptor
+    ///   that did arrive is closed.
+    public static func receive(
+        _ socket: Kernel.Socket.Descriptor,
+        into descriptors: UnsafeMutableBufferPointer<Kernel.Descriptor>,
+        bytes: UnsafeMutableRawBufferPointer
+    ) throws(POSIX.Kernel.Socket.Pair.Error) -> Received {
+        let capacity = min(descriptors.count, maximum)
+        var count: Int32 = 0
+
+        let result: Swift.Result<Int, POSIX.Kernel.Socket.Pair.Error> =
+            withUnsafeTemporaryAllocation(of: Int32.self, capacity: max(capacity, 1)) { raw in
+                let received = swift_descriptors_receive(
+                    socket.rawValue,
+                    bytes.baseAddress,
+                    bytes.count,
+                    raw.baseAddress,
+                    Int32(capacity),
+                    &count
+                )
+                guard received >= 0 else {
+                    return .failure(POSIX.Kernel.Socket.Pair.currentError())
+                }
+                for index in 0..<Int(count) {
+                    descriptors[index] = Kernel.Descriptor(rawValue: raw[index])
+                }
+                return .success(received)
+            }
+        return Received(bytes: try result.get(), descriptors: Int(count))
+    }
+}
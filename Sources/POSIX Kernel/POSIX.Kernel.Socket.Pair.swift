@@ -13,10 +13,13 @@ public import Kernel_Primitives
 
 #if canImport(Darwin)
     internal import Darwin
+    internal import CPOSIXProcessShim
 #elseif canImport(Glibc)
     internal import Glibc
+    internal import CPOSIXProcessShim
 #elseif canImport(Musl)
     internal import Musl
+    internal import CPOSIXProcessShim
 #endif
 
 extension POSIX.Kernel.Socket {
@@ -59,22 +62,86 @@ extension POSIX.Kernel.Socket.Pair.Error: CustomStringConvertible {
         case .platform(let p):
             switch p {
             case .posix(let code):
-                return "socketpair failed: errno \(code)"
+                return "socket pair operation failed: errno \(code)"
             }
         }
     }
 }
 
+// MARK: - Kind
+
+extension POSIX.Kernel.Socket.Pair {
+    /// Socket type of a pair (SOCK_*).
+    public struct Kind: RawRepresentable, Sendable, Equatable, Hashable {
+        public let rawValue: Int32
+
+        public init(rawValue: Int32) {
+            self.rawValue = rawValue
+        }
+    }
+}
+
+extension POSIX.Kernel.Socket.Pair.Kind {
+    #if canImport(Glibc)
+        private init(_ type: __socket_type) {
+            self.init(rawValue: Int32(type.rawValue))
+        }
+    #else
+        private init(_ type: Int32) {
+            self.init(rawValue: type)
+        }
+    #endif
+
+    /// Byte stream without message boundaries (SOCK_STREAM).
+    public static var stream: Self { Self(SOCK_STREAM) }
+
+    /// Reliable, ordered messages with preserved boundaries (SOCK_SEQPACKET).
+    ///
+    /// Each `recv` returns exactly one `send`, so descriptors passed with
+    /// `Rights.send` stay attached to their message.
+    public static var sequenced: Self { Self(SOCK_SEQPACKET) }
+
+    /// Messages with preserved boundaries (SOCK_DGRAM).
+    ///
+    /// Reliable and ordered for `AF_UNIX` pairs on Linux and Darwin.
+    public static var datagram: Self { Self(SOCK_DGRAM) }
+}
+
+// MARK: - Options
+
 extension POSIX.Kernel.Socket.Pair {
-    /// Creates a connected pair of Unix domain stream sockets.
+    /// Descriptor flags applied to both ends of a new pair.
+    public struct Options: OptionSet, Sendable, Hashable {
+        public let rawValue: Int32
+
+        public init(rawValue: Int32) {
+            self.rawValue = rawValue
+        }
+
+        /// Close both descriptors on `exec` (SOCK_CLOEXEC).
+        public static let cloexec = Options(rawValue: Int32(SWIFT_SOCKET_CLOEXEC))
+
+        /// Non-blocking I/O on both descriptors (SOCK_NONBLOCK).
+        public static let nonblocking = Options(rawValue: Int32(SWIFT_SOCKET_NONBLOCK))
+    }
+}
+
+extension POSIX.Kernel.Socket.Pair {
+    /// Creates a connected pair of Unix domain sockets.
     ///
-    /// Both sockets are `AF_UNIX` / `SOCK_STREAM` and can be used for
-    /// bidirectional communication. Data written to one socket can be read
-    /// from the other, and vice versa.
+    /// Both sockets are `AF_UNIX` and can be used for bidirectional
+    /// communication. Data written to one socket can be read from the other,
+    /// and vice versa.
     ///
     /// ## Threading
     /// The socketpair syscall is atomic and does not block. The returned
-    /// descriptors are created in blocking mode by default.
+    /// descriptors are created in blocking mode unless `.nonblocking` is set.
+    ///
+    /// ## Options
+    /// On Linux, `.cloexec` and `.nonblocking` are applied atomically by
+    /// `socketpair` itself, so a concurrent `fork` + `exec` on another thread
+    /// cannot inherit the pair. Darwin has no SOCK_CLOEXEC; the flags are set
+    /// with `fcntl` immediately after creation.
     ///
     /// ## Blocking Behavior
     /// - **Read**: Blocks until data is available or the peer is closed (EOF)
@@ -87,20 +154,20 @@ extension POSIX.Kernel.Socket.Pair {
     /// ## Errors
     /// - ``Error/platform(_:)``: socketpair syscall failed
     ///
+    /// - Parameters:
+    ///   - kind: Socket type. Defaults to `.stream`.
+    ///   - options: Flags applied to both descriptors.
     /// - Returns: A tuple containing two connected socket descriptors.
     /// - Throws: ``Error`` on failure.
-    public static func create() throws(Error) -> (Kernel.Socket.Descriptor, Kernel.Socket.Descriptor) {
-        var fds: [Int32] = [0, 0]
-        #if canImport(Darwin)
-            let result = Darwin.socketpair(AF_UNIX, SOCK_STREAM, 0, &fds)
-        #elseif canImport(Glibc)
-            let result = Glibc.socketpair(AF_UNIX, Int32(SOCK_STREAM.rawValue), 0, &fds)
-        #elseif canImport(Musl)
-            let result = Musl.socketpair(AF_UNIX, SOCK_STREAM, 0, &fds)
-        #endif
-        guard result == 0 else {
+    public static func create(
+        _ kind: Kind = .stream,
+        options: Options = []
+    ) throws(Error) -> (Kernel.Socket.Descriptor, Kernel.Socket.Descriptor) {
+        var first: Int32 = -1
+        var second: Int32 = -1
+        guard swift_socketpair(kind.rawValue, options.rawValue, &first, &second) == 0 else {
             throw currentError()
         }
-        return (Kernel.Socket.Descriptor(rawValue: fds[0]), Kernel.Socket.Descriptor(rawValue: fds[1]))
+        return (Kernel.Socket.Descriptor(rawValue: first), Kernel.Socket.Descriptor(rawValue: second))
     }
 }
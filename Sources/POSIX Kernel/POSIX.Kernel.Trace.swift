@@ -0,0 +1,262 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+public import Kernel_Primitives
+public import POSIX_Primitives
+
+#if POSIX_KERNEL_TRACING
+    internal import Synchronization
+
+    #if canImport(Darwin)
+        internal import Darwin
+        internal import CPOSIXProcessShim
+    #elseif canImport(Glibc)
+        internal import Glibc
+        internal import CPOSIXProcessShim
+    #elseif canImport(Musl)
+        internal import Musl
+        internal import CPOSIXProcessShim
+    #endif
+#endif
+
+extension POSIX.Kernel {
+    /// Opt-in timestamps for the process lifecycle hot paths.
+    ///
+    /// Built only with the package's `Tracing` trait, which defines
+    /// `POSIX_KERNEL_TRACING`:
+    ///
+    /// ```
+    /// swift build --traits Tracing
+    /// ```
+    ///
+    /// Without it every hook compiles to nothing, `isEnabled` is `false`
+    /// and `drain(into:)` returns 0.
+    ///
+    /// | Point | Recorded by | `start`...`end` | `pid` | `detail` |
+    /// |-------|-------------|-----------------|-------|----------|
+    /// | `.spawn` | `Spawn.spawn` (all engines), `Handle.spawn` | submit...return | child | 0 |
+    /// | `.child` | SIGCHLD decoded by `Signal.Stream` | instant | sender | SIGCHLD |
+    /// | `.reap` | `Wait.wait`, `Wait.drain`, `Wait.Usage.wait`, `Ring` | instant | child | raw status |
+    /// | `.send` | `Signal.Send.toProcess`, `toAll` | call | target (0 for `toAll`) | signal |
+    /// | `.open` | `Library.Dynamic.open` | `dlopen` | 0 | 0 |
+    /// | `.symbol` | `Library.Dynamic.symbol` | `dlsym` | 0 | 0 |
+    ///
+    /// Timestamps are monotonic nanoseconds (CLOCK_MONOTONIC on Linux,
+    /// CLOCK_UPTIME_RAW on Darwin), comparable across threads.
+    ///
+    /// ## Buffers
+    ///
+    /// Each thread records into its own ring of `capacity` events, with no
+    /// lock and no allocation after its first event. A full ring drops new
+    /// events and counts them in `dropped`. Rings of exited threads are kept
+    /// so their events can still be drained.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let events = UnsafeMutableBufferPointer<POSIX.Kernel.Trace.Event>.allocate(capacity: 4096)
+    /// let count = POSIX.Kernel.Trace.drain(into: events)
+    /// for event in events[..<count] where event.point == .spawn {
+    ///     metrics.record("spawn", nanoseconds: event.duration)
+    /// }
+    /// ```
+    public enum Trace {}
+}
+
+// MARK: - Point, Event
+
+extension POSIX.Kernel.Trace {
+    /// Where an event was recorded.
+    public enum Point: UInt8, Sendable, Hashable {
+        case spawn
+        case child
+        case reap
+        case send
+        case open
+        case symbol
+    }
+
+    /// One recorded event.
+    public struct Event: Sendable, Equatable {
+        /// Where it was recorded.
+        public let point: Point
+
+        /// Monotonic nanoseconds when the operation started.
+        public let start: UInt64
+
+        /// Monotonic nanoseconds when it finished; `start` for instants.
+        public let end: UInt64
+
+        /// The process involved, or 0.
+        public let pid: Int32
+
+        /// Point-specific detail (see the table on `Trace`).
+        public let detail: Int32
+
+        public init(point: Point, start: UInt64, end: UInt64, pid: Int32, detail: Int32) {
+            self.point = point
+            self.start = start
+            self.end = end
+            self.pid = pid
+            self.detail = detail
+        }
+
+        /// `end - start` in nanoseconds.
+        public var duration: UInt64 {
+            end - start
+        }
+    }
+}
+
+// MARK: - Hooks
+
+extension POSIX.Kernel.Trace {
+    /// The start timestamp for `finish`; 0 without tracing.
+    @inlinable @inline(__always)
+    internal static func start() -> UInt64 {
+        #if POSIX_KERNEL_TRACING
+            return now()
+        #else
+            return 0
+        #endif
+    }
+
+    /// Records an operation that began at `start`.
+    @inlinable @inline(__always)
+    internal static func finish(_ point: Point, since start: UInt64, pid: Int32 = 0, detail: Int32 = 0) {
+        #if POSIX_KERNEL_TRACING
+            record(Event(point: point, start: start, end: now(), pid: pid, detail: detail))
+        #endif
+    }
+
+    /// Records an instant.
+    @inlinable @inline(__always)
+    internal static func mark(_ point: Point, pid: Int32 = 0, detail: Int32 = 0) {
+        #if POSIX_KERNEL_TRACING
+            let time = now()
+            record(Event(point: point, start: time, end: time, pid: pid, detail: detail))
+        #endif
+    }
+}
+
+// MARK: - Pull
+
+extension POSIX.Kernel.Trace {
+    /// Whether the library was built with the `Tracing` trait.
+    public static var isEnabled: Bool {
+        #if POSIX_KERNEL_TRACING
+            return true
+        #else
+            return false
+        #endif
+    }
+
+    /// Events each thread's ring holds before dropping.
+    public static let capacity = 4096
+
+    /// Moves recorded events out of every thread's ring.
+    ///
+    /// Events of one thread keep their order; sort by `start` to merge
+    /// threads. Concurrent drains are serialized; recording never waits.
+    ///
+    /// - Parameter buffer: Receives events, written from index 0.
+    /// - Returns: Events written; `buffer.count` means more may be pending.
+    public static func drain(into buffer: UnsafeMutableBufferPointer<Event>) -> Int {
+        #if POSIX_KERNEL_TRACING
+            guard let base = buffer.baseAddress else { return 0 }
+            return rings.withLock { rings in
+                var count = 0
+                for ring in rings where count < buffer.count {
+                    count += ring.drain(into: base + count, capacity: buffer.count - count)
+                }
+                return count
+            }
+        #else
+            return 0
+        #endif
+    }
+
+    /// Events dropped because a thread's ring was full.
+    public static var dropped: Int {
+        #if POSIX_KERNEL_TRACING
+            return rings.withLock { rings in
+                rings.reduce(0) { $0 + $1.dropped.load(ordering: .relaxed) }
+            }
+        #else
+            return 0
+        #endif
+    }
+}
+
+#if POSIX_KERNEL_TRACING
+
+    // MARK: - Ring
+
+    extension POSIX.Kernel.Trace {
+        /// A single-producer, single-consumer event ring owned by one thread.
+        ///
+        /// The owning thread advances `head`; a drain (under the registry
+        /// lock) advances `tail`.
+        fileprivate final class Ring: @unchecked Sendable {
+            let storage: UnsafeMutablePointer<Event>
+            let head = Atomic<Int>(0)
+            let tail = Atomic<Int>(0)
+            let dropped = Atomic<Int>(0)
+
+            init() {
+                storage = .allocate(capacity: POSIX.Kernel.Trace.capacity)
+            }
+
+            func append(_ event: Event) {
+                let head = self.head.load(ordering: .relaxed)
+                guard head - self.tail.load(ordering: .acquiring) < POSIX.Kernel.Trace.capacity else {
+                    dropped.wrappingAdd(1, ordering: .relaxed)
+                    return
+                }
+                (storage + (head & (POSIX.Kernel.Trace.capacity - 1))).initialize(to: event)
+                self.head.store(head + 1, ordering: .releasing)
+            }
+
+            func drain(into base: UnsafeMutablePointer<Event>, capacity: Int) -> Int {
+                let tail = self.tail.load(ordering: .relaxed)
+                let count = min(self.head.load(ordering: .acquiring) - tail, capacity)
+                for index in 0..<count {
+                    (base + index).initialize(to: storage[(tail + index) & (POSIX.Kernel.Trace.capacity - 1)])
+                }
+                self.tail.store(tail + count, ordering: .releasing)
+                return count
+            }
+        }
+
+        /// Every thread's ring; retains them, so the thread-local slot need not.
+        private static let rings = Mutex<[Ring]>([])
+
+        @usableFromInline
+        internal static func now() -> UInt64 {
+            swift_trace_now()
+        }
+
+        @usableFromInline
+        internal static func record(_ event: Event) {
+            let slot = swift_trace_slot()!
+            if let raw = slot.pointee {
+                Unmanaged<Ring>.fromOpaque(raw).takeUnretainedValue().append(event)
+                return
+            }
+
+            let ring = Ring()
+            rings.withLock { $0.append(ring) }
+            slot.pointee = Unmanaged.passUnretained(ring).toOpaque()
+            ring.append(event)
+        }
+    }
+
+#endif
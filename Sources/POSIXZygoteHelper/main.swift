@@ -0,0 +1,153 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+/// POSIX Zygote Helper - drives Process.Zygote from a fresh process
+///
+/// `Zygote.start` must run before any thread exists, which a test runner
+/// cannot provide. Tests spawn this executable instead: it starts the
+/// zygote first thing in main, while still single-threaded, and reports
+/// through its exit status.
+///
+/// ## Output Protocol
+///
+/// One KV line on stdout, as posix-test-helper:
+/// ```
+/// OK pid=123 zygote=124 worker=125 reply=48
+/// ERR step=exchange errno=32
+/// ```
+///
+/// ## Commands
+///
+/// - `worker` - Fork one worker, exchange a byte, wait for its exit, close
+/// - `pool` - Warm a pool of two, acquire and exchange, replenish, close
+///
+/// ## Exit Codes
+///
+/// 0 on success; otherwise the number of the failed step (see `Step`).
+
+#if canImport(Darwin)
+    import Darwin
+#elseif canImport(Glibc)
+    import Glibc
+#elseif canImport(Musl)
+    import Musl
+#endif
+
+import Kernel_Primitives
+import POSIX_Kernel
+
+/// Failure points, numbered by exit status.
+enum Step: Int32 {
+    case usage = 1
+    case start
+    case fork
+    case exchange
+    case exit
+    case reap
+    case pool
+}
+
+/// Added by every worker to the byte it receives. Set in `prepare`, so a
+/// correct reply proves the worker inherited the zygote's state.
+nonisolated(unsafe) var prepared: UInt8 = 0
+
+func fail(_ step: Step, _ code: Int32 = errno) -> Never {
+    print("ERR step=\(step) errno=\(code)")
+    exit(step.rawValue)
+}
+
+/// Worker entry: answer one byte, then exit.
+func serve(_ channel: Kernel.Socket.Descriptor) -> Int32 {
+    var byte: UInt8 = 0
+    guard read(channel.rawValue, &byte, 1) == 1 else { return 1 }
+    byte &+= prepared
+    return write(channel.rawValue, &byte, 1) == 1 ? 0 : 1
+}
+
+/// Sends 41 to `worker` and returns the reply.
+func exchange(_ worker: POSIX.Kernel.Process.Zygote.Worker) -> UInt8 {
+    var byte: UInt8 = 41
+    guard write(worker.channel.rawValue, &byte, 1) == 1 else { fail(.exchange) }
+    guard read(worker.channel.rawValue, &byte, 1) == 1 else { fail(.exchange) }
+    guard byte == 41 &+ 7 else { fail(.exchange, 0) }
+    return byte
+}
+
+/// Waits for `worker` to exit and be reaped by the zygote.
+///
+/// EOF on the channel means the worker has exited; the zygote ignores
+/// SIGCHLD, so the kernel reaps it shortly after.
+func reaped(_ worker: POSIX.Kernel.Process.Zygote.Worker) {
+    var byte: UInt8 = 0
+    guard read(worker.channel.rawValue, &byte, 1) == 0 else { fail(.exit) }
+    try? POSIX.Kernel.Process.Zygote.Worker.close(worker)
+
+    for _ in 0..<1_000 {
+        if kill(worker.pid.rawValue, 0) == -1 && errno == ESRCH { return }
+        usleep(1_000)
+    }
+    fail(.reap, 0)
+}
+
+/// Closes `zygote` and checks that `close` reaped it.
+func shut(_ zygote: POSIX.Kernel.Process.Zygote) {
+    zygote.close()
+    guard kill(zygote.pid.rawValue, 0) == -1 && errno == ESRCH else { fail(.reap, 0) }
+}
+
+guard CommandLine.arguments.count >= 2 else {
+    fputs("Usage: posix-zygote-helper worker|pool\n", stderr)
+    exit(Step.usage.rawValue)
+}
+
+let zygote: POSIX.Kernel.Process.Zygote
+do {
+    zygote = try POSIX.Kernel.Process.Zygote.start(prepare: { prepared = 7 }, entry: serve)
+} catch {
+    fail(.start, error.code.posix ?? 0)
+}
+
+switch CommandLine.arguments[1] {
+case "worker":
+    let worker: POSIX.Kernel.Process.Zygote.Worker
+    do {
+        worker = try zygote.fork()
+    } catch {
+        fail(.fork, error.code.posix ?? 0)
+    }
+    guard getpgid(worker.pid.rawValue) == zygote.group.rawValue else { fail(.fork, 0) }
+
+    let reply = exchange(worker)
+    reaped(worker)
+    shut(zygote)
+    print("OK pid=\(getpid()) zygote=\(zygote.pid.rawValue) worker=\(worker.pid.rawValue) reply=\(reply)")
+
+case "pool":
+    do {
+        let pool = try POSIX.Kernel.Process.Zygote.Pool(zygote, capacity: 2)
+        guard pool.available == 2 else { fail(.pool, 0) }
+
+        let worker = try pool.acquire()
+        guard pool.available == 1 else { fail(.pool, 0) }
+        let reply = exchange(worker)
+        reaped(worker)
+
+        guard try pool.replenish() == 1, pool.available == 2 else { fail(.pool, 0) }
+        print("OK pid=\(getpid()) zygote=\(zygote.pid.rawValue) worker=\(worker.pid.rawValue) reply=\(reply)")
+    } catch {
+        fail(.pool, error.code.posix ?? 0)
+    }
+    // The pool's idle workers see EOF when it is released above
+    shut(zygote)
+
+default:
+    fail(.usage, 0)
+}
@@ -80,4 +80,67 @@
         }
     }
 
+    // MARK: - Pair Tests
+
+    extension POSIX.Kernel.Device.Test.Unit {
+        @Test("Batch decode agrees with major/minor across SIMD lanes and tail")
+        func batchDecodeMatchesScalar() {
+            // 19 values: two full 8-lane blocks and a 3-element tail
+            var raw: [UInt64] = (0..<19).map { UInt64($0) &* 0x9E37_79B9_7F4A_7C15 }
+            raw[0] = POSIX.Kernel.Device(major: 8, minor: 1).rawValue
+            raw[1] = POSIX.Kernel.Device(major: 0xFFF, minor: 0xFFFFF).rawValue
+
+            let pairs = POSIX.Kernel.Device.decode(raw)
+            #expect(pairs.count == raw.count)
+            for (value, pair) in zip(raw, pairs) {
+                let device = POSIX.Kernel.Device(rawValue: value)
+                #expect(pair.major == device.major)
+                #expect(pair.minor == device.minor)
+            }
+            #expect(pairs[0] == POSIX.Kernel.Device.Pair(major: 8, minor: 1))
+        }
+
+        @Test("Batch decode writes min(devices, pairs)")
+        func batchDecodeBounded() {
+            let raw: [UInt64] = Array(repeating: POSIX.Kernel.Device(major: 1, minor: 2).rawValue, count: 10)
+            let pairs = UnsafeMutableBufferPointer<POSIX.Kernel.Device.Pair>.allocate(capacity: 4)
+            defer { pairs.deallocate() }
+
+            let written = raw.withUnsafeBufferPointer { POSIX.Kernel.Device.decode($0, into: pairs) }
+            #expect(written == 4)
+            #expect(pairs.allSatisfy { $0 == POSIX.Kernel.Device.Pair(major: 1, minor: 2) })
+        }
+
+        @Test("Pair hashes and compares on the packed word")
+        func pairHashable() {
+            let pair = POSIX.Kernel.Device(major: 253, minor: 42).pair
+            #expect(pair.packed == 253 | 42 << 32)
+            #expect(pair.device == POSIX.Kernel.Device(major: 253, minor: 42))
+            #expect(pair.typedMajor.rawValue == 253)
+
+            var counts: [POSIX.Kernel.Device.Pair: Int] = [:]
+            for _ in 0..<3 { counts[pair, default: 0] += 1 }
+            counts[POSIX.Kernel.Device.Pair(major: 42, minor: 253), default: 0] += 1
+            #expect(counts[pair] == 3)
+            #expect(counts.count == 2)
+        }
+    }
+
+    // MARK: - Formatting Tests
+
+    extension POSIX.Kernel.Device.Test.Unit {
+        @Test("format(into:) writes major:minor without a terminator")
+        func formatIntoBuffer() {
+            let buffer = UnsafeMutableBufferPointer<UInt8>.allocate(capacity: POSIX.Kernel.Device.formattedCapacity)
+            defer { buffer.deallocate() }
+
+            let count = POSIX.Kernel.Device(major: 259, minor: 0).format(into: buffer)
+            #expect(String(decoding: buffer[..<count], as: UTF8.self) == "259:0")
+
+            let widest = POSIX.Kernel.Device(major: 0xFFF, minor: 0xFFFFF)
+            let written = widest.format(into: buffer)
+            #expect(String(decoding: buffer[..<written], as: UTF8.self) == "4095:1048575")
+        }
+    }
+
 #endif
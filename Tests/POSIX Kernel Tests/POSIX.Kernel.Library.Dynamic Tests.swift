@@ -44,6 +44,25 @@ extension POSIX.Kernel.Library.Dynamic.Test.Unit {
     func messageTypeExists() {
         _ = POSIX.Kernel.Library.Dynamic.Message.self
     }
+
+    @Test("Code-only message formats its text on read")
+    func codeOnlyMessage() {
+        let message = POSIX.Kernel.Library.Dynamic.Message(code: .posix(2))
+        #expect(message.code == .posix(2))
+        #expect(!message.text.isEmpty)
+        #expect(message == POSIX.Kernel.Library.Dynamic.Message(code: .posix(2)))
+        #expect(message != POSIX.Kernel.Library.Dynamic.Message(code: .posix(3)))
+    }
+
+    @Test("Missing-symbol messages compare and hash by name")
+    func missingMessageEquality() {
+        let message = POSIX.Kernel.Library.Dynamic.Message(missing: "swift_posix_absent")
+        let same = POSIX.Kernel.Library.Dynamic.Message(missing: "swift_posix_absent")
+        #expect(message == same)
+        #expect(message.hashValue == same.hashValue)
+        #expect(message != POSIX.Kernel.Library.Dynamic.Message(missing: "swift_posix_other"))
+        #expect(message != POSIX.Kernel.Library.Dynamic.Message(message.text))
+    }
 }
 
 // MARK: - POSIX Tests
@@ -105,8 +124,91 @@ extension POSIX.Kernel.Library.Dynamic.Test.Unit {
             }
         }
 
+        @Test("Static symbol lookup throws a lazy message naming the symbol")
+        func staticSymbolNotFound() {
+            do {
+                _ = try POSIX.Kernel.Library.Dynamic.symbol("____nonexistent_symbol_xyz____", in: .default)
+                Issue.record("Expected symbol to throw")
+            } catch {
+                guard case .symbol(let msg) = error else {
+                    Issue.record("Expected .symbol error case")
+                    return
+                }
+                #expect(msg.text.contains("____nonexistent_symbol_xyz____"))
+            }
+        }
+
+        @Test("Batched lookup reports resolved count and first miss")
+        func batchedLookup() {
+            let names: [StaticString] = ["malloc", "____nonexistent_symbol_xyz____", "free"]
+            let table = UnsafeMutableBufferPointer<UnsafeRawPointer?>.allocate(capacity: names.count)
+            defer { table.deallocate() }
+
+            let resolution = POSIX.Kernel.Library.Dynamic.symbols(names, in: .default, into: table)
+            #expect(resolution.resolved == 2)
+            #expect(resolution.missing == 1)
+            #expect(table[0] != nil)
+            #expect(table[1] == nil)
+            #expect(table[2] != nil)
+            #expect(resolution.error != nil)
+        }
+
+        @Test("Cache stores hits and skips misses")
+        func cacheStoresHits() throws {
+            let cache = POSIX.Kernel.Library.Dynamic.Cache(.default)
+            let first = try cache.symbol("malloc")
+            let second = try cache.symbol("malloc")
+            #expect(first == second)
+            #expect(cache.count == 1)
+
+            let names: [StaticString] = ["malloc", "free", "____nonexistent_symbol_xyz____"]
+            let table = UnsafeMutableBufferPointer<UnsafeRawPointer?>.allocate(capacity: names.count)
+            defer { table.deallocate() }
+
+            let resolution = cache.symbols(names, into: table)
+            #expect(resolution.resolved == 2)
+            #expect(resolution.missing == 2)
+            #expect(cache.count == 2)
+
+            cache.clear()
+            #expect(cache.count == 0)
+        }
+
+        @Test("Resident probe does not load a missing library")
+        func residentProbeMisses() {
+            let handle = "libswift_posix_not_a_library.so".withCString { path in
+                POSIX.Kernel.Library.Dynamic.resident(path: path)
+            }
+            #expect(handle == nil)
+        }
     }
 
+    #if canImport(Glibc)
+
+        extension POSIX.Kernel.Library.Dynamic.Test.Unit {
+            @Test("Resident probe finds libc in the base namespace")
+            func residentProbeFindsLibc() throws {
+                let handle = try #require(
+                    "libc.so.6".withCString { POSIX.Kernel.Library.Dynamic.resident(path: $0) }
+                )
+                defer { try? POSIX.Kernel.Library.Dynamic.close(handle) }
+                #expect(try handle.namespace == .base)
+            }
+
+            @Test("dlmopen loads into a new namespace")
+            func openIntoNewNamespace() throws {
+                let handle = try "libm.so.6".withCString { path in
+                    try POSIX.Kernel.Library.Dynamic.open(path: path, namespace: nil)
+                }
+                defer { try? POSIX.Kernel.Library.Dynamic.close(handle) }
+
+                #expect(try handle.namespace != .base)
+                _ = try POSIX.Kernel.Library.Dynamic.symbol("cos", in: .handle(handle))
+            }
+        }
+
+    #endif
+
 #endif
 
 // MARK: - Windows Tests
@@ -0,0 +1,149 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Memory.Lock.Range {
+        #TestSuites
+    }
+
+    extension Kernel.Memory.Lock.Range.Test {
+        @Suite struct Integration {}
+    }
+
+    /// Runs `body` over a fresh private anonymous mapping of `pages` pages.
+    private func withMapping(pages: Int, _ body: (UnsafeMutableRawBufferPointer) throws -> Void) throws {
+        let length = pages * Int(getpagesize())
+        let base = try #require(
+            mmap(nil, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0)
+        )
+        try #require(base != UnsafeMutableRawPointer(bitPattern: -1))
+        defer { munmap(base, length) }
+        try body(UnsafeMutableRawBufferPointer(start: base, count: length))
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Memory.Lock.Range.Test.Unit {
+        @Test("error description names the operation")
+        func errorDescription() {
+            let error = Kernel.Memory.Lock.Range.Error.lock(.posix(ENOMEM))
+            #expect(error.description.contains("lock"))
+            #expect(error.code == .posix(ENOMEM))
+        }
+
+        @Test("empty ranges are a no-op")
+        func emptyRange() throws {
+            let empty = UnsafeRawBufferPointer(start: nil, count: 0)
+            try Kernel.Memory.Lock.Range.lock(empty)
+            try Kernel.Memory.Lock.Range.unlock(empty)
+            try Kernel.Memory.Advice.apply(.willNeed, to: empty)
+        }
+
+        @Test("advice values are distinct")
+        func adviceValues() {
+            #expect(Kernel.Memory.Advice.willNeed != .dontNeed)
+            #expect(Kernel.Memory.Advice.normal != .sequential)
+        }
+    }
+
+    // MARK: - Integration Tests
+
+    extension Kernel.Memory.Lock.Range.Test.Integration {
+        @Test("lock and unlock an unaligned range")
+        func lockUnlock() throws {
+            try withMapping(pages: 2) { mapping in
+                // Starts mid-page and crosses into the second page
+                let range = UnsafeRawBufferPointer(rebasing: mapping[100..<(mapping.count - 100)])
+                do {
+                    try Kernel.Memory.Lock.Range.lock(range)
+                } catch {
+                    // RLIMIT_MEMLOCK may be too small in a sandbox
+                    #expect(error.code == .posix(ENOMEM) || error.code == .posix(EPERM))
+                    return
+                }
+                try Kernel.Memory.Lock.Range.unlock(range)
+            }
+        }
+
+        @Test("willNeed and dontNeed apply to an anonymous mapping")
+        func adviseMapping() throws {
+            try withMapping(pages: 4) { mapping in
+                mapping.storeBytes(of: 0x5A, toByteOffset: 0, as: UInt8.self)
+                let range = UnsafeRawBufferPointer(mapping)
+                try Kernel.Memory.Advice.apply(.willNeed, to: range)
+                try Kernel.Memory.Advice.apply(.dontNeed, to: range)
+            }
+        }
+
+        #if os(Linux)
+            @Test("dontNeed zeroes private anonymous pages on Linux")
+            func dontNeedZeroes() throws {
+                try withMapping(pages: 1) { mapping in
+                    mapping.storeBytes(of: 0x5A, toByteOffset: 0, as: UInt8.self)
+                    try Kernel.Memory.Advice.apply(.dontNeed, to: UnsafeRawBufferPointer(mapping))
+                    #expect(mapping.load(fromByteOffset: 0, as: UInt8.self) == 0)
+                }
+            }
+
+            @Test("dontNeed on an unaligned range spares the partial pages at its ends")
+            func dontNeedShrinksInward() throws {
+                let page = Int(getpagesize())
+                try withMapping(pages: 3) { mapping in
+                    for offset in [page / 2, page, 2 * page + page / 2 - 1] {
+                        mapping.storeBytes(of: 0x5A, toByteOffset: offset, as: UInt8.self)
+                    }
+                    let range = UnsafeRawBufferPointer(rebasing: mapping[(page / 2)..<(2 * page + page / 2)])
+                    try Kernel.Memory.Advice.apply(.dontNeed, to: range)
+
+                    #expect(mapping.load(fromByteOffset: page / 2, as: UInt8.self) == 0x5A)
+                    #expect(mapping.load(fromByteOffset: page, as: UInt8.self) == 0)
+                    #expect(mapping.load(fromByteOffset: 2 * page + page / 2 - 1, as: UInt8.self) == 0x5A)
+                }
+            }
+
+            @Test("populateRead prefaults or reports an old kernel")
+            func populateRead() throws {
+                try withMapping(pages: 4) { mapping in
+                    do {
+                        try Kernel.Memory.Advice.apply(.populateRead, to: UnsafeRawBufferPointer(mapping))
+                    } catch {
+                        #expect(error.code == .posix(EINVAL))
+                    }
+                }
+            }
+
+            @Test("fork inheritance advice applies and reverts on an anonymous mapping")
+            func forkInheritance() throws {
+                try withMapping(pages: 2) { mapping in
+                    let range = UnsafeRawBufferPointer(mapping)
+                    try Kernel.Memory.Advice.apply(.dontFork, to: range)
+                    try Kernel.Memory.Advice.apply(.doFork, to: range)
+                    try Kernel.Memory.Advice.apply(.wipeOnFork, to: range)
+                    try Kernel.Memory.Advice.apply(.keepOnFork, to: range)
+                }
+            }
+        #endif
+    }
+
+#endif
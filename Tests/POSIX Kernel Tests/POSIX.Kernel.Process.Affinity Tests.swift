@@ -0,0 +1,114 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(Linux)
+
+    import Glibc
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Affinity {
+        #TestSuites
+    }
+
+    extension Kernel.Process.Affinity.Test {
+        @Suite struct Integration {}
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Process.Affinity.Test.Unit {
+        @Test("insert, contains and remove")
+        func membership() {
+            var affinity = Kernel.Process.Affinity([0, 63, 64, 1023])
+            #expect(affinity.count == 4)
+            #expect(affinity.contains(63))
+            #expect(affinity.contains(64))
+            #expect(!affinity.contains(1))
+            #expect(!affinity.contains(Kernel.Process.Affinity.capacity))
+
+            affinity.remove(63)
+            #expect(affinity.cpus == [0, 64, 1023])
+        }
+
+        @Test("empty set")
+        func empty() {
+            #expect(Kernel.Process.Affinity().isEmpty)
+            #expect(Kernel.Process.Affinity().cpus.isEmpty)
+        }
+
+        @Test("batch and idle policies take priority 0")
+        func policyPriorities() {
+            #expect(Kernel.Process.Scheduler.Policy.batch.priorities == 0...0)
+            #expect(Kernel.Process.Scheduler.Policy.idle.priorities == 0...0)
+            #expect(Kernel.Process.Scheduler.Policy.fifo.priorities.lowerBound >= 1)
+        }
+    }
+
+    // MARK: - Integration Tests
+
+    extension Kernel.Process.Affinity.Test.Integration {
+        @Test("the calling thread may run on at least one CPU")
+        func currentIsNonEmpty() throws {
+            #expect(try !Kernel.Process.Affinity.get().isEmpty)
+        }
+
+        @Test("setting the current mask again succeeds")
+        func setCurrent() throws {
+            let current = try Kernel.Process.Affinity.get()
+            try Kernel.Process.Affinity.set(current)
+            #expect(try Kernel.Process.Affinity.get() == current)
+        }
+
+        @Test("an empty mask fails with EINVAL")
+        func setEmptyFails() {
+            #expect(throws: Kernel.Process.Error.schedule(.posix(EINVAL))) {
+                try Kernel.Process.Affinity.set(Kernel.Process.Affinity())
+            }
+        }
+
+        @Test("spawn with an affinity attribute pins the child before exec")
+        func spawnPinned() throws {
+            let first = try #require(try Kernel.Process.Affinity.get().cpus.first)
+
+            let attributes = try Kernel.Process.Spawn.Attributes()
+            attributes.affinity(Kernel.Process.Affinity([first]))
+
+            let arguments = Kernel.Process.Spawn.Arguments([POSIXTestHelper.executablePath(), "stop-exit", "0"])
+            let child = try Kernel.Process.Spawn.spawn(arguments, attributes: attributes)
+            _ = try Kernel.Process.Wait.wait(.process(child), options: [.untraced])
+
+            #expect(try Kernel.Process.Affinity.get(child).cpus == [first])
+
+            try POSIX.Kernel.Signal.Send.toProcess(.continue, pid: child)
+            _ = try Kernel.Process.Wait.wait(.process(child))
+        }
+
+        @Test("spawn with SCHED_BATCH through posix_spawn")
+        func spawnBatch() throws {
+            let attributes = try Kernel.Process.Spawn.Attributes()
+            try attributes.scheduler(.batch)
+
+            let arguments = Kernel.Process.Spawn.Arguments([POSIXTestHelper.executablePath(), "stop-exit", "0"])
+            let child = try Kernel.Process.Spawn.spawn(arguments, attributes: attributes)
+            _ = try Kernel.Process.Wait.wait(.process(child), options: [.untraced])
+
+            #expect(sched_getscheduler(child.rawValue) == Kernel.Process.Scheduler.Policy.batch.rawValue)
+
+            try POSIX.Kernel.Signal.Send.toProcess(.continue, pid: child)
+            _ = try Kernel.Process.Wait.wait(.process(child))
+        }
+    }
+
+#endif
@@ -62,6 +62,13 @@
                 .wait(code),
                 .session(code),
                 .group(code),
+                .handle(code),
+                .zygote(code),
+                .pipe(code),
+                .schedule(code),
+                .ring(code),
+                .tree(code),
+                .supervisor(code),
             ]
 
             for error in errors {
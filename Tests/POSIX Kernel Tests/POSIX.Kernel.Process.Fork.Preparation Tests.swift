@@ -0,0 +1,163 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Fork.Preparation {
+        #TestSuites
+    }
+
+    // MARK: - Unit Tests
+    //
+    // NOTE: No unit test forks. A successful `fork(preparing:)` leaves a
+    // child running Swift in a multithreaded test runner; only the failure
+    // paths, which return before forking, are exercised here.
+
+    extension Kernel.Process.Fork.Preparation.Test.Unit {
+        @Test("regions are counted in registration order")
+        func regionCount() {
+            let bytes = UnsafeMutableRawBufferPointer.allocate(byteCount: 64, alignment: 8)
+            defer { bytes.deallocate() }
+
+            let preparation = Kernel.Process.Fork.Preparation()
+            #expect(preparation.count == 0)
+            #expect(preparation.child.count == 0)
+
+            preparation.exclude(UnsafeRawBufferPointer(bytes))
+            #if os(Linux)
+                preparation.wipe(UnsafeRawBufferPointer(bytes))
+                preparation.collapse(UnsafeRawBufferPointer(bytes))
+                #expect(preparation.count == 3)
+            #else
+                #expect(preparation.count == 1)
+            #endif
+        }
+
+        @Test("child steps are the list passed in")
+        func childSteps() {
+            let steps = Kernel.Process.Spawn.Steps()
+            steps.session()
+            let preparation = Kernel.Process.Fork.Preparation(child: steps)
+            #expect(preparation.child === steps)
+            #expect(preparation.child.count == 1)
+        }
+
+        @Test("an unaligned region throws EINVAL without forking")
+        func unalignedRegion() throws {
+            let length = Int(getpagesize())
+            let base = try #require(mmap(nil, 2 * length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0))
+            try #require(base != UnsafeMutableRawPointer(bitPattern: -1))
+            defer { munmap(base, 2 * length) }
+
+            let preparation = Kernel.Process.Fork.Preparation()
+            preparation.exclude(UnsafeRawBufferPointer(start: base + 1, count: length))
+
+            #expect(throws: Kernel.Process.Error.fork(.posix(EINVAL))) {
+                _ = try Kernel.Process.Fork.fork(preparing: preparation)
+            }
+        }
+
+        #if os(Linux)
+            @Test("an unmapped region throws ENOMEM without forking")
+            func unmappedRegion() throws {
+                let length = Int(getpagesize())
+                let base = try #require(mmap(nil, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0))
+                try #require(base != UnsafeMutableRawPointer(bitPattern: -1))
+                munmap(base, length)
+
+                let preparation = Kernel.Process.Fork.Preparation()
+                preparation.exclude(UnsafeRawBufferPointer(start: base, count: length))
+
+                #expect(throws: Kernel.Process.Error.fork(.posix(ENOMEM))) {
+                    _ = try Kernel.Process.Fork.fork(preparing: preparation)
+                }
+            }
+
+            @Test("wipe on a shared mapping throws EINVAL without forking")
+            func wipeShared() throws {
+                let length = Int(getpagesize())
+                let base = try #require(mmap(nil, length, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANON, -1, 0))
+                try #require(base != UnsafeMutableRawPointer(bitPattern: -1))
+                defer { munmap(base, length) }
+
+                let preparation = Kernel.Process.Fork.Preparation()
+                preparation.wipe(UnsafeRawBufferPointer(start: base, count: length))
+
+                #expect(throws: Kernel.Process.Error.fork(.posix(EINVAL))) {
+                    _ = try Kernel.Process.Fork.fork(preparing: preparation)
+                }
+            }
+        #endif
+    }
+
+    // MARK: - Integration Tests
+    //
+    // macOS only, as the Fork tests. The child makes raw syscalls and
+    // reports through its exit status; bits name the check that failed.
+
+    #if os(macOS)
+
+        extension Kernel.Process.Fork.Preparation.Test {
+            @Suite struct Integration {}
+        }
+
+        extension Kernel.Process.Fork.Preparation.Test.Integration {
+            @Test("the child loses excluded pages and unkept descriptors")
+            func childState() throws {
+                let length = Int(getpagesize())
+                let base = try #require(mmap(nil, 2 * length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0))
+                try #require(base != UnsafeMutableRawPointer(bitPattern: -1))
+                defer { munmap(base, 2 * length) }
+                memset(base, 1, 2 * length)
+                let kept = base + length
+
+                let pipe = try Kernel.Process.Pipe.create()
+                defer {
+                    Kernel.Process.Pipe.close(pipe.read)
+                    Kernel.Process.Pipe.close(pipe.write)
+                }
+
+                let preparation = Kernel.Process.Fork.Preparation()
+                preparation.exclude(UnsafeRawBufferPointer(start: base, count: length))
+                preparation.child.close(except: [pipe.write])
+
+                switch try Kernel.Process.Fork.fork(preparing: preparation) {
+                case .child:
+                    var failed: Int32 = 0
+                    if madvise(base, length, MADV_NORMAL) != -1 { failed |= 1 }
+                    if kept.load(as: UInt8.self) != 1 { failed |= 2 }
+                    if fcntl(pipe.read.rawValue, F_GETFD) != -1 { failed |= 4 }
+                    if fcntl(pipe.write.rawValue, F_GETFD) == -1 { failed |= 8 }
+                    Kernel.Process.Exit.now(failed)
+                case .parent(let child):
+                    #expect(try Kernel.Process.Wait.wait(.process(child))?.status.exit.code == 0)
+                }
+
+                // The advice stays on the parent's mapping, not its contents
+                #expect(base.load(as: UInt8.self) == 1)
+            }
+        }
+
+    #endif
+
+#endif
@@ -0,0 +1,172 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Handle {
+        #TestSuites
+    }
+
+    extension Kernel.Process.Handle.Test {
+        @Suite struct Integration {}
+    }
+
+    // MARK: - Integration Tests
+    //
+    // NOTE: These tests use posix_spawn via POSIXTestHelper instead of fork() directly
+    // to avoid Swift runtime lock corruption in multithreaded test environments.
+
+    extension Kernel.Process.Handle.Test.Integration {
+        @Test("wait(handle) reaps child and reports exit code")
+        func waitHandleReapsChild() throws {
+            let child = try POSIXTestHelper.spawn("exit", "42")
+            let handle = try Kernel.Process.Handle.open(child)
+            defer { try? Kernel.Process.Handle.close(handle) }
+
+            let result = try Kernel.Process.Wait.wait(handle)
+            #expect(result?.pid == child)
+            #expect(result?.status.exit.code == 42)
+        }
+
+        @Test("handle descriptor becomes readable when child exits")
+        func descriptorReadableOnExit() throws {
+            let child = try POSIXTestHelper.spawn("exit", "0")
+            let handle = try Kernel.Process.Handle.open(child)
+            defer { try? Kernel.Process.Handle.close(handle) }
+
+            var pfd = pollfd(fd: handle.descriptor.rawValue, events: Int16(POLLIN), revents: 0)
+            let ready = poll(&pfd, 1, 10_000)
+            #expect(ready == 1, "descriptor should become readable")
+
+            let result = try Kernel.Process.Wait.wait(handle, options: .no.hang)
+            #expect(result?.pid == child)
+        }
+
+        @Test("wait(handle) with no.hang returns nil for stopped child")
+        func waitHandleNoHangStopped() throws {
+            let child = try POSIXTestHelper.spawn("stop-exit", "7")
+            let handle = try Kernel.Process.Handle.open(child)
+            defer { try? Kernel.Process.Handle.close(handle) }
+
+            _ = try Kernel.Process.Wait.wait(.process(child), options: [.untraced])
+            let noHang = try Kernel.Process.Wait.wait(handle, options: .no.hang)
+            #expect(noHang == nil)
+
+            try POSIX.Kernel.Signal.Send.toProcess(.continue, pid: child)
+            let exited = try Kernel.Process.Wait.wait(handle)
+            #expect(exited?.status.exit.code == 7)
+        }
+    }
+
+    #if os(Linux)
+
+        extension Kernel.Process.Handle.Test.Integration {
+            /// Spawns the helper through `Handle.spawn` with `attributes`.
+            private func spawnHandle(
+                _ args: [String],
+                attributes: Kernel.Process.Spawn.Attributes
+            ) throws -> Kernel.Process.Handle {
+                let path = POSIXTestHelper.executablePath()
+                return try Kernel.Path.scope(path) { pathPtr in
+                    try Kernel.Path.scope.array([path] + args, []) { argvPtr, envpPtr in
+                        try Kernel.Process.Handle.spawn(
+                            path: pathPtr.unsafeCString,
+                            argv: argvPtr,
+                            envp: envpPtr,
+                            attributes: attributes
+                        )
+                    }
+                }
+            }
+
+            /// This process's cgroup v2 path, from the "0::" line of /proc/self/cgroup.
+            private func unifiedCgroupPath() -> String? {
+                let fd = open("/proc/self/cgroup", O_RDONLY | O_CLOEXEC)
+                guard fd >= 0 else { return nil }
+                defer { _ = Glibc.close(fd) }
+
+                var bytes: [UInt8] = []
+                var chunk = [UInt8](repeating: 0, count: 1024)
+                while true {
+                    let count = chunk.withUnsafeMutableBytes { read(fd, $0.baseAddress, $0.count) }
+                    guard count > 0 else { break }
+                    bytes.append(contentsOf: chunk[0..<count])
+                }
+
+                let text = String(decoding: bytes, as: UTF8.self)
+                for line in text.split(separator: "\n") where line.hasPrefix("0::") {
+                    return String(line.dropFirst(3))
+                }
+                return nil
+            }
+
+            @Test("spawn with stepped attributes returns a clone3 pidfd")
+            func spawnSteppedReturnsPidfd() throws {
+                let attributes = try Kernel.Process.Spawn.Attributes()
+                attributes.nice(19)
+
+                let handle = try spawnHandle(["exit", "5"], attributes: attributes)
+                defer { try? Kernel.Process.Handle.close(handle) }
+
+                let result = try Kernel.Process.Wait.wait(handle)
+                #expect(result?.pid == handle.pid)
+                #expect(result?.status.exit.code == 5)
+            }
+
+            @Test("spawn with cgroup places the child in that cgroup")
+            func spawnIntoCgroup() throws {
+                guard let cgroup = unifiedCgroupPath() else { return }
+
+                // Pure v2 hosts mount at /sys/fs/cgroup; hybrid hosts at .../unified
+                var fd = open("/sys/fs/cgroup" + cgroup, O_RDONLY | O_DIRECTORY | O_CLOEXEC)
+                if fd < 0 {
+                    fd = open("/sys/fs/cgroup/unified" + cgroup, O_RDONLY | O_DIRECTORY | O_CLOEXEC)
+                }
+                guard fd >= 0 else { return }
+                defer { _ = Glibc.close(fd) }
+
+                let attributes = try Kernel.Process.Spawn.Attributes()
+                attributes.cgroup(Kernel.Descriptor(rawValue: fd))
+
+                let handle: Kernel.Process.Handle
+                do {
+                    handle = try spawnHandle(["cgroup-is", cgroup], attributes: attributes)
+                } catch {
+                    // Old kernels, delegated subtrees and sandboxes refuse placement
+                    if case .spawn(.posix(let code)) = error,
+                        [ENOSYS, EBUSY, EPERM, EACCES, EOPNOTSUPP].contains(code)
+                    {
+                        return
+                    }
+                    throw error
+                }
+                defer { try? Kernel.Process.Handle.close(handle) }
+
+                let result = try Kernel.Process.Wait.wait(handle)
+                #expect(result?.status.exit.code == 0)
+            }
+        }
+
+    #endif
+
+#endif
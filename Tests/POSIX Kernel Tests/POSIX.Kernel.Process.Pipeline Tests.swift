@@ -0,0 +1,160 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Pipeline {
+        #TestSuites
+    }
+
+    extension Kernel.Process.Pipeline.Test {
+        @Suite struct Integration {}
+    }
+
+    /// `/bin/sh -c script` as a pipeline stage.
+    private func shell(_ script: String) -> Kernel.Process.Spawn.Arguments {
+        Kernel.Process.Spawn.Arguments(["/bin/sh", "-c", script])
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Process.Pipeline.Test.Unit {
+        @Test("relay at either end of the pipeline is rejected")
+        func relayPlacement() {
+            let leading = Kernel.Process.Pipeline()
+            leading.relay()
+            leading.append(shell("exit 0"))
+            #expect(throws: Kernel.Process.Error.pipe(.posix(EINVAL))) {
+                _ = try leading.spawn()
+            }
+
+            let trailing = Kernel.Process.Pipeline()
+            trailing.append(shell("exit 0"))
+            trailing.relay()
+            #expect(throws: Kernel.Process.Error.pipe(.posix(EINVAL))) {
+                _ = try trailing.spawn()
+            }
+        }
+
+        @Test("empty pipeline is rejected")
+        func empty() {
+            #expect(throws: Kernel.Process.Error.pipe(.posix(EINVAL))) {
+                _ = try Kernel.Process.Pipeline().spawn()
+            }
+        }
+
+        @Test("Pipe.create sets close-on-exec by default")
+        func pipeCloexec() throws {
+            let pipe = try Kernel.Process.Pipe.create()
+            defer {
+                Kernel.Process.Pipe.close(pipe.read)
+                Kernel.Process.Pipe.close(pipe.write)
+            }
+            #expect(fcntl(pipe.read.rawValue, F_GETFD) & FD_CLOEXEC != 0)
+            #expect(fcntl(pipe.write.rawValue, F_GETFD) & FD_CLOEXEC != 0)
+        }
+
+        #if os(Linux)
+            @Test("Pipe.resize grows the pipe buffer")
+            func pipeResize() throws {
+                let pipe = try Kernel.Process.Pipe.create()
+                defer {
+                    Kernel.Process.Pipe.close(pipe.read)
+                    Kernel.Process.Pipe.close(pipe.write)
+                }
+                let size = try Kernel.Process.Pipe.resize(pipe.write, to: 256 * 1024)
+                #expect(size >= 256 * 1024)
+                #expect(try Kernel.Process.Pipe.capacity(of: pipe.read) == size)
+            }
+        #endif
+    }
+
+    // MARK: - Integration Tests
+
+    extension Kernel.Process.Pipeline.Test.Integration {
+        @Test("stages are connected stdout to stdin")
+        func connected() throws {
+            let pipeline = Kernel.Process.Pipeline()
+            pipeline.append(shell("echo hello"))
+            pipeline.append(shell("read line && test \"$line\" = hello"))
+
+            let running = try pipeline.spawn()
+            #expect(running.children.count == 2)
+            #expect(running.relays.isEmpty)
+            for child in running.children {
+                #expect(try Kernel.Process.Wait.wait(.process(child))?.status.exit.code == 0)
+            }
+        }
+
+        @Test("the last stage sees EOF once upstream exits")
+        func eof() throws {
+            let pipeline = Kernel.Process.Pipeline(capacity: 128 * 1024)
+            pipeline.append(shell("exit 0"))
+            pipeline.append(shell("cat > /dev/null"))
+
+            let running = try pipeline.spawn()
+            for child in running.children {
+                #expect(try Kernel.Process.Wait.wait(.process(child))?.status.exit.code == 0)
+            }
+        }
+
+        @Test("relay moves bytes between stages")
+        func relay() throws {
+            let pipeline = Kernel.Process.Pipeline()
+            pipeline.append(shell("echo hello"))
+            pipeline.relay()
+            pipeline.append(shell("read line && test \"$line\" = hello"))
+
+            let running = try pipeline.spawn()
+            #expect(running.relays.count == 1)
+            #expect(try running.relays[0].run() == 6)
+            for child in running.children {
+                #expect(try Kernel.Process.Wait.wait(.process(child))?.status.exit.code == 0)
+            }
+        }
+
+        @Test("relay copies the stream when asked")
+        func relayCopy() throws {
+            let copy = try Kernel.Process.Pipe.create()
+            defer { Kernel.Process.Pipe.close(copy.read) }
+
+            let pipeline = Kernel.Process.Pipeline()
+            pipeline.append(shell("echo hello"))
+            pipeline.relay()
+            pipeline.append(shell("cat > /dev/null"))
+
+            let running = try pipeline.spawn()
+            try running.relays[0].run(copy: copy.write)
+            Kernel.Process.Pipe.close(copy.write)
+
+            var buffer = [UInt8](repeating: 0, count: 16)
+            let count = read(copy.read.rawValue, &buffer, buffer.count)
+            #expect(Array(buffer.prefix(max(count, 0))) == Array("hello\n".utf8))
+
+            for child in running.children {
+                _ = try Kernel.Process.Wait.wait(.process(child))
+            }
+        }
+    }
+
+#endif
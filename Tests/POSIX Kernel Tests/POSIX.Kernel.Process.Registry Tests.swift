@@ -0,0 +1,112 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Registry {
+        #TestSuites
+    }
+
+    extension Kernel.Process.Registry.Test {
+        @Suite struct Integration {}
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Process.Registry.Test.Unit {
+        private func result(_ pid: Int32, exit code: Int32) -> Kernel.Process.Wait.Result {
+            Kernel.Process.Wait.Result(
+                pid: Kernel.Process.ID(rawValue: pid),
+                status: Kernel.Process.Status(rawValue: code << 8)
+            )
+        }
+
+        @Test("Shard count rounds up to a power of two")
+        func shardsRoundUp() {
+            #expect(Kernel.Process.Registry(shards: 1).shards == 1)
+            #expect(Kernel.Process.Registry(shards: 5).shards == 8)
+            #expect(Kernel.Process.Registry().shards == 64)
+        }
+
+        @Test("A result completed before wait is parked and collected")
+        func completeBeforeWait() async {
+            let registry = Kernel.Process.Registry(shards: 4)
+            #expect(registry.complete(result(101, exit: 3)) == false)
+            #expect(registry.count == 1)
+
+            let collected = await registry.wait(Kernel.Process.ID(rawValue: 101))
+            #expect(collected.status.exit.code == 3)
+            #expect(registry.count == 0)
+        }
+
+        @Test("A pending waiter is resumed by complete")
+        func waitBeforeComplete() async {
+            let registry = Kernel.Process.Registry(shards: 4)
+            let pid = Kernel.Process.ID(rawValue: 202)
+
+            let waiter = Task { await registry.wait(pid) }
+            while registry.count == 0 {
+                await Task.yield()
+            }
+            #expect(registry.complete(result(202, exit: 7)))
+
+            let collected = await waiter.value
+            #expect(collected.pid == pid)
+            #expect(collected.status.exit.code == 7)
+        }
+
+        @Test("discard removes a parked result")
+        func discardParked() {
+            let registry = Kernel.Process.Registry()
+            registry.complete(result(303, exit: 0))
+
+            #expect(registry.discard(Kernel.Process.ID(rawValue: 303)) != nil)
+            #expect(registry.discard(Kernel.Process.ID(rawValue: 303)) == nil)
+            #expect(registry.count == 0)
+        }
+    }
+
+    // MARK: - Integration Tests
+
+    extension Kernel.Process.Registry.Test.Integration {
+        @Test("drain completes the waiter for a spawned child")
+        func drainCompletesSpawnedChild() async throws {
+            let registry = Kernel.Process.Registry()
+            let child = try POSIXTestHelper.spawn("exit", "12")
+            let waiter = Task { await registry.wait(child) }
+
+            let buffer = UnsafeMutableBufferPointer<Kernel.Process.Wait.Result>.allocate(capacity: 4)
+            defer { buffer.deallocate() }
+
+            // Reap only this child; other tests own the rest
+            while try registry.drain(.process(child), into: buffer) == 0 {
+                try await Task.sleep(for: .milliseconds(5))
+            }
+
+            let result = await waiter.value
+            #expect(result.pid == child)
+            #expect(result.status.exit.code == 12)
+        }
+    }
+
+#endif
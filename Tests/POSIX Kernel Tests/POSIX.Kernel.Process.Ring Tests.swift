@@ -0,0 +1,183 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(Linux)
+
+    import Glibc
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Ring {
+        #TestSuites
+    }
+
+    extension Kernel.Process.Ring.Test {
+        @Suite struct Integration {}
+    }
+
+    // MARK: - Integration Tests
+    //
+    // io_uring may be compiled out or disabled by policy (sysctl
+    // kernel.io_uring_disabled, seccomp); tests return early when the ring
+    // cannot be created.
+
+    extension Kernel.Process.Ring.Test.Integration {
+        /// A ring, or `nil` if io_uring is unavailable here.
+        private func ring(entries: Int = 8) throws -> Kernel.Process.Ring? {
+            do {
+                return try Kernel.Process.Ring(entries: entries)
+            } catch .ring(.posix(let code)) where code == ENOSYS || code == EPERM {
+                return nil
+            }
+        }
+
+        /// Submits and collects until `count` completions have arrived.
+        private func collect(_ ring: Kernel.Process.Ring, count: Int) throws -> [Kernel.Process.Ring.Completion] {
+            let buffer = UnsafeMutableBufferPointer<Kernel.Process.Ring.Completion>.allocate(capacity: 16)
+            defer { buffer.deallocate() }
+
+            var collected: [Kernel.Process.Ring.Completion] = []
+            while collected.count < count {
+                try ring.submit(waitingFor: 1)
+                let n = ring.completions(into: buffer)
+                collected.append(contentsOf: buffer[..<n])
+            }
+            return collected
+        }
+
+        @Test("wait completes into Wait.Result for every child in one batch")
+        func waitBatch() throws {
+            guard let ring = try ring() else { return }
+
+            var handles: [Kernel.Process.Handle] = []
+            defer { for handle in handles { try? Kernel.Process.Handle.close(handle) } }
+            for code in 0..<4 {
+                let child = try POSIXTestHelper.spawn("exit", "\(code + 10)")
+                handles.append(try Kernel.Process.Handle.open(child))
+            }
+
+            for (index, handle) in handles.enumerated() {
+                try ring.wait(handle, tag: UInt64(index))
+            }
+
+            for completion in try collect(ring, count: handles.count) {
+                let index = Int(completion.tag)
+                if case .failed(.posix(EINVAL)) = completion.event {
+                    // Pre-6.7 kernel without IORING_OP_WAITID: reap directly
+                    _ = try Kernel.Process.Wait.wait(handles[index])
+                    continue
+                }
+                guard case .exited(let result) = completion.event else {
+                    Issue.record("unexpected \(completion.event)")
+                    continue
+                }
+                #expect(result.pid == handles[index].pid)
+                #expect(result.status.exit.code == Int32(index + 10))
+            }
+        }
+
+        @Test("poll reports a pidfd readable without reaping")
+        func pollWithoutReaping() throws {
+            guard let ring = try ring() else { return }
+
+            let child = try POSIXTestHelper.spawn("exit", "3")
+            let handle = try Kernel.Process.Handle.open(child)
+            defer { try? Kernel.Process.Handle.close(handle) }
+
+            try ring.poll(handle, tag: 7)
+            let completions = try collect(ring, count: 1)
+            #expect(completions == [Kernel.Process.Ring.Completion(tag: 7, event: .readable)])
+
+            let result = try Kernel.Process.Wait.wait(handle, options: .no.hang)
+            #expect(result?.status.exit.code == 3)
+        }
+
+        @Test("read delivers pending signals as stream records")
+        func readSignals() throws {
+            guard let ring = try ring() else { return }
+
+            let previous = try Kernel.Signal.Action.set(signal: .user2, .init(handler: .ignore))
+            defer { _ = try? Kernel.Signal.Action.set(signal: .user2, previous) }
+
+            let signals = Kernel.Signal.Set(__unchecked: (), .user2)
+            let stream = try Kernel.Signal.Stream(signals)
+            defer {
+                stream.close()
+                _ = try? Kernel.Signal.Mask.change(.unblock, signals: signals)
+            }
+
+            try ring.read(stream, tag: 1)
+            #expect(throws: Kernel.Process.Error.ring(.posix(EBUSY))) {
+                try ring.read(stream, tag: 2)
+            }
+            try ring.submit()
+            try Kernel.Signal.Send.toSelf(.user2)
+
+            let completions = try collect(ring, count: 1)
+            #expect(completions.first?.tag == 1)
+            guard case .signals(let count) = completions.first?.event else {
+                Issue.record("unexpected \(String(describing: completions.first))")
+                return
+            }
+            #expect(count >= 1)
+            #expect(ring.signals.count == count)
+            #expect(ring.signals.contains { $0.signal == .user2 })
+        }
+
+        @Test("splice moves bytes between pipes")
+        func splicePipes() throws {
+            guard let ring = try ring() else { return }
+
+            let input = try Kernel.Process.Pipe.create()
+            let output = try Kernel.Process.Pipe.create()
+            defer {
+                for end in [input.read, input.write, output.read, output.write] {
+                    Kernel.Process.Pipe.close(end)
+                }
+            }
+
+            let bytes: [UInt8] = Array("ring".utf8)
+            #expect(write(input.write.rawValue, bytes, bytes.count) == bytes.count)
+
+            try ring.splice(from: input.read, to: output.write, count: 64, tag: 9)
+            let completions = try collect(ring, count: 1)
+            #expect(completions == [Kernel.Process.Ring.Completion(tag: 9, event: .spliced(bytes.count))])
+
+            var received = [UInt8](repeating: 0, count: bytes.count)
+            #expect(read(output.read.rawValue, &received, received.count) == bytes.count)
+            #expect(received == bytes)
+        }
+
+        @Test("Queueing past capacity throws EBUSY")
+        func capacityExhausted() throws {
+            guard let ring = try ring(entries: 1) else { return }
+
+            let pipe = try Kernel.Process.Pipe.create()
+            defer {
+                Kernel.Process.Pipe.close(pipe.read)
+                Kernel.Process.Pipe.close(pipe.write)
+            }
+            let handle = Kernel.Process.Handle(pid: Kernel.Process.ID(rawValue: 0), descriptor: pipe.read)
+
+            // Polls on an empty pipe stay in flight until the ring deinitialises
+            for tag in 0..<ring.capacity {
+                try ring.poll(handle, tag: UInt64(tag))
+            }
+            #expect(throws: Kernel.Process.Error.ring(.posix(EBUSY))) {
+                try ring.poll(handle, tag: 99)
+            }
+        }
+    }
+
+#endif
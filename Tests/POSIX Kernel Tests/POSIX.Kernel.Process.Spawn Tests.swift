@@ -0,0 +1,180 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS)
+
+    import Darwin
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Spawn {
+        #TestSuites
+    }
+
+    extension Kernel.Process.Spawn.Test {
+        @Suite struct Integration {}
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Process.Spawn.Test.Unit {
+        @Test("FileActions can be created and configured")
+        func fileActionsConfigure() throws {
+            let actions = try Kernel.Process.Spawn.FileActions()
+            try actions.close(Kernel.Descriptor(rawValue: 3))
+        }
+
+        @Test("Attributes can be created and configured")
+        func attributesConfigure() throws {
+            let attributes = try Kernel.Process.Spawn.Attributes()
+            try attributes.group(.same)
+            try attributes.mask(Kernel.Signal.Set())
+            try attributes.reset(Kernel.Signal.Set(__unchecked: (), .pipe))
+            try attributes.close(except: [Kernel.Descriptor(rawValue: 9)])
+            #expect(attributes.kept == [0, 1, 2, 9])
+        }
+    }
+
+    // MARK: - Integration Tests
+
+    extension Kernel.Process.Spawn.Test.Integration {
+        /// Spawns `/bin/sh -c script` with the given file actions.
+        private static func shell(
+            _ script: String,
+            fileActions: Kernel.Process.Spawn.FileActions
+        ) throws -> Kernel.Process.ID {
+            let path = "/bin/sh"
+            let argv = [path, "-c", script]
+            let envp: [String] = []
+
+            return try Kernel.Path.scope(path) { pathPtr in
+                try Kernel.Path.scope.array(argv, envp) { argvPtr, envpPtr in
+                    try POSIX.Kernel.Process.Spawn.spawn(
+                        path: pathPtr.unsafeCString,
+                        argv: argvPtr,
+                        envp: envpPtr,
+                        fileActions: fileActions
+                    )
+                }
+            }
+        }
+
+        @Test("open file action makes descriptor available in child")
+        func openActionProvidesDescriptor() throws {
+            let actions = try Kernel.Process.Spawn.FileActions()
+            try "/dev/null".withCString { path in
+                try actions.open(Kernel.Descriptor(rawValue: 3), path: path, flags: O_RDONLY)
+            }
+
+            let child = try Self.shell(": <&3 && exit 5", fileActions: actions)
+            let result = try Kernel.Process.Wait.wait(.process(child))
+            #expect(result?.status.exit.code == 5, "fd 3 should be readable in child")
+        }
+
+        @Test("close file action removes descriptor in child")
+        func closeActionRemovesDescriptor() throws {
+            let actions = try Kernel.Process.Spawn.FileActions()
+            try "/dev/null".withCString { path in
+                try actions.open(Kernel.Descriptor(rawValue: 3), path: path, flags: O_RDONLY)
+            }
+            try actions.close(Kernel.Descriptor(rawValue: 3))
+
+            let child = try Self.shell(": <&3 && exit 5", fileActions: actions)
+            let result = try Kernel.Process.Wait.wait(.process(child))
+            #expect(result?.status.exit.code != 5, "fd 3 should be closed in child")
+        }
+
+        @Test("file actions are reusable across spawns")
+        func fileActionsReusable() throws {
+            let actions = try Kernel.Process.Spawn.FileActions()
+            try "/dev/null".withCString { path in
+                try actions.open(Kernel.Descriptor(rawValue: 3), path: path, flags: O_RDONLY)
+            }
+
+            for _ in 0..<3 {
+                let child = try Self.shell(": <&3 && exit 5", fileActions: actions)
+                let result = try Kernel.Process.Wait.wait(.process(child))
+                #expect(result?.status.exit.code == 5)
+            }
+        }
+
+        @Test("group(.same) makes child a process group leader")
+        func groupSameMakesLeader() throws {
+            let attributes = try Kernel.Process.Spawn.Attributes()
+            try attributes.group(.same)
+
+            let child = try POSIXTestHelper.spawn(["stop-exit", "0"], fileActions: nil, attributes: attributes)
+
+            // Child is stopped: its group can be queried without racing its exit
+            _ = try Kernel.Process.Wait.wait(.process(child), options: [.untraced])
+            let pgid = try Kernel.Process.Group.id(of: child)
+            #expect(pgid.rawValue == child.rawValue)
+
+            try POSIX.Kernel.Signal.Send.toProcess(.continue, pid: child)
+            let exited = try Kernel.Process.Wait.wait(.process(child))
+            #expect(exited?.status.exit.code == 0)
+        }
+
+        @Test("session() makes child a session leader")
+        func sessionMakesLeader() throws {
+            let attributes = try Kernel.Process.Spawn.Attributes()
+            try attributes.session()
+
+            let child = try POSIXTestHelper.spawn(["stop-exit", "0"], fileActions: nil, attributes: attributes)
+
+            _ = try Kernel.Process.Wait.wait(.process(child), options: [.untraced])
+            let sid = try Kernel.Process.Session.id(of: child)
+            #expect(sid.rawValue == child.rawValue)
+
+            try POSIX.Kernel.Signal.Send.toProcess(.continue, pid: child)
+            let exited = try Kernel.Process.Wait.wait(.process(child))
+            #expect(exited?.status.exit.code == 0)
+        }
+
+        @Test("close(except:) keeps only stdio and the kept list")
+        func closeExceptKeepsList() throws {
+            // Opened without O_CLOEXEC: would leak into the child by default
+            let kept = open("/dev/null", O_RDONLY)
+            let leaked = open("/dev/null", O_RDONLY)
+            defer {
+                _ = Darwin.close(kept)
+                _ = Darwin.close(leaked)
+            }
+
+            let attributes = try Kernel.Process.Spawn.Attributes()
+            try attributes.close(except: [Kernel.Descriptor(rawValue: kept)])
+
+            let child = try POSIXTestHelper.spawn(["fd-open", "0", "1", "2", "\(kept)"], fileActions: nil, attributes: attributes)
+            #expect(try Kernel.Process.Wait.wait(.process(child))?.status.exit.code == 0)
+
+            let closed = try POSIXTestHelper.spawn(["fd-open", "\(leaked)"], fileActions: nil, attributes: attributes)
+            #expect(try Kernel.Process.Wait.wait(.process(closed))?.status.exit.code == 1)
+        }
+
+        @Test("close(except:) keeps file action targets")
+        func closeExceptKeepsFileActionTargets() throws {
+            let actions = try Kernel.Process.Spawn.FileActions()
+            try "/dev/null".withCString { path in
+                try actions.open(Kernel.Descriptor(rawValue: 7), path: path, flags: O_RDONLY)
+            }
+
+            let attributes = try Kernel.Process.Spawn.Attributes()
+            try attributes.close(except: [])
+
+            let child = try POSIXTestHelper.spawn(["fd-open", "7"], fileActions: actions, attributes: attributes)
+            #expect(try Kernel.Process.Wait.wait(.process(child))?.status.exit.code == 0)
+        }
+    }
+
+#endif
@@ -0,0 +1,147 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Spawn.Arguments {
+        #TestSuites
+    }
+
+    extension Kernel.Process.Spawn.Arguments.Test {
+        @Suite struct Integration {}
+    }
+
+    /// Decodes a NULL-terminated vector.
+    private func strings(_ vector: UnsafePointer<UnsafePointer<CChar>?>) -> [String] {
+        var result: [String] = []
+        var cursor = vector
+        while let string = cursor.pointee {
+            result.append(String(cString: string))
+            cursor += 1
+        }
+        return result
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Process.Spawn.Arguments.Test.Unit {
+        @Test("argv and envp hold the given strings")
+        func vectors() {
+            let arguments = Kernel.Process.Spawn.Arguments(
+                ["/bin/echo", "a", "b"],
+                environment: .explicit(["A=1", "B=2"])
+            )
+            #expect(strings(arguments.argv) == ["/bin/echo", "a", "b"])
+            #expect(strings(arguments.envp) == ["A=1", "B=2"])
+            #expect(String(cString: arguments.path) == "/bin/echo")
+            #expect(arguments.count == 3)
+        }
+
+        @Test("set rewrites a slot in place when the value fits")
+        func setInPlace() {
+            let arguments = Kernel.Process.Spawn.Arguments(["/bin/echo", "000000"])
+            let before = arguments.argv[1]
+
+            arguments.set(1, to: "42")
+            #expect(arguments[1] == "42")
+            #expect(arguments.argv[1] == before)
+
+            arguments.set(1, to: "123456")
+            #expect(arguments[1] == "123456")
+            #expect(arguments.argv[1] == before)
+        }
+
+        @Test("set relocates a value that outgrows its slot")
+        func setGrows() {
+            let arguments = Kernel.Process.Spawn.Arguments(["/bin/echo", "x"])
+            let long = String(repeating: "y", count: 500)
+
+            arguments.set(1, to: long)
+            #expect(strings(arguments.argv) == ["/bin/echo", long])
+        }
+
+        @Test("append extends argv and keeps envp")
+        func append() {
+            let arguments = Kernel.Process.Spawn.Arguments(["/bin/echo"], environment: .explicit(["A=1"]))
+            for index in 0..<20 {
+                arguments.append("arg\(index)")
+            }
+            #expect(arguments.count == 21)
+            #expect(arguments[20] == "arg19")
+            #expect(strings(arguments.envp) == ["A=1"])
+        }
+
+        @Test("set(variable:) overrides or adds")
+        func variables() {
+            let arguments = Kernel.Process.Spawn.Arguments(["/bin/echo"], environment: .explicit(["A=1", "AB=2"]))
+
+            arguments.set(variable: "A", to: "9")
+            arguments.set(variable: "C", to: "3")
+            #expect(strings(arguments.envp) == ["A=9", "AB=2", "C=3"])
+
+            arguments.remove(variable: "AB")
+            #expect(strings(arguments.envp) == ["A=9", "C=3"])
+        }
+
+        // Reads the process environment only: setenv could move or free
+        // strings that tests running in parallel have borrowed.
+        @Test("inherit borrows environ and applies overrides")
+        func inherit() {
+            let arguments = Kernel.Process.Spawn.Arguments(["/bin/echo"], environment: .inherit)
+            let inherited = strings(arguments.envp)
+
+            for entry in inherited {
+                let split = entry.split(separator: "=", maxSplits: 1, omittingEmptySubsequences: false)
+                let value = getenv(String(split[0])).map { String(cString: $0) }
+                #expect(value == (split.count > 1 ? String(split[1]) : ""))
+            }
+
+            let name =
+                inherited.first.map { String($0.prefix { $0 != "=" }) } ?? "SWIFT_POSIX_ARGUMENTS_TEST"
+            let before = getenv(name).map { String(cString: $0) }
+
+            arguments.set(variable: name, to: "overridden")
+            let envp = strings(arguments.envp)
+            #expect(envp.contains("\(name)=overridden"))
+            #expect(envp.filter { $0.hasPrefix("\(name)=") }.count == 1)
+            #expect(getenv(name).map { String(cString: $0) } == before)
+        }
+    }
+
+    // MARK: - Integration Tests
+
+    extension Kernel.Process.Spawn.Arguments.Test.Integration {
+        @Test("spawn uses the arena and a reused slot")
+        func spawnFromTemplate() throws {
+            let arguments = Kernel.Process.Spawn.Arguments([POSIXTestHelper.executablePath(), "exit", "00"])
+
+            for code in ["7", "42"] {
+                arguments.set(2, to: code)
+                let child = try Kernel.Process.Spawn.spawn(arguments)
+                let result = try Kernel.Process.Wait.wait(.process(child))
+                #expect(result?.status.exit.code == Int32(code))
+            }
+        }
+    }
+
+#endif
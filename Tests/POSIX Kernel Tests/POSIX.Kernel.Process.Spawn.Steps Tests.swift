@@ -0,0 +1,165 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Spawn.Steps {
+        #TestSuites
+    }
+
+    extension Kernel.Process.Spawn.Steps.Test {
+        @Suite struct Integration {}
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Process.Spawn.Steps.Test.Unit {
+        @Test("builders append steps in order")
+        func buildersAppend() {
+            let steps = Kernel.Process.Spawn.Steps()
+            steps.directory("/")
+            steps.session()
+            steps.close(from: Kernel.Descriptor(rawValue: 3))
+            steps.limit(.core, soft: 0, hard: Kernel.Process.Limit.infinity)
+
+            #expect(steps.count == 4)
+            #expect(steps.pointer[0].kind == Int32(SWIFT_STEP_CHDIR))
+            #expect(steps.pointer[2].second == -1)
+            #expect(steps.pointer[3].hard == Kernel.Process.Limit.infinity)
+        }
+
+        @Test("close(except:) sorts the kept list and always keeps stdio")
+        func closeExceptKeptList() {
+            let kept = Kernel.Process.Spawn.Steps.kept([9, 4, 9, 1, -1].map { Kernel.Descriptor(rawValue: $0) })
+            #expect(kept == [0, 1, 2, 4, 9])
+
+            let steps = Kernel.Process.Spawn.Steps()
+            steps.close(except: [Kernel.Descriptor(rawValue: 5)])
+            #expect(steps.pointer[0].kind == Int32(SWIFT_STEP_CLOSE_EXCEPT))
+            #expect(steps.pointer[0].first == 4)
+        }
+
+        @Test("step list grows past its initial capacity")
+        func growth() {
+            let steps = Kernel.Process.Spawn.Steps()
+            for _ in 0..<100 {
+                steps.session()
+            }
+            #expect(steps.count == 100)
+        }
+    }
+
+    // MARK: - Integration Tests
+
+    extension Kernel.Process.Spawn.Steps.Test.Integration {
+        @Test("child runs steps and execs")
+        func spawnRunsSteps() throws {
+            let steps = Kernel.Process.Spawn.Steps()
+            steps.directory("/")
+            steps.limit(.core, soft: 0, hard: Kernel.Process.Limit.infinity)
+            steps.close(from: Kernel.Descriptor(rawValue: 3))
+
+            let arguments = Kernel.Process.Spawn.Arguments([POSIXTestHelper.executablePath(), "exit", "9"])
+            let child = try Kernel.Process.Spawn.spawn(arguments, steps: steps)
+
+            let result = try Kernel.Process.Wait.wait(.process(child))
+            #expect(result?.status.exit.code == 9)
+        }
+
+        @Test("group(.same) makes child a process group leader")
+        func groupSameMakesLeader() throws {
+            let steps = Kernel.Process.Spawn.Steps()
+            steps.group(.same)
+
+            let arguments = Kernel.Process.Spawn.Arguments([POSIXTestHelper.executablePath(), "stop-exit", "0"])
+            let child = try Kernel.Process.Spawn.spawn(arguments, steps: steps)
+
+            _ = try Kernel.Process.Wait.wait(.process(child), options: [.untraced])
+            let pgid = try Kernel.Process.Group.id(of: child)
+            #expect(pgid.rawValue == child.rawValue)
+
+            try POSIX.Kernel.Signal.Send.toProcess(.continue, pid: child)
+            _ = try Kernel.Process.Wait.wait(.process(child))
+        }
+
+        @Test("close(except:) closes unlisted descriptors at exec")
+        func closeExceptClosesOthers() throws {
+            #if canImport(Darwin)
+                let leaked = Darwin.open("/dev/null", O_RDONLY)
+                defer { _ = Darwin.close(leaked) }
+            #else
+                let leaked = Glibc.open("/dev/null", O_RDONLY)
+                defer { _ = Glibc.close(leaked) }
+            #endif
+
+            let steps = Kernel.Process.Spawn.Steps()
+            steps.close(except: [])
+
+            let arguments = Kernel.Process.Spawn.Arguments([POSIXTestHelper.executablePath(), "fd-open", "\(leaked)"])
+            let child = try Kernel.Process.Spawn.spawn(arguments, steps: steps)
+            #expect(try Kernel.Process.Wait.wait(.process(child))?.status.exit.code == 1)
+        }
+
+        @Test("a failing step surfaces its errno")
+        func failingStepThrows() {
+            let steps = Kernel.Process.Spawn.Steps()
+            steps.directory("/nonexistent/swift-posix")
+
+            let arguments = Kernel.Process.Spawn.Arguments([POSIXTestHelper.executablePath(), "exit", "0"])
+            #expect(throws: Kernel.Process.Error.spawn(.posix(ENOENT))) {
+                _ = try Kernel.Process.Spawn.spawn(arguments, steps: steps)
+            }
+        }
+
+        @Test("Attributes.limit applies an rlimit in the child")
+        func attributesLimit() throws {
+            // Lowering both limits is always permitted
+            let attributes = try Kernel.Process.Spawn.Attributes()
+            attributes.limit(.files, soft: 64, hard: 64)
+
+            let arguments = Kernel.Process.Spawn.Arguments([POSIXTestHelper.executablePath(), "nofile-is", "64"])
+            let child = try Kernel.Process.Spawn.spawn(arguments, attributes: attributes)
+            #expect(try Kernel.Process.Wait.wait(.process(child))?.status.exit.code == 0)
+        }
+
+        @Test("Attributes.nice applies a nice value in the child")
+        func attributesNice() throws {
+            // Raising the nice value to the maximum is always permitted
+            let attributes = try Kernel.Process.Spawn.Attributes()
+            attributes.nice(19)
+
+            let arguments = Kernel.Process.Spawn.Arguments([POSIXTestHelper.executablePath(), "nice-is", "19"])
+            let child = try Kernel.Process.Spawn.spawn(arguments, attributes: attributes)
+            #expect(try Kernel.Process.Wait.wait(.process(child))?.status.exit.code == 0)
+        }
+
+        @Test("a failing execve surfaces its errno")
+        func failingExecThrows() {
+            let arguments = Kernel.Process.Spawn.Arguments(["/nonexistent/swift-posix"])
+            #expect(throws: Kernel.Process.Error.spawn(.posix(ENOENT))) {
+                _ = try Kernel.Process.Spawn.spawn(arguments, steps: Kernel.Process.Spawn.Steps())
+            }
+        }
+    }
+
+#endif
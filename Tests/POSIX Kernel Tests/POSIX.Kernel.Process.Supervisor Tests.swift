@@ -0,0 +1,243 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Synchronization
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Supervisor {
+        #TestSuites
+    }
+
+    extension Kernel.Process.Supervisor.Test {
+        @Suite(.serialized) struct Integration {}
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Process.Supervisor.Test.Unit {
+        @Test("delay doubles from initial and caps at maximum")
+        func policyDelay() {
+            let policy = Kernel.Process.Supervisor.Policy(initial: .milliseconds(100), maximum: .seconds(1))
+            #expect(policy.delay(after: 0) == .milliseconds(100))
+            #expect(policy.delay(after: 1) == .milliseconds(200))
+            #expect(policy.delay(after: 3) == .milliseconds(800))
+            #expect(policy.delay(after: 4) == .seconds(1))
+            #expect(policy.delay(after: 1_000) == .seconds(1))
+        }
+
+        @Test("a zero initial delay restarts immediately")
+        func policyZeroDelay() {
+            let policy = Kernel.Process.Supervisor.Policy(initial: .zero)
+            #expect(policy.delay(after: 10) == .zero)
+        }
+
+        @Test("histogram buckets by power of two")
+        func histogramBuckets() {
+            var histogram = Kernel.Process.Supervisor.Histogram()
+            histogram.record(0)
+            histogram.record(1)
+            histogram.record(1_000)
+            histogram.record(UInt64.max)
+
+            #expect(histogram.count == 4)
+            #expect(histogram.buckets[0] == 2)
+            #expect(histogram.buckets[9] == 1)
+            #expect(histogram.buckets[63] == 1)
+            #expect(histogram.maximum == UInt64.max)
+        }
+
+        @Test("histograms compare equal only with the same buckets")
+        func histogramEquality() {
+            var lhs = Kernel.Process.Supervisor.Histogram()
+            var rhs = Kernel.Process.Supervisor.Histogram()
+            lhs.record(4)
+            rhs.record(4)
+            #expect(lhs == rhs)
+
+            // Same count, total and maximum; different buckets
+            lhs.record(4)
+            lhs.record(1)
+            rhs.record(3)
+            rhs.record(2)
+            #expect(lhs.total == rhs.total)
+            #expect(lhs != rhs)
+
+            let snapshot = lhs
+            lhs.record(5)
+            #expect(snapshot != lhs)
+            #expect(snapshot.count == 3)
+        }
+
+        @Test("percentile bounds the quantile within a factor of two")
+        func histogramPercentile() {
+            var histogram = Kernel.Process.Supervisor.Histogram()
+            #expect(histogram.percentile(0.5) == 0)
+
+            for value in 1...100 {
+                histogram.record(UInt64(value) * 1_000)
+            }
+            let median = histogram.percentile(0.5)
+            #expect(median >= 50_000 && median < 100_000)
+            #expect(histogram.percentile(1) == 100_000)
+            #expect(histogram.mean == 50_500)
+        }
+
+        @Test("statistics start at zero")
+        func statisticsDefaults() {
+            let statistics = Kernel.Process.Supervisor.Statistics()
+            #expect(statistics.spawned == 0)
+            #expect(statistics.running == 0)
+            #expect(statistics.spawn.count == 0)
+        }
+    }
+
+    // MARK: - Integration Tests
+
+    extension Kernel.Process.Supervisor.Test.Integration {
+        /// Lets the event handler reach the supervisor it was passed to.
+        private final class Reference: @unchecked Sendable {
+            var supervisor: Kernel.Process.Supervisor?
+        }
+
+        private func helper(_ args: String...) -> Kernel.Process.Spawn.Arguments {
+            Kernel.Process.Spawn.Arguments([POSIXTestHelper.executablePath()] + args)
+        }
+
+        @Test("a clean exit is not restarted under .onFailure")
+        func cleanExit() throws {
+            let reference = Reference()
+            let supervisor = try Kernel.Process.Supervisor { event in
+                if case .exited(_, let result, restarting: false) = event {
+                    #expect(result.status.exit.code == 0)
+                    reference.supervisor?.shutdown()
+                }
+            }
+            reference.supervisor = supervisor
+
+            supervisor.add(helper("exit", "0"))
+            try supervisor.run()
+
+            let statistics = supervisor.statistics
+            #expect(statistics.spawned == 1)
+            #expect(statistics.exited == 1)
+            #expect(statistics.restarted == 0)
+            #expect(statistics.running == 0)
+            #expect(statistics.spawn.count == 1)
+            #expect(statistics.reap.count == 1)
+        }
+
+        @Test("a failing child is restarted up to the policy's limit")
+        func restartLimit() throws {
+            let reference = Reference()
+            let exits = Mutex<[Int32?]>([])
+            let supervisor = try Kernel.Process.Supervisor { event in
+                if case .exited(_, let result, let restarting) = event {
+                    exits.withLock { $0.append(result.status.exit.code) }
+                    if !restarting {
+                        reference.supervisor?.shutdown()
+                    }
+                }
+            }
+            reference.supervisor = supervisor
+
+            supervisor.add(helper("exit", "3"), policy: .init(restart: .onFailure, initial: .zero, restarts: 2))
+            try supervisor.run()
+
+            #expect(exits.withLock { $0 } == [3, 3, 3])
+            let statistics = supervisor.statistics
+            #expect(statistics.spawned == 3)
+            #expect(statistics.restarted == 2)
+        }
+
+        @Test("no more than limit children run at once")
+        func concurrencyLimit() throws {
+            let reference = Reference()
+            let state = Mutex((running: 0, peak: 0, exited: 0))
+            let supervisor = try Kernel.Process.Supervisor(limit: 2, batch: 1) { event in
+                switch event {
+                case .started:
+                    state.withLock {
+                        $0.running += 1
+                        $0.peak = max($0.peak, $0.running)
+                    }
+                case .exited:
+                    let done = state.withLock {
+                        $0.running -= 1
+                        $0.exited += 1
+                        return $0.exited == 6
+                    }
+                    if done {
+                        reference.supervisor?.shutdown()
+                    }
+                default:
+                    break
+                }
+            }
+            reference.supervisor = supervisor
+
+            for _ in 0..<6 {
+                supervisor.add(helper("exit", "0"), policy: .init(restart: .never))
+            }
+            try supervisor.run()
+
+            #expect(state.withLock { $0.peak } <= 2)
+            #expect(supervisor.statistics.exited == 6)
+            #expect(supervisor.statistics.largestBatch == 1)
+        }
+
+        @Test("shutdown signals running children and returns once they are reaped")
+        func shutdownSignals() throws {
+            let reference = Reference()
+            let signal = Mutex<Kernel.Signal.Number?>(nil)
+            let supervisor = try Kernel.Process.Supervisor { event in
+                switch event {
+                case .started:
+                    reference.supervisor?.shutdown(.terminate, grace: .seconds(5))
+                case .exited(_, let result, let restarting):
+                    #expect(restarting == false)
+                    signal.withLock { $0 = result.status.terminating.signal }
+                default:
+                    break
+                }
+            }
+            reference.supervisor = supervisor
+
+            supervisor.add(helper("hold-tree", "0", "1"), policy: .init(restart: .always))
+            try supervisor.run()
+
+            #expect(signal.withLock { $0 } == .terminate)
+            #expect(supervisor.statistics.restarted == 0)
+        }
+
+        @Test("children added after shutdown are never started")
+        func addAfterShutdown() throws {
+            let supervisor = try Kernel.Process.Supervisor()
+            supervisor.shutdown()
+            supervisor.add(helper("exit", "0"))
+            try supervisor.run()
+
+            #expect(supervisor.statistics.spawned == 0)
+        }
+    }
+
+#endif
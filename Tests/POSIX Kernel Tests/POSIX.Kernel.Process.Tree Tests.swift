@@ -0,0 +1,128 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Tree {
+        #TestSuites
+    }
+
+    extension Kernel.Process.Tree.Test {
+        @Suite struct Integration {}
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Process.Tree.Test.Unit {
+        @Test("snapshot of a missing process throws ESRCH")
+        func snapshotMissing() {
+            let buffer = UnsafeMutableBufferPointer<Kernel.Process.ID>.allocate(capacity: 4)
+            defer { buffer.deallocate() }
+
+            #expect(throws: Kernel.Process.Error.tree(.posix(ESRCH))) {
+                // Above PID_MAX_LIMIT (2^22) on Linux and PID_MAX (99999) on Darwin
+                _ = try Kernel.Process.Tree.snapshot(of: Kernel.Process.ID(rawValue: 0x7fff_fff0), into: buffer)
+            }
+        }
+    }
+
+    // MARK: - Integration Tests
+    //
+    // `hold-tree 2 3` is the helper plus 3 children and 9 grandchildren;
+    // the grandchildren call setsid, so no group or session reaches them.
+
+    extension Kernel.Process.Tree.Test.Integration {
+        /// Walks until `expected` descendants have forked, or 10 s pass.
+        private func settle(
+            _ root: Kernel.Process.ID,
+            _ expected: Int,
+            _ buffer: UnsafeMutableBufferPointer<Kernel.Process.ID>
+        ) throws -> Int {
+            var count = 0
+            for _ in 0..<10_000 {
+                count = try Kernel.Process.Tree.snapshot(of: root, into: buffer)
+                if count >= expected { break }
+                usleep(1_000)
+            }
+            return count
+        }
+
+        @Test("snapshot lists children before grandchildren")
+        func snapshotBreadthFirst() throws {
+            let root = try POSIXTestHelper.spawn("hold-tree", "2", "3")
+            let buffer = UnsafeMutableBufferPointer<Kernel.Process.ID>.allocate(capacity: 64)
+            defer { buffer.deallocate() }
+            defer { _ = try? Kernel.Process.Tree.teardown(root, into: buffer) }
+
+            #expect(try settle(root, 12, buffer) == 12)
+
+            let scratch = UnsafeMutableBufferPointer<Kernel.Process.ID>.allocate(capacity: 8)
+            defer { scratch.deallocate() }
+            for child in buffer[0..<3] {
+                #expect(try Kernel.Process.Tree.snapshot(of: child, into: scratch) == 3)
+            }
+            for grandchild in buffer[3..<12] {
+                #expect(try Kernel.Process.Tree.snapshot(of: grandchild, into: scratch) == 0)
+            }
+        }
+
+        @Test("snapshot reports a full buffer when truncated")
+        func snapshotTruncated() throws {
+            let root = try POSIXTestHelper.spawn("hold-tree", "2", "3")
+            let buffer = UnsafeMutableBufferPointer<Kernel.Process.ID>.allocate(capacity: 64)
+            defer { buffer.deallocate() }
+            defer { _ = try? Kernel.Process.Tree.teardown(root, into: buffer) }
+
+            _ = try settle(root, 12, buffer)
+            let small = UnsafeMutableBufferPointer(rebasing: buffer[0..<5])
+            #expect(try Kernel.Process.Tree.snapshot(of: root, into: small) == 5)
+        }
+
+        #if os(Linux)
+            @Test("teardown as subreaper kills and reaps the whole tree")
+            func teardownReapsTree() throws {
+                let wasSubreaper = try Kernel.Process.Tree.isSubreaper()
+                try Kernel.Process.Tree.subreaper(true)
+                defer { try? Kernel.Process.Tree.subreaper(wasSubreaper) }
+                #expect(try Kernel.Process.Tree.isSubreaper())
+
+                let root = try POSIXTestHelper.spawn("hold-tree", "2", "3")
+                let buffer = UnsafeMutableBufferPointer<Kernel.Process.ID>.allocate(capacity: 64)
+                defer { buffer.deallocate() }
+
+                #expect(try settle(root, 12, buffer) == 12)
+                let descendants = Array(buffer[..<12])
+
+                let teardown = try Kernel.Process.Tree.teardown(root, into: buffer)
+                #expect(teardown == Kernel.Process.Tree.Teardown(count: 13, killed: 13, reaped: 13))
+
+                // Nothing left to signal
+                for pid in descendants {
+                    #expect(kill(pid.rawValue, 0) == -1)
+                }
+                #expect(kill(root.rawValue, 0) == -1)
+            }
+        #endif
+    }
+
+#endif
@@ -11,6 +11,7 @@
 
 #if os(macOS)
 
+    import Darwin
     import StandardsTestSupport
     import Testing
 
@@ -212,4 +213,96 @@
         }
     }
 
+    // MARK: - Usage Tests
+
+    extension Kernel.Process.Wait.Test.Integration {
+        @Test("Usage.wait reports resource usage with the reap")
+        func usageWaitCapturesUsage() throws {
+            let child = try POSIXTestHelper.spawn("exit", "3")
+
+            let result = try Kernel.Process.Wait.Usage.wait(.process(child))
+            #expect(result?.pid == child)
+            #expect(result?.status.exit.code == 3)
+
+            let usage = try #require(result?.usage)
+            #expect(usage.memory.peak > 0, "A process that ran has a non-zero RSS peak")
+            #expect(usage.time.user >= .zero)
+            #expect(usage.time.system >= .zero)
+        }
+
+        @Test("Usage.wait peak covers memory the child touched")
+        func usageWaitReportsTouchedMemory() throws {
+            let child = try POSIXTestHelper.spawn("touch-mb", "32")
+
+            let result = try Kernel.Process.Wait.Usage.wait(.process(child))
+            #expect(result?.status.exit.code == 0)
+            let usage = try #require(result?.usage)
+            #expect(usage.memory.peak >= 32 << 20)
+        }
+
+        @Test("fork-tree children are all reaped by the helper")
+        func forkTreeReapsSubtree() throws {
+            let child = try POSIXTestHelper.spawn("fork-tree", "3", "3")
+            let result = try Kernel.Process.Wait.wait(.process(child))
+            #expect(result?.status.exit.code == 0)
+        }
+
+        @Test("plain wait leaves usage nil")
+        func plainWaitHasNoUsage() throws {
+            let child = try POSIXTestHelper.spawn("exit", "0")
+            let result = try Kernel.Process.Wait.wait(.process(child))
+            #expect(result?.usage == nil)
+        }
+    }
+
+    // MARK: - Drain Tests
+
+    extension Kernel.Process.Wait.Test.Integration {
+        @Test("drain reaps every exited child in a group")
+        func drainReapsGroup() throws {
+            // Leader stays stopped so the group exists while members join it
+            let leaderAttributes = try Kernel.Process.Spawn.Attributes()
+            try leaderAttributes.group(.same)
+            let leader = try POSIXTestHelper.spawn(["stop-exit", "0"], fileActions: nil, attributes: leaderAttributes)
+            _ = try Kernel.Process.Wait.wait(.process(leader), options: [.untraced])
+
+            let pgid = Kernel.Process.Group.ID(leader.rawValue)
+            let memberAttributes = try Kernel.Process.Spawn.Attributes()
+            try memberAttributes.group(.id(pgid))
+            let first = try POSIXTestHelper.spawn(["exit", "1"], fileActions: nil, attributes: memberAttributes)
+            let second = try POSIXTestHelper.spawn(["exit", "2"], fileActions: nil, attributes: memberAttributes)
+
+            try POSIX.Kernel.Signal.Send.toProcess(.continue, pid: leader)
+
+            let buffer = UnsafeMutableBufferPointer<Kernel.Process.Wait.Result>.allocate(capacity: 8)
+            defer { buffer.deallocate() }
+
+            var reaped: [Kernel.Process.ID: Int32] = [:]
+            for _ in 0..<1000 where reaped.count < 3 {
+                let count = try Kernel.Process.Wait.drain(.group(pgid), into: buffer)
+                for result in buffer[..<count] {
+                    reaped[result.pid] = result.status.exit.code
+                }
+                if reaped.count < 3 { usleep(5_000) }
+            }
+
+            #expect(reaped[leader] == 0)
+            #expect(reaped[first] == 1)
+            #expect(reaped[second] == 2)
+        }
+
+        @Test("drain returns zero when no children remain")
+        func drainEmptyReturnsZero() throws {
+            let child = try POSIXTestHelper.spawn("exit", "0")
+            _ = try Kernel.Process.Wait.wait(.process(child))
+
+            let buffer = UnsafeMutableBufferPointer<Kernel.Process.Wait.Result>.allocate(capacity: 4)
+            defer { buffer.deallocate() }
+
+            // ECHILD is a stop condition, not an error
+            let count = try Kernel.Process.Wait.drain(.process(child), into: buffer)
+            #expect(count == 0)
+        }
+    }
+
 #endif
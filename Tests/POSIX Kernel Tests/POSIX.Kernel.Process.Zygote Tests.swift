@@ -0,0 +1,90 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Process.Zygote {
+        #TestSuites
+    }
+
+    extension Kernel.Process.Zygote.Test {
+        @Suite struct Integration {}
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Process.Zygote.Test.Unit {
+        @Test("Placement cases are distinct")
+        func placementCasesDistinct() {
+            #expect(Kernel.Process.Zygote.Placement.group != .session)
+        }
+
+        @Test("Worker stores pid and channel")
+        func workerStoresValues() {
+            let worker = Kernel.Process.Zygote.Worker(
+                pid: Kernel.Process.ID(123),
+                channel: Kernel.Socket.Descriptor(rawValue: 7)
+            )
+            #expect(worker.pid == Kernel.Process.ID(123))
+            #expect(worker.channel == Kernel.Socket.Descriptor(rawValue: 7))
+        }
+
+        @Test("Reply layout is two 32-bit words")
+        func replyLayout() {
+            #expect(MemoryLayout<Kernel.Process.Zygote.Message.Reply>.size == 8)
+        }
+
+        @Test("zygote error exposes its code")
+        func zygoteErrorCode() {
+            let error = Kernel.Process.Error.zygote(.posix(32))
+            #expect(error.code == .posix(32))
+            #expect(error.description.hasPrefix("zygote operation failed"))
+        }
+    }
+
+    // MARK: - Integration Tests
+    //
+    // NOTE: The zygote contract requires `start` to run before any thread
+    // exists, which a test runner cannot provide. posix-zygote-helper starts
+    // the zygote first thing in its main and exits with the number of the
+    // step that failed (0 on success).
+
+    extension Kernel.Process.Zygote.Test.Integration {
+        private func run(_ command: String) throws -> Kernel.Process.Status {
+            let path = POSIXTestHelper.executablePath(named: "posix-zygote-helper", variable: "POSIX_ZYGOTE_HELPER")
+            let arguments = Kernel.Process.Spawn.Arguments([path, command])
+            let child = try Kernel.Process.Spawn.spawn(arguments)
+            let result = try #require(try Kernel.Process.Wait.wait(.process(child)))
+            return result.status
+        }
+
+        @Test("a forked worker answers over its channel and is reaped")
+        func workerExchange() throws {
+            let status = try run("worker")
+            #expect(status.exited)
+            #expect(status.exit.code == 0)
+        }
+
+        @Test("a pool hands out a warm worker and replenishes")
+        func poolAcquire() throws {
+            let status = try run("pool")
+            #expect(status.exited)
+            #expect(status.exit.code == 0)
+        }
+    }
+
+#endif
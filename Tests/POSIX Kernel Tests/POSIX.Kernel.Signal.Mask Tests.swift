@@ -0,0 +1,94 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Signal.Mask {
+        #TestSuites
+    }
+
+    // MARK: - Unit Tests
+    //
+    // Masks are per-thread and each test body is synchronous, so these
+    // observe only their own thread's mask.
+
+    extension Kernel.Signal.Mask.Test.Unit {
+        /// The calling thread's current mask.
+        private func current() throws -> Kernel.Signal.Set {
+            try Kernel.Signal.Mask.change(.block, signals: Kernel.Signal.Set())
+        }
+
+        @Test("withBlocked blocks inside and restores on exit")
+        func withBlockedRestores() throws {
+            let before = try current()
+
+            let inside = try Kernel.Signal.Mask.withBlocked(.termination) { () throws(Kernel.Signal.Error) in
+                #expect(Kernel.Signal.Mask.depth == 1)
+                return try current()
+            }
+
+            #expect(Kernel.Signal.Set.termination.isSubset(of: inside))
+            #expect(try current() == before)
+            #expect(Kernel.Signal.Mask.depth == 0)
+        }
+
+        @Test("Nested scopes track depth and restore the outer mask")
+        func nestedScopes() throws {
+            let before = try current()
+
+            try Kernel.Signal.Mask.withBlocked(.termination) { () throws(Kernel.Signal.Error) in
+                let outer = try current()
+
+                // Already covered: no syscall, mask unchanged
+                try Kernel.Signal.Mask.withBlocked(Kernel.Signal.Set(__unchecked: (), .terminate)) {
+                    () throws(Kernel.Signal.Error) in
+                    #expect(Kernel.Signal.Mask.depth == 2)
+                    #expect(try current() == outer)
+                }
+
+                // Not covered: blocks the extra signal, then restores
+                try Kernel.Signal.Mask.withBlocked(.jobControl) { () throws(Kernel.Signal.Error) in
+                    #expect(Kernel.Signal.Set.jobControl.isSubset(of: try current()))
+                }
+                #expect(try current() == outer)
+            }
+
+            #expect(try current() == before)
+        }
+
+        @Test("A throwing body still restores the mask")
+        func throwingBodyRestores() throws {
+            let before = try current()
+
+            #expect(throws: Kernel.Signal.Error.interrupted) {
+                try Kernel.Signal.Mask.withBlocked { () throws(Kernel.Signal.Error) in
+                    throw .interrupted
+                }
+            }
+
+            #expect(try current() == before)
+            #expect(Kernel.Signal.Mask.depth == 0)
+        }
+    }
+
+#endif
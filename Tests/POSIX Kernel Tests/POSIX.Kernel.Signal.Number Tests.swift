@@ -0,0 +1,103 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Signal.Number {
+        #TestSuites
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Signal.Number.Test.Unit {
+        @Test("info reports name, disposition and catchability")
+        func infoForStandardSignals() throws {
+            let terminate = try #require(Kernel.Signal.Number.terminate.info)
+            #expect("\(terminate.name)" == "SIGTERM")
+            #expect(terminate.disposition == .terminate)
+            #expect(terminate.isCatchable)
+            #expect(!terminate.isRealtime)
+
+            #expect(Kernel.Signal.Number.kill.info?.isCatchable == false)
+            #expect(Kernel.Signal.Number.stop.info?.disposition == .stop)
+            #expect(Kernel.Signal.Number.child.info?.disposition == .ignore)
+            #expect(Kernel.Signal.Number.segmentation.info?.disposition == .core)
+            #expect(Kernel.Signal.Number(rawValue: 0).info == nil)
+        }
+
+        @Test("Every standard name round-trips through the perfect hash")
+        func nameRoundTrips() {
+            for number in Kernel.Signal.Number.all where number.info?.isRealtime == false {
+                #expect(Kernel.Signal.Number(name: number.description) == number)
+                #expect(Kernel.Signal.Number(name: String(number.description.dropFirst(3))) == number)
+            }
+        }
+
+        @Test("Unknown and near-miss names do not resolve")
+        func unknownNames() {
+            #expect(Kernel.Signal.Number(name: "") == nil)
+            #expect(Kernel.Signal.Number(name: "SIG") == nil)
+            #expect(Kernel.Signal.Number(name: "SIGTER") == nil)
+            #expect(Kernel.Signal.Number(name: "sigterm") == nil)
+            #expect(Kernel.Signal.Number(name: "SIGTERMX") == nil)
+        }
+
+        @Test("description uses the table")
+        func descriptionFromTable() {
+            #expect(Kernel.Signal.Number.terminate.description == "SIGTERM")
+            #expect(Kernel.Signal.Number(rawValue: 0).description == "signal(0)")
+        }
+    }
+
+    #if os(Linux)
+
+        extension Kernel.Signal.Number.Test.Unit {
+            @Test("Real-time signals span SIGRTMIN...SIGRTMAX")
+            func realtimeRange() throws {
+                let realtime = Kernel.Signal.Number.realtime
+                let first = try #require(realtime.first)
+                #expect(realtime.count >= 8)
+                #expect(Kernel.Signal.Number.realtime(0) == first)
+                #expect(Kernel.Signal.Number.realtime(Int32(realtime.count)) == nil)
+
+                let info = try #require(Kernel.Signal.Number.realtime(2)?.info)
+                #expect(info.isRealtime)
+                #expect(info.offset == 2)
+                #expect(info.disposition == .terminate)
+            }
+
+            @Test("Real-time names parse and print")
+            func realtimeNames() throws {
+                let third = try #require(Kernel.Signal.Number.realtime(3))
+                #expect(third.description == "SIGRTMIN+3")
+                #expect(Kernel.Signal.Number(name: "SIGRTMIN+3") == third)
+                #expect(Kernel.Signal.Number(name: "RTMIN") == Kernel.Signal.Number.realtime.first)
+                #expect(Kernel.Signal.Number(name: "SIGRTMAX") == Kernel.Signal.Number.realtime.last)
+                #expect(Kernel.Signal.Number(name: "SIGRTMAX-999") == nil)
+                #expect(Kernel.Signal.Number(name: "SIGRTMIN-1") == nil)
+            }
+        }
+
+    #endif
+
+#endif
@@ -0,0 +1,88 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Signal.Send {
+        #TestSuites
+    }
+
+    extension Kernel.Signal.Send.Test {
+        @Suite struct Integration {}
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Signal.Send.Test.Unit {
+        @Test("toAll over no targets is complete and allocates no bitmap")
+        func toAllEmpty() {
+            let delivery = Kernel.Signal.Send.toAll(.continue, pids: [Kernel.Process.ID]())
+            #expect(delivery.count == 0)
+            #expect(delivery.isComplete)
+            #expect(delivery.words.isEmpty)
+            #expect(delivery.error == nil)
+        }
+
+        @Test("toAll marks missing targets and keeps the first error")
+        func toAllMarksFailures() {
+            // Signal 0 probes without delivering; PID_MAX_LIMIT is 4194304
+            let missing = Kernel.Process.ID(rawValue: 4_194_304 + 1)
+            let targets = [Kernel.Process.ID(rawValue: getpid()), missing, Kernel.Process.ID(rawValue: getpid())]
+
+            let delivery = Kernel.Signal.Send.toAll(.init(rawValue: 0), pids: targets)
+            #expect(delivery.count == 3)
+            #expect(delivery.failures == 1)
+            #expect(delivery[0])
+            #expect(!delivery[1])
+            #expect(delivery[2])
+            #expect(delivery.failed == [1])
+            #expect(delivery.error == .posix(ESRCH))
+        }
+    }
+
+    // MARK: - Integration Tests
+
+    extension Kernel.Signal.Send.Test.Integration {
+        @Test("toAll signals every handle")
+        func toAllSignalsHandles() throws {
+            let children = try (0..<3).map { _ in try POSIXTestHelper.spawn("stop-exit", "9") }
+            var handles: [Kernel.Process.Handle] = []
+            defer { for handle in handles { try? Kernel.Process.Handle.close(handle) } }
+
+            for child in children {
+                handles.append(try Kernel.Process.Handle.open(child))
+                _ = try Kernel.Process.Wait.wait(.process(child), options: [.untraced])
+            }
+
+            let delivery = Kernel.Signal.Send.toAll(.continue, handles)
+            #expect(delivery.isComplete)
+            #expect(delivery.failed.isEmpty)
+
+            for handle in handles {
+                let result = try Kernel.Process.Wait.wait(handle)
+                #expect(result?.status.exit.code == 9)
+            }
+        }
+    }
+
+#endif
@@ -0,0 +1,82 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Signal.Set {
+        #TestSuites
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Signal.Set.Test.Unit {
+        @Test("Word-built sets agree with sigismember")
+        func wordsMatchLibc() throws {
+            let set = Kernel.Signal.Set(__unchecked: (), [.user1, .terminate, .child])
+            #expect(try set.contains(.user1))
+            #expect(try set.contains(.terminate))
+            #expect(try set.contains(.child))
+            #expect(try !set.contains(.user2))
+
+            let libc = try Kernel.Signal.Set([.user1, .terminate, .child])
+            #expect(set == libc)
+            #expect(set.hashValue == libc.hashValue)
+        }
+
+        @Test("union, intersection and subtracting work on words")
+        func algebra() {
+            let left = Kernel.Signal.Set(__unchecked: (), [.user1, .user2])
+            let right = Kernel.Signal.Set(__unchecked: (), [.user2, .terminate])
+
+            #expect(left.union(right) == Kernel.Signal.Set(__unchecked: (), [.user1, .user2, .terminate]))
+            #expect(left.intersection(right) == Kernel.Signal.Set(__unchecked: (), .user2))
+            #expect(left.subtracting(right) == Kernel.Signal.Set(__unchecked: (), .user1))
+            #expect(left.subtracting(left).isEmpty)
+        }
+
+        @Test("members iterates ascending and stops at the highest signal")
+        func membersAscending() {
+            let set = Kernel.Signal.Set(__unchecked: (), [.terminate, .hangup, .user1])
+            let expected: [Kernel.Signal.Number] = [.hangup, .user1, .terminate]
+            #expect(Array(set.members) == expected.sorted { $0.rawValue < $1.rawValue })
+            #expect(set.count == 3)
+            #expect(Kernel.Signal.Set().isEmpty)
+
+            let all = Kernel.Signal.Set.all.members.map(\.rawValue)
+            #expect(all.allSatisfy { $0 >= 1 && $0 <= Kernel.Signal.Set.highest })
+        }
+
+        @Test("Canonical sets")
+        func canonicalSets() throws {
+            let blockable = Kernel.Signal.Set.blockable
+            #expect(!blockable.contains(__unchecked: (), .kill))
+            #expect(!blockable.contains(__unchecked: (), .stop))
+            #expect(blockable.contains(__unchecked: (), .terminate))
+
+            #expect(Kernel.Signal.Set.jobControl.count == 4)
+            #expect(Kernel.Signal.Set.termination.contains(__unchecked: (), .interrupt))
+            #expect(Kernel.Signal.Set.termination.intersection(.jobControl).isEmpty)
+        }
+    }
+
+#endif
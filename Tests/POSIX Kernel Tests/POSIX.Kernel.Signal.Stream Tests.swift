@@ -0,0 +1,122 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Signal.Stream {
+        #TestSuites
+    }
+
+    extension Kernel.Signal.Stream.Test {
+        @Suite(.serialized) struct Integration {}
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Signal.Stream.Test.Unit {
+        @Test("Record defaults to one unattributed delivery")
+        func recordDefaults() {
+            let record = Kernel.Signal.Stream.Record(signal: .child)
+            #expect(record.count == 1)
+            #expect(record.sender == nil)
+        }
+    }
+
+    // MARK: - Integration Tests
+    //
+    // SIGUSR2 is set to SIG_IGN for the duration of each test, so a record
+    // left pending can never terminate the test process once unblocked.
+
+    extension Kernel.Signal.Stream.Test.Integration {
+        @Test("read(into:) returns a raised signal")
+        func readReturnsRaisedSignal() throws {
+            let previous = try Kernel.Signal.Action.set(signal: .user2, .init(handler: .ignore))
+            defer { _ = try? Kernel.Signal.Action.set(signal: .user2, previous) }
+
+            let signals = Kernel.Signal.Set(__unchecked: (), .user2)
+            let stream = try Kernel.Signal.Stream(signals)
+            defer {
+                stream.close()
+                _ = try? Kernel.Signal.Mask.change(.unblock, signals: signals)
+            }
+
+            try Kernel.Signal.Send.toSelf(.user2)
+
+            let buffer = UnsafeMutableBufferPointer<Kernel.Signal.Stream.Record>.allocate(capacity: 8)
+            defer { buffer.deallocate() }
+
+            var received = false
+            for _ in 0..<100 where !received {
+                let count = try stream.read(into: buffer)
+                received = buffer[..<count].contains { $0.signal == .user2 }
+                if !received { usleep(1_000) }
+            }
+            #expect(received)
+        }
+
+        @Test("read(into:) returns zero when nothing is pending")
+        func readEmptyReturnsZero() throws {
+            let signals = Kernel.Signal.Set(__unchecked: (), .user2)
+            let stream = try Kernel.Signal.Stream(signals)
+            defer {
+                stream.close()
+                _ = try? Kernel.Signal.Mask.change(.unblock, signals: signals)
+            }
+
+            let buffer = UnsafeMutableBufferPointer<Kernel.Signal.Stream.Record>.allocate(capacity: 4)
+            defer { buffer.deallocate() }
+
+            #expect(try stream.read(into: buffer) == 0)
+        }
+
+        @Test("read(into:) returns zero for an empty buffer with a base address")
+        func readEmptyBuffer() throws {
+            let signals = Kernel.Signal.Set(__unchecked: (), .user2)
+            let stream = try Kernel.Signal.Stream(signals)
+            defer {
+                stream.close()
+                _ = try? Kernel.Signal.Mask.change(.unblock, signals: signals)
+            }
+
+            let storage = UnsafeMutableBufferPointer<Kernel.Signal.Stream.Record>.allocate(capacity: 1)
+            defer { storage.deallocate() }
+            let empty = UnsafeMutableBufferPointer(rebasing: storage[0..<0])
+
+            #expect(empty.baseAddress != nil)
+            #expect(try stream.read(into: empty) == 0)
+        }
+
+        @Test("records() finishes after close")
+        func recordsFinishAfterClose() async throws {
+            let signals = Kernel.Signal.Set(__unchecked: (), .user2)
+            let stream = try Kernel.Signal.Stream(signals)
+            let records = try stream.records()
+
+            stream.close()
+
+            var iterator = records.makeAsyncIterator()
+            #expect(await iterator.next() == nil)
+        }
+    }
+
+#endif
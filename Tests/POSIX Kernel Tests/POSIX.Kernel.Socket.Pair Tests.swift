@@ -0,0 +1,164 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Socket.Pair {
+        #TestSuites
+    }
+
+    extension Kernel.Socket.Pair.Test {
+        @Suite struct Integration {}
+    }
+
+    /// Closes a raw descriptor.
+    private func release(_ descriptor: Int32) {
+        #if canImport(Darwin)
+            _ = Darwin.close(descriptor)
+        #else
+            _ = Glibc.close(descriptor)
+        #endif
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Socket.Pair.Test.Unit {
+        @Test("kinds map to SOCK_* values")
+        func kinds() {
+            #expect(Kernel.Socket.Pair.Kind.stream != .sequenced)
+            #expect(Kernel.Socket.Pair.Kind.sequenced != .datagram)
+        }
+
+        @Test("error description includes errno")
+        func errorDescription() {
+            let error = Kernel.Socket.Pair.Error.platform(.posix(EMFILE))
+            #expect(error.description.contains("\(EMFILE)"))
+        }
+    }
+
+    // MARK: - Integration Tests
+
+    extension Kernel.Socket.Pair.Test.Integration {
+        @Test("create applies cloexec and nonblocking to both ends")
+        func createOptions() throws {
+            let (first, second) = try Kernel.Socket.Pair.create(.sequenced, options: [.cloexec, .nonblocking])
+            defer {
+                release(first.rawValue)
+                release(second.rawValue)
+            }
+
+            for descriptor in [first.rawValue, second.rawValue] {
+                #expect(fcntl(descriptor, F_GETFD) & FD_CLOEXEC != 0)
+                #expect(fcntl(descriptor, F_GETFL) & O_NONBLOCK != 0)
+            }
+        }
+
+        @Test("create without options leaves descriptors inheritable and blocking")
+        func createDefaults() throws {
+            let (first, second) = try Kernel.Socket.Pair.create()
+            defer {
+                release(first.rawValue)
+                release(second.rawValue)
+            }
+
+            #expect(fcntl(first.rawValue, F_GETFD) & FD_CLOEXEC == 0)
+            #expect(fcntl(first.rawValue, F_GETFL) & O_NONBLOCK == 0)
+        }
+
+        @Test("Rights passes a batch of descriptors in one message")
+        func rightsBatch() throws {
+            let (sender, receiver) = try Kernel.Socket.Pair.create(.sequenced, options: .cloexec)
+            defer {
+                release(sender.rawValue)
+                release(receiver.rawValue)
+            }
+
+            let files = (0..<4).map { _ in Kernel.Descriptor(rawValue: open("/dev/null", O_RDONLY)) }
+            defer { files.forEach { release($0.rawValue) } }
+
+            var tag: UInt8 = 7
+            let sent = try withUnsafeBytes(of: &tag) { bytes in
+                try Kernel.Socket.Pair.Rights.send(sender, files, bytes: bytes)
+            }
+            #expect(sent == 1)
+
+            let descriptors = UnsafeMutableBufferPointer<Kernel.Descriptor>.allocate(capacity: 8)
+            defer { descriptors.deallocate() }
+            var payload: UInt8 = 0
+            let received = try withUnsafeMutableBytes(of: &payload) { bytes in
+                try Kernel.Socket.Pair.Rights.receive(receiver, into: descriptors, bytes: bytes)
+            }
+            defer { descriptors.prefix(received.descriptors).forEach { release($0.rawValue) } }
+
+            #expect(received == .init(bytes: 1, descriptors: 4))
+            #expect(payload == 7)
+            for descriptor in descriptors.prefix(received.descriptors) {
+                #expect(fcntl(descriptor.rawValue, F_GETFD) & FD_CLOEXEC != 0)
+            }
+        }
+
+        @Test("Rights fails with EMSGSIZE when descriptors exceed the buffer")
+        func rightsTruncated() throws {
+            let (sender, receiver) = try Kernel.Socket.Pair.create(.sequenced)
+            defer {
+                release(sender.rawValue)
+                release(receiver.rawValue)
+            }
+
+            let files = (0..<3).map { _ in Kernel.Descriptor(rawValue: open("/dev/null", O_RDONLY)) }
+            defer { files.forEach { release($0.rawValue) } }
+
+            var tag: UInt8 = 0
+            _ = try withUnsafeBytes(of: &tag) { bytes in
+                try Kernel.Socket.Pair.Rights.send(sender, files, bytes: bytes)
+            }
+
+            let descriptors = UnsafeMutableBufferPointer<Kernel.Descriptor>.allocate(capacity: 1)
+            defer { descriptors.deallocate() }
+
+            #expect(throws: Kernel.Socket.Pair.Error.platform(.posix(EMSGSIZE))) {
+                _ = try withUnsafeMutableBytes(of: &tag) { bytes in
+                    try Kernel.Socket.Pair.Rights.receive(receiver, into: descriptors, bytes: bytes)
+                }
+            }
+        }
+
+        @Test("Rights rejects more than maximum descriptors")
+        func rightsLimit() throws {
+            let (sender, receiver) = try Kernel.Socket.Pair.create(.sequenced)
+            defer {
+                release(sender.rawValue)
+                release(receiver.rawValue)
+            }
+
+            let files = [Kernel.Descriptor](repeating: Kernel.Descriptor(rawValue: 0), count: Kernel.Socket.Pair.Rights.maximum + 1)
+            var tag: UInt8 = 0
+            #expect(throws: Kernel.Socket.Pair.Error.platform(.posix(EINVAL))) {
+                _ = try withUnsafeBytes(of: &tag) { bytes in
+                    try Kernel.Socket.Pair.Rights.send(sender, files, bytes: bytes)
+                }
+            }
+        }
+    }
+
+#endif
@@ -0,0 +1,123 @@
+// ===----------------------------------------------------------------------===//
+//
+// This source file is part of the swift-posix open source project
+//
+// Copyright (c) 2024-2025 Coen ten Thije Boonkkamp and the swift-posix project authors
+// Licensed under Apache License v2.0
+//
+// See LICENSE for license information
+//
+// ===----------------------------------------------------------------------===//
+
+#if os(macOS) || os(Linux)
+
+    #if canImport(Darwin)
+        import Darwin
+    #elseif canImport(Glibc)
+        import Glibc
+    #endif
+
+    import StandardsTestSupport
+    import Testing
+
+    import Kernel_Primitives
+    @testable import POSIX_Kernel
+
+    extension Kernel.Trace {
+        #TestSuites
+    }
+
+    extension Kernel.Trace.Test {
+        // Drains are global, so tests that drain must not interleave
+        @Suite(.serialized) struct Integration {}
+    }
+
+    // MARK: - Unit Tests
+
+    extension Kernel.Trace.Test.Unit {
+        @Test("Event duration is end minus start")
+        func eventDuration() {
+            let event = Kernel.Trace.Event(point: .open, start: 100, end: 350, pid: 0, detail: 0)
+            #expect(event.duration == 250)
+        }
+
+        @Test("capacity is a power of two")
+        func capacityPowerOfTwo() {
+            #expect(Kernel.Trace.capacity > 0)
+            #expect(Kernel.Trace.capacity & (Kernel.Trace.capacity - 1) == 0)
+        }
+
+        #if !POSIX_KERNEL_TRACING
+            @Test("Without the Tracing trait nothing is recorded")
+            func disabled() throws {
+                #expect(Kernel.Trace.isEnabled == false)
+
+                let child = try POSIXTestHelper.spawn("exit", "0")
+                _ = try Kernel.Process.Wait.wait(.process(child))
+
+                let buffer = UnsafeMutableBufferPointer<Kernel.Trace.Event>.allocate(capacity: 8)
+                defer { buffer.deallocate() }
+                #expect(Kernel.Trace.drain(into: buffer) == 0)
+                #expect(Kernel.Trace.dropped == 0)
+            }
+        #endif
+    }
+
+    // MARK: - Integration Tests
+
+    #if POSIX_KERNEL_TRACING
+
+        extension Kernel.Trace.Test.Integration {
+            /// Every event recorded so far, by any thread.
+            private func drainAll() -> [Kernel.Trace.Event] {
+                let buffer = UnsafeMutableBufferPointer<Kernel.Trace.Event>.allocate(capacity: 256)
+                defer { buffer.deallocate() }
+
+                var events: [Kernel.Trace.Event] = []
+                var count: Int
+                repeat {
+                    count = Kernel.Trace.drain(into: buffer)
+                    events.append(contentsOf: buffer[..<count])
+                } while count == buffer.count
+                return events
+            }
+
+            @Test("spawn and reap are recorded for the child, in order")
+            func spawnAndReap() throws {
+                #expect(Kernel.Trace.isEnabled)
+
+                let child = try POSIXTestHelper.spawn("exit", "7")
+                _ = try Kernel.Process.Wait.wait(.process(child))
+
+                let events = drainAll().filter { $0.pid == child.rawValue }
+                let spawn = events.first { $0.point == .spawn }
+                let reap = events.first { $0.point == .reap }
+
+                #expect(spawn != nil)
+                #expect(reap != nil)
+                if let spawn, let reap {
+                    #expect(spawn.start <= spawn.end)
+                    #expect(spawn.end <= reap.start)
+                    #expect(Kernel.Process.Status(rawValue: reap.detail).exit.code == 7)
+                }
+            }
+
+            @Test("dlopen and dlsym durations are recorded")
+            func libraryDurations() throws {
+                _ = drainAll()
+
+                let handle = try Kernel.Library.Dynamic.open(path: nil)
+                defer { try? Kernel.Library.Dynamic.close(handle) }
+                _ = try "getpid".withCString { name in
+                    try Kernel.Library.Dynamic.symbol(name: name, in: .handle(handle))
+                }
+
+                let points = drainAll().map(\.point)
+                #expect(points.contains(.open))
+                #expect(points.contains(.symbol))
+            }
+        }
+
+    #endif
+
+#endif
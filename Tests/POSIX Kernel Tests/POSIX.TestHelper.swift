@@ -37,17 +37,23 @@
     // MARK: - POSIXTestHelper
 
     enum POSIXTestHelper {
-        /// Path to the posix-test-helper executable.
+        /// Path to the posix-test-helper executable, or another helper product.
         ///
         /// Resolution order:
-        /// 1. `POSIX_TEST_HELPER` environment variable (CI-friendly)
+        /// 1. `variable` environment variable (CI-friendly)
         /// 2. `.build/debug/` relative to package root via #filePath (SwiftPM)
         /// 3. Xcode DerivedData via environment variables
-        static func executablePath(filePath: StaticString = #filePath) -> String {
-            let helperName = "posix-test-helper"
-
+        ///
+        /// - Parameters:
+        ///   - helperName: The executable product name.
+        ///   - variable: The environment variable that overrides the path.
+        static func executablePath(
+            named helperName: String = "posix-test-helper",
+            variable: String = "POSIX_TEST_HELPER",
+            filePath: StaticString = #filePath
+        ) -> String {
             // 1. Prefer explicit env var (CI-friendly)
-            if let envPath = getenv("POSIX_TEST_HELPER") {
+            if let envPath = getenv(variable) {
                 return String(cString: envPath)
             }
 
@@ -136,6 +142,22 @@
         /// - Returns: The process ID of the spawned helper.
         /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
         static func spawn(_ args: [String]) throws -> Kernel.Process.ID {
+            try spawn(args, fileActions: nil, attributes: nil)
+        }
+
+        /// Spawns the test helper with file actions and attributes.
+        ///
+        /// - Parameters:
+        ///   - args: Command and arguments.
+        ///   - fileActions: Descriptor actions for the child, or `nil`.
+        ///   - attributes: Spawn attributes for the child, or `nil`.
+        /// - Returns: The process ID of the spawned helper.
+        /// - Throws: `POSIX.Kernel.Process.Error.spawn` on failure.
+        static func spawn(
+            _ args: [String],
+            fileActions: POSIX.Kernel.Process.Spawn.FileActions?,
+            attributes: POSIX.Kernel.Process.Spawn.Attributes?
+        ) throws -> Kernel.Process.ID {
             let path = executablePath()
             let allArgs = [path] + args
             let envp: [String] = []
@@ -145,7 +167,9 @@
                     try POSIX.Kernel.Process.Spawn.spawn(
                         path: pathPtr.unsafeCString,
                         argv: argvPtr,
-                        envp: envpPtr
+                        envp: envpPtr,
+                        fileActions: fileActions,
+                        attributes: attributes
                     )
                 }
             }